@@ -0,0 +1,62 @@
+// main161.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: parallelism; multithreading; basic usage; charged multiplicity;
+
+// Simple example of multithreaded generation with the PythiaParallel
+// class: the charged multiplicity of minimum-bias events at the LHC is
+// histogrammed, and the wall-clock time of the run is measured.
+// The number of threads can be given as command-line argument.
+
+#include "Pythia8/PythiaParallel.h"
+#include <chrono>
+using namespace Pythia8;
+
+int main(int argc, char* argv[]) {
+
+  // Number of events and threads.
+  int nEvent   = 10000;
+  int nThreads = (argc > 1) ? atoi(argv[1]) : 0;
+
+  // Generator. Process selection. LHC initialization. Threads.
+  PythiaParallel pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Parallelism:numThreads = " + to_string(nThreads));
+
+  // Initialize all instances, and time the initialization.
+  auto timeInit = std::chrono::steady_clock::now();
+  if (!pythia.init()) return 1;
+  auto timeRun  = std::chrono::steady_clock::now();
+
+  // Histogram is filled in the callback. Since Parallelism:processAsync
+  // is off by default, only one thread at a time calls it.
+  Hist mult("charged multiplicity", 100, -0.5, 799.5);
+  long nDone = pythia.run( nEvent, [&](Pythia& pythiaNow) {
+    int nCharged = 0;
+    for (int i = 0; i < pythiaNow.event.size(); ++i)
+      if (pythiaNow.event[i].isFinal() && pythiaNow.event[i].isCharged())
+        ++nCharged;
+    mult.fill( nCharged );
+  });
+  auto timeEnd  = std::chrono::steady_clock::now();
+
+  // Statistics. Histogram. Timing.
+  pythia.stat();
+  cout << mult;
+  double secInit = std::chrono::duration<double>(timeRun - timeInit).count();
+  double secRun  = std::chrono::duration<double>(timeEnd - timeRun).count();
+  cout << fixed << setprecision(3) << "\n Generated " << nDone
+       << " events with " << pythia.nInstances() << " threads.\n"
+       << " Initialization took " << secInit << " s, generation "
+       << secRun << " s, i.e. " << nDone / max(1e-9, secRun)
+       << " events per second.\n Combined sigmaGen = " << scientific
+       << pythia.sigmaGen() << " +- " << pythia.sigmaErr() << " mb."
+       << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,93 @@
+// main162.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: particle data; timing; benchmark;
+
+// Benchmark of particle data lookups. First the time per lookup is
+// measured, for the particle identities found in generated events, and
+// for some exotic ones, e.g. SUSY and Hidden Valley states. Then the event
+// throughput of complete generation is measured for a few processes.
+// Compare the numbers between versions of the program, on the same machine.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of events for throughput, and of lookup rounds.
+  int nEvent = 2000;
+  int nRound = 200;
+
+  // Processes to be timed.
+  vector<string> procs = { "HardQCD:all = on",
+    "WeakSingleBoson:ffbar2gmZ = on", "Top:gg2ttbar = on" };
+
+  // Collect particle identities from minimum-bias events.
+  Pythia pythia;
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Next:numberCount = 0");
+  pythia.readString("Print:quiet = on");
+  if (!pythia.init()) return 1;
+  vector<int> idList;
+  for (int iEvent = 0; iEvent < 20; ++iEvent) {
+    if (!pythia.next()) continue;
+    for (int i = 1; i < pythia.event.size(); ++i)
+      idList.push_back( pythia.event[i].id() );
+  }
+
+  // Exotic identities, stored beyond the common range.
+  vector<int> idExotic = { 1000021, -1000006, 1000022, 2000011, 4900101,
+    -4900002, 9900042, 1000002, 3100021, 5100021 };
+
+  // Time lookups of mass, charge and colour for the common identities.
+  ParticleData& pd = pythia.particleData;
+  double sum = 0.;
+  clock_t timeBeg = clock();
+  for (int iRound = 0; iRound < nRound; ++iRound)
+  for (int i = 0; i < int(idList.size()); ++i)
+    sum += pd.m0(idList[i]) + pd.charge(idList[i]) + pd.colType(idList[i]);
+  double timeCommon = double(clock() - timeBeg) / CLOCKS_PER_SEC
+    / (3. * nRound * idList.size());
+
+  // Time the same for the exotic identities.
+  int nExotic = nRound * idList.size() / idExotic.size();
+  timeBeg = clock();
+  for (int iRound = 0; iRound < nExotic; ++iRound)
+  for (int i = 0; i < int(idExotic.size()); ++i)
+    sum += pd.m0(idExotic[i]) + pd.charge(idExotic[i])
+         + pd.colType(idExotic[i]);
+  double timeExotic = double(clock() - timeBeg) / CLOCKS_PER_SEC
+    / (3. * nExotic * idExotic.size());
+
+  // Time event generation for each process.
+  vector<double> rates;
+  for (int iProc = 0; iProc < int(procs.size()); ++iProc) {
+    Pythia pythiaNow("../share/Pythia8/xmldoc", false);
+    pythiaNow.readString("Beams:eCM = 13000.");
+    pythiaNow.readString(procs[iProc]);
+    pythiaNow.readString("PhaseSpace:pTHatMin = 20.");
+    pythiaNow.readString("Next:numberCount = 0");
+    pythiaNow.readString("Print:quiet = on");
+    if (!pythiaNow.init()) return 1;
+    timeBeg = clock();
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) pythiaNow.next();
+    rates.push_back( CLOCKS_PER_SEC * nEvent / double(clock() - timeBeg) );
+  }
+
+  // Print results.
+  cout << "\n Particle data lookups: " << fixed << setprecision(1)
+       << 1e9 * timeCommon << " ns for identities in events, "
+       << 1e9 * timeExotic << " ns for exotic ones.\n"
+       << " (Checksum " << scientific << setprecision(6) << sum << ")\n\n";
+  for (int iProc = 0; iProc < int(procs.size()); ++iProc)
+    cout << " " << left << setw(32) << procs[iProc] << right << fixed
+         << setprecision(1) << setw(10) << rates[iProc]
+         << " events per second" << endl;
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,96 @@
+// main163.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: analysis; sphericity; jet finding; timing;
+
+// Example of how the EventColumns class can be used for analysis. Each
+// event is copied into columns, and then sphericity and jets are found
+// both from the normal event record and from the columns. The results
+// should agree exactly, and the time spent in each is compared.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of events, and number of times each event is analyzed.
+  int nEvent = 200;
+  int nRepeat = 20;
+
+  // Generator. Minimum-bias events at the LHC.
+  Pythia pythia;
+  pythia.readString("Beams:eCM = 13000.");
+  pythia.readString("SoftQCD:nonDiffractive = on");
+  pythia.readString("Next:numberCount = 0");
+  if (!pythia.init()) return 1;
+
+  // Analysis objects: charged sphericity and anti-kT jets of all visible
+  // particles, without and with the columns. The columns are reused.
+  Sphericity sphEvent(2., 3), sphColumns(2., 3);
+  SlowJet jetEvent(-1, 0.4, 5., 4.5, 2, 1);
+  SlowJet jetColumns(-1, 0.4, 5., 4.5, 2, 1);
+  EventColumns columns;
+
+  // Begin event loop.
+  double timeFill = 0., timeSphEvent = 0., timeSphColumns = 0.,
+    timeJetEvent = 0., timeJetColumns = 0.;
+  int nDiffer = 0;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    if (!pythia.next()) continue;
+
+    // Fill the columns.
+    clock_t timeBeg = clock();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat)
+      pythia.event.toColumns( columns);
+    timeFill += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+    // Sphericity from the event record and from the columns.
+    timeBeg = clock();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat)
+      sphEvent.analyze( pythia.event);
+    timeSphEvent += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+    timeBeg = clock();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat)
+      sphColumns.analyze( columns);
+    timeSphColumns += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+    // Jets from the event record and from the columns.
+    timeBeg = clock();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat)
+      jetEvent.analyze( pythia.event);
+    timeJetEvent += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+    timeBeg = clock();
+    for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat)
+      jetColumns.analyze( columns);
+    timeJetColumns += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+    // Compare results.
+    if (sphEvent.sphericity() != sphColumns.sphericity()
+      || jetEvent.sizeJet() != jetColumns.sizeJet()) ++nDiffer;
+    else for (int i = 0; i < jetEvent.sizeJet(); ++i)
+      if (jetEvent.pT(i) != jetColumns.pT(i)) {
+        ++nDiffer;
+        break;
+      }
+
+  // End of event loop. Statistics.
+  }
+  pythia.stat();
+
+  // Print results, with times in microseconds per event.
+  double norm = 1e6 / (nEvent * nRepeat);
+  cout << "\n Events with different results: " << nDiffer << "\n"
+       << fixed << setprecision(2) << " Time to fill columns: "
+       << norm * timeFill << " us.\n Sphericity: " << norm * timeSphEvent
+       << " us from Event, " << norm * timeSphColumns
+       << " us from EventColumns.\n Jets:       " << norm * timeJetEvent
+       << " us from Event, " << norm * timeJetColumns
+       << " us from EventColumns." << endl;
+
+  // Done.
+  return 0;
+}
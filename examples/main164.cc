@@ -0,0 +1,113 @@
+// main164.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: Bose-Einstein; timing; benchmark;
+
+// Benchmark of the Bose-Einstein shifts as a function of the number of
+// pions in an event, for the default algorithm, which considers all
+// pairs, and for the faster one with BoseEinstein:useQCut = on, for two
+// values of the cut. High-multiplicity events are mimicked by overlaying
+// the final charged pions of several minimum-bias events, in the spirit
+// of a heavy-ion collision as a superposition of nucleon-nucleon ones.
+// The resulting pions are handed to the hadron level for the shifts.
+// The differences between the shifted momenta of the algorithms are
+// compared with the size of the shifts themselves, both relative to the
+// original momenta.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Numbers of overlaid events, and number of events for each.
+  vector<int> nOverlays = { 1, 2, 4, 8, 16, 32 };
+  int nEvent = 3;
+
+  // Generator of minimum-bias events, without Bose-Einstein shifts.
+  Pythia pythiaMB;
+  pythiaMB.readString("Beams:eCM = 13000.");
+  pythiaMB.readString("SoftQCD:nonDiffractive = on");
+  pythiaMB.readString("Next:numberCount = 0");
+  pythiaMB.readString("Print:quiet = on");
+  if (!pythiaMB.init()) return 1;
+
+  // One generator for each algorithm, only doing the hadron level.
+  vector<string> cuts = { "off", "9.", "3." };
+  vector<Pythia*> pythias;
+  for (int iCut = 0; iCut < 3; ++iCut) {
+    Pythia* pythiaPtr = new Pythia("../share/Pythia8/xmldoc", false);
+    pythiaPtr->readString("ProcessLevel:all = off");
+    pythiaPtr->readString("HadronLevel:BoseEinstein = on");
+    pythiaPtr->readString("Check:event = off");
+    pythiaPtr->readString("Print:quiet = on");
+    if (iCut > 0) {
+      pythiaPtr->readString("BoseEinstein:useQCut = on");
+      pythiaPtr->readString("BoseEinstein:QCutFactor = " + cuts[iCut]);
+    }
+    if (!pythiaPtr->init()) return 1;
+    pythias.push_back(pythiaPtr);
+  }
+
+  // Header of table.
+  cout << "\n                   time per event (ms)   rms relative  "
+       << " rms relative difference\n   nPion     all   cut 9   cut 3"
+       << "       shift            cut 9     cut 3\n";
+
+  // Loop over multiplicities and events.
+  for (int nOverlay : nOverlays) {
+    vector<double> times(3, 0.), diff2(3, 0.);
+    double shift2 = 0.;
+    int nPionSum = 0;
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+
+      // Overlay the charged pions of several minimum-bias events.
+      Event& eventAll = pythias[0]->event;
+      eventAll.reset();
+      for (int iOverlay = 0; iOverlay < nOverlay; ++iOverlay) {
+        if (!pythiaMB.next()) continue;
+        for (int i = 0; i < pythiaMB.event.size(); ++i)
+        if (pythiaMB.event[i].isFinal()
+          && pythiaMB.event[i].idAbs() == 211)
+          eventAll.append( pythiaMB.event[i].id(), 81, 0, 0,
+            pythiaMB.event[i].p(), pythiaMB.event[i].m());
+      }
+      int nPion = eventAll.size() - 1;
+      nPionSum += nPion;
+      for (int iCut = 1; iCut < 3; ++iCut) pythias[iCut]->event = eventAll;
+
+      // Time the hadron level, i.e. the Bose-Einstein shifts.
+      for (int iCut = 0; iCut < 3; ++iCut) {
+        clock_t timeBeg = clock();
+        pythias[iCut]->forceHadronLevel(false);
+        times[iCut] += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+      }
+
+      // Compare shifted copies with original and with each other,
+      // relative to the original absolute momentum.
+      for (int i = nPion + 1; i < eventAll.size(); ++i) {
+        int    iOld  = eventAll[i].mother1();
+        double p2Old = eventAll[iOld].pAbs2();
+        shift2 += (eventAll[i].p() - eventAll[iOld].p()).pAbs2() / p2Old;
+        for (int iCut = 1; iCut < 3; ++iCut) diff2[iCut]
+          += (eventAll[i].p() - pythias[iCut]->event[i].p()).pAbs2() / p2Old;
+      }
+    }
+
+    // Print results for this multiplicity.
+    double norm = 1. / max( 1, nPionSum);
+    cout << fixed << setprecision(1) << setw(8) << nPionSum / nEvent;
+    for (int iCut = 0; iCut < 3; ++iCut)
+      cout << setw(8) << 1e3 * times[iCut] / nEvent;
+    cout << scientific << setprecision(2) << setw(13)
+         << sqrt(shift2 * norm) << setw(17) << sqrt(diff2[1] * norm)
+         << setw(10) << sqrt(diff2[2] * norm) << endl;
+  }
+
+  // Done.
+  for (Pythia* pythiaPtr : pythias) delete pythiaPtr;
+  return 0;
+}
@@ -0,0 +1,164 @@
+// main165.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: fragmentation; validation; timing; benchmark;
+
+// Validation of the tabulated Lund fragmentation function, obtained with
+// StringZ:useLundTable = on, against the normal accept-reject method.
+// For light, strange, diquark, charm and bottom cases z values are
+// generated both ways, and compared with a two-sample Kolmogorov-Smirnov
+// test. Also the average z and the time per z value are shown.
+// Finally complete events are generated both ways and timed.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+// A user hook only used to give a StringZ object access to the settings,
+// particle data and random numbers of a Pythia instance.
+
+class ZSelector : public UserHooks {
+
+public:
+
+  // Initialize the z selection at the initialization of Pythia.
+  bool initAfterBeams() {
+    zSel.initInfoPtr(*infoPtr);
+    zSel.init();
+    return true;
+  }
+
+  // Pick a z value.
+  double zFrag(int idOld, int idNew, double mT2) {
+    return zSel.zFrag( idOld, idNew, mT2);}
+
+private:
+
+  StringZ zSel;
+
+};
+
+//==========================================================================
+
+// Probability that the Kolmogorov-Smirnov statistic exceeds the observed
+// one, from the asymptotic distribution.
+
+double probKS(double dMax, int n1, int n2) {
+  double nEff   = double(n1) * n2 / (n1 + n2);
+  double lambda = (sqrt(nEff) + 0.12 + 0.11 / sqrt(nEff)) * dMax;
+  double sum = 0.;
+  double sign = 1.;
+  for (int j = 1; j <= 100; ++j) {
+    double term = 2. * sign * exp(-2. * pow2(j * lambda));
+    sum += term;
+    if (abs(term) < 1e-10 * abs(sum)) return min(1., max(0., sum));
+    sign = -sign;
+  }
+  return 1.;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of z values for each case, and of events for timing.
+  int nZ     = 1000000;
+  int nEvent = 1000;
+
+  // The cases: old and new flavour, and mT2 of the hadron.
+  vector<string> names = { "u -> u, pi", "u -> u, rho", "s -> u, K",
+    "u -> ud_0, p", "ud_0 -> u, p", "c -> u, D", "b -> u, B", "u -> u, hard" };
+  vector<int>    idOld = { 2, 2, 3, 2, 2101, 4, 5, 2 };
+  vector<int>    idNew = { 1, 1, 2, 2101, 1, 2, 2, 1 };
+  vector<double> mT2   = { 0.1, 0.7, 0.35, 1.0, 1.0, 3.8, 28.2, 60. };
+
+  // Two generators, without and with tables, only used for their setup.
+  vector<Pythia*> pythias;
+  vector< shared_ptr<ZSelector> > zSels;
+  for (int iTab = 0; iTab < 2; ++iTab) {
+    Pythia* pythiaPtr = new Pythia("../share/Pythia8/xmldoc", false);
+    pythiaPtr->readString("ProcessLevel:all = off");
+    pythiaPtr->readString("Print:quiet = on");
+    pythiaPtr->readString("Random:setSeed = on");
+    pythiaPtr->readString("Random:seed = " + to_string(17 + iTab));
+    if (iTab == 1) pythiaPtr->readString("StringZ:useLundTable = on");
+    zSels.push_back( make_shared<ZSelector>() );
+    pythiaPtr->setUserHooksPtr( zSels.back());
+    if (!pythiaPtr->init()) return 1;
+    pythias.push_back(pythiaPtr);
+  }
+
+  // Header of table.
+  cout << "\n case             b*mT2    <z> exact    <z> table   KS dMax"
+       << "   KS prob   ns exact   ns table\n";
+
+  // Generate z values both ways, and time it.
+  for (int iCase = 0; iCase < int(names.size()); ++iCase) {
+    vector< vector<double> > zVal(2, vector<double>(nZ));
+    double zSum[2] = {0., 0.}, time[2] = {0., 0.};
+    for (int iTab = 0; iTab < 2; ++iTab) {
+      zSels[iTab]->zFrag( idOld[iCase], idNew[iCase], mT2[iCase]);
+      clock_t timeBeg = clock();
+      for (int i = 0; i < nZ; ++i) zVal[iTab][i]
+        = zSels[iTab]->zFrag( idOld[iCase], idNew[iCase], mT2[iCase]);
+      time[iTab] = double(clock() - timeBeg) / CLOCKS_PER_SEC;
+      for (int i = 0; i < nZ; ++i) zSum[iTab] += zVal[iTab][i];
+      sort( zVal[iTab].begin(), zVal[iTab].end());
+    }
+
+    // Two-sample Kolmogorov-Smirnov statistic from the sorted values.
+    double dMax = 0.;
+    int i0 = 0;
+    int i1 = 0;
+    while (i0 < nZ && i1 < nZ) {
+      double zNow = min( zVal[0][i0], zVal[1][i1]);
+      while (i0 < nZ && zVal[0][i0] <= zNow) ++i0;
+      while (i1 < nZ && zVal[1][i1] <= zNow) ++i1;
+      dMax = max( dMax, abs(double(i0 - i1)) / nZ);
+    }
+
+    // Print results for this case.
+    cout << " " << left << setw(14) << names[iCase] << right << fixed
+         << setprecision(3) << setw(8) << pythias[0]->parm("StringZ:bLund")
+      * mT2[iCase] << setprecision(5) << setw(13) << zSum[0] / nZ
+         << setw(13) << zSum[1] / nZ << setw(10) << dMax << setprecision(3)
+         << setw(10) << probKS( dMax, nZ, nZ) << setprecision(1)
+         << setw(11) << 1e9 * time[0] / nZ << setw(11) << 1e9 * time[1] / nZ
+         << endl;
+  }
+
+  // Time complete minimum-bias events without and with tables.
+  cout << endl;
+  for (int iTab = 0; iTab < 2; ++iTab) {
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    pythia.readString("Beams:eCM = 13000.");
+    pythia.readString("SoftQCD:nonDiffractive = on");
+    pythia.readString("Next:numberCount = 0");
+    pythia.readString("Print:quiet = on");
+    if (iTab == 1) pythia.readString("StringZ:useLundTable = on");
+    if (!pythia.init()) return 1;
+    // Some events first, where the tables are built when first needed.
+    for (int iEvent = 0; iEvent < 50; ++iEvent) pythia.next();
+    double nCharged = 0.;
+    clock_t timeBeg  = clock();
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+      if (!pythia.next()) continue;
+      for (int i = 0; i < pythia.event.size(); ++i)
+        if (pythia.event[i].isFinal() && pythia.event[i].isCharged())
+          ++nCharged;
+    }
+    cout << " Minimum-bias events " << (iTab == 0 ? "without" : "with   ")
+         << " tables: " << fixed << setprecision(2)
+         << 1e3 * double(clock() - timeBeg) / CLOCKS_PER_SEC / nEvent
+         << " ms per event, "
+         << setprecision(1) << nCharged / nEvent << " charged particles"
+         << endl;
+  }
+
+  // Done.
+  for (Pythia* pythiaPtr : pythias) delete pythiaPtr;
+  return 0;
+}
@@ -0,0 +1,131 @@
+// main166.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: fragmentation; timing; benchmark;
+
+// Micro-benchmark of string fragmentation. A fixed set of partonic
+// configurations is fragmented many times, with decays switched off,
+// and the time per string and the number of primary hadrons are shown,
+// for default settings and with the close-packing option, where nearby
+// string pieces are searched for each new hadron. Compare the numbers
+// between versions of the program, on the same machine, to spot changes
+// in the speed of the fragmentation code.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+// Fill one of the fixed partonic configurations into the event record.
+
+void fillPartons(int type, Event& event, ParticleData& pdt) {
+
+  // Reset event record to allow for new event.
+  event.reset();
+
+  // A u ubar system, at low or high energy.
+  if (type == 0 || type == 1) {
+    double ee = (type == 0) ? 10. : 500.;
+    double mm = pdt.m0(2);
+    double pp = sqrtpos(ee*ee - mm*mm);
+    event.append(  2, 23, 101,   0, 0., 0.,  pp, ee, mm);
+    event.append( -2, 23,   0, 101, 0., 0., -pp, ee, mm);
+
+  // A u g ubar system.
+  } else if (type == 2) {
+    event.append(  2, 23, 101,   0,   0., 0.,  50., 50.);
+    event.append( 21, 23, 102, 101,  40., 0., -30., 50.);
+    event.append( -2, 23,   0, 102, -40., 0., -30., 50.);
+
+  // A u ubar system with eight gluons in between, spread in angle.
+  } else if (type == 3) {
+    event.append(  2, 23, 101,   0, 0., 0.,  100., 100.);
+    for (int iGlu = 0; iGlu < 8; ++iGlu) {
+      double theta = M_PI * (iGlu + 1.) / 9.;
+      double phi   = 2.4 * iGlu;
+      double ee    = 20. + 5. * iGlu;
+      event.append( 21, 23, 102 + iGlu, 101 + iGlu,
+        ee * sin(theta) * cos(phi), ee * sin(theta) * sin(phi),
+        ee * cos(theta), ee);
+    }
+    event.append( -2, 23,   0, 109, 0., 0., -100., 100.);
+
+  // A closed g g g loop.
+  } else if (type == 4) {
+    event.append( 21, 23, 101, 102,   0., 0.,  50., 50.);
+    event.append( 21, 23, 102, 103,  40., 0., -30., 50.);
+    event.append( 21, 23, 103, 101, -40., 0., -30., 50.);
+
+  // A q q q junction system, with a colour singlet mother.
+  } else if (type == 5) {
+    double rt75 = sqrt(0.75);
+    event.append( 1000022, -21, 0, 0, 2, 4, 0, 0, 0., 0., 50.5, 50.5);
+    event.append( 2, 23, 1, 0, 0, 0, 101, 0,         0., 0., 50.5, 50.5);
+    event.append( 2, 23, 1, 0, 0, 0, 102, 0,  rt75 * 50., 0., -25., 50.);
+    event.append( 1, 23, 1, 0, 0, 0, 103, 0, -rt75 * 50., 0., -25., 50.);
+  }
+
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of times each configuration is fragmented.
+  int nRepeat = 20000;
+
+  // The configurations.
+  vector<string> names = { "u ubar, 20 GeV", "u ubar, 1 TeV", "u g ubar",
+    "u 8g ubar", "g g g loop", "q q q junction" };
+
+  // Header of table.
+  cout << "\n                       default           close packing\n"
+       << " configuration     us/string  hadrons   us/string  hadrons\n";
+
+  // One generator for each option, only doing the fragmentation.
+  vector<Pythia*> pythias;
+  for (int iOpt = 0; iOpt < 2; ++iOpt) {
+    Pythia* pythiaPtr = new Pythia("../share/Pythia8/xmldoc", false);
+    pythiaPtr->readString("ProcessLevel:all = off");
+    pythiaPtr->readString("HadronLevel:Decay = off");
+    pythiaPtr->readString("Check:event = off");
+    pythiaPtr->readString("Next:numberCount = 0");
+    pythiaPtr->readString("Print:quiet = on");
+    if (iOpt == 1) pythiaPtr->readString("StringPT:closePacking = on");
+    if (!pythiaPtr->init()) return 1;
+    pythias.push_back(pythiaPtr);
+  }
+
+  // Loop over configurations and options.
+  double timeSum[2] = {0., 0.};
+  for (int type = 0; type < int(names.size()); ++type) {
+    cout << " " << left << setw(16) << names[type] << right;
+    for (int iOpt = 0; iOpt < 2; ++iOpt) {
+      Pythia& pythia = *pythias[iOpt];
+      double nHadron = 0.;
+      clock_t timeBeg = clock();
+      for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat) {
+        fillPartons( type, pythia.event, pythia.particleData);
+        if (!pythia.next()) continue;
+        for (int i = 0; i < pythia.event.size(); ++i)
+          if (pythia.event[i].isFinal()) ++nHadron;
+      }
+      double timeNow = double(clock() - timeBeg) / CLOCKS_PER_SEC;
+      timeSum[iOpt] += timeNow;
+      cout << fixed << setprecision(2) << setw(12)
+           << 1e6 * timeNow / nRepeat << setprecision(1) << setw(9)
+           << nHadron / nRepeat;
+    }
+    cout << endl;
+  }
+
+  // Summary: total time.
+  cout << "\n Total time: " << fixed << setprecision(2) << timeSum[0]
+       << " s default, " << timeSum[1] << " s with close packing." << endl;
+
+  // Done.
+  for (Pythia* pythiaPtr : pythias) delete pythiaPtr;
+  return 0;
+}
@@ -0,0 +1,121 @@
+// main167.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: fragmentation; parallelism; timing; benchmark;
+
+// Test of the parallel fragmentation of the strings of an event, with
+// StringFragmentation:parallel = on. Parton-level events of several
+// minimum-bias collisions overlaid are fragmented with decays switched
+// off, by the normal sequential method and by the parallel one for
+// different numbers of threads, all with the same random-number seed.
+// The parallel results should not depend on the number of threads,
+// and the time spent is compared. The speedup depends on the number
+// of cores available on the machine.
+
+#include "Pythia8/Pythia.h"
+#include <chrono>
+using namespace Pythia8;
+
+//==========================================================================
+
+// A simple checksum of an event, sensitive to the order of particles.
+
+double checksum(const Event& event) {
+  double sum = 0.;
+  for (int i = 0; i < event.size(); ++i)
+    sum += (i + 1.) * (event[i].id() + event[i].px() + event[i].pz());
+  return sum;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of events, and number of overlaid collisions in each.
+  int nEvent   = 50;
+  int nOverlay = 10;
+
+  // Thread numbers to try; 0 means the sequential method.
+  vector<int> nThreads = { 0, 1, 2, 4, 8 };
+
+  // Generator of parton-level minimum-bias events.
+  Pythia pythiaPL;
+  pythiaPL.readString("Beams:eCM = 13000.");
+  pythiaPL.readString("SoftQCD:nonDiffractive = on");
+  pythiaPL.readString("HadronLevel:all = off");
+  pythiaPL.readString("Next:numberCount = 0");
+  pythiaPL.readString("Print:quiet = on");
+  if (!pythiaPL.init()) return 1;
+
+  // Overlay the final partons and junctions of several collisions, each
+  // shifted in colour tags so as to form separate colour singlets.
+  vector<Event> events;
+  for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+    Event eventAll = pythiaPL.event;
+    eventAll.reset();
+    for (int iOverlay = 0; iOverlay < nOverlay; ++iOverlay) {
+      if (!pythiaPL.next()) continue;
+      int colOffset = eventAll.lastColTag();
+      for (int i = 0; i < pythiaPL.event.size(); ++i)
+      if (pythiaPL.event[i].isFinal()) {
+        Particle parton = pythiaPL.event[i];
+        parton.mothers( 0, 0);
+        if (parton.col() > 0)  parton.col( parton.col() + colOffset);
+        if (parton.acol() > 0) parton.acol( parton.acol() + colOffset);
+        eventAll.append( parton);
+      }
+      for (int iJun = 0; iJun < pythiaPL.event.sizeJunction(); ++iJun) {
+        Junction junction = pythiaPL.event.getJunction(iJun);
+        for (int j = 0; j < 3; ++j) junction.cols( j,
+          junction.col(j) + colOffset, junction.endCol(j) + colOffset);
+        eventAll.appendJunction( junction);
+      }
+    }
+    events.push_back( eventAll);
+  }
+
+  // Header of table.
+  cout << "\n  threads   ms per event   checksum of all events\n";
+
+  // Loop over thread numbers, with one generator for each.
+  for (int nThread : nThreads) {
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    pythia.readString("ProcessLevel:all = off");
+    pythia.readString("HadronLevel:Decay = off");
+    pythia.readString("Check:event = off");
+    pythia.readString("Print:quiet = on");
+    pythia.readString("Random:setSeed = on");
+    pythia.readString("Random:seed = 4711");
+    if (nThread > 0) {
+      pythia.readString("StringFragmentation:parallel = on");
+      pythia.readString("StringFragmentation:numThreads = "
+        + to_string(nThread));
+    }
+    if (!pythia.init()) return 1;
+
+    // Fragment the events, and time it.
+    double sum  = 0.;
+    double time = 0.;
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+      pythia.event = events[iEvent];
+      // Wall-clock time, since clock() would add up all threads.
+      auto timeBeg = std::chrono::steady_clock::now();
+      if (!pythia.forceHadronLevel(false)) continue;
+      time += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - timeBeg).count();
+      sum  += checksum( pythia.event);
+    }
+
+    // Print results for this thread number.
+    cout << setw(9);
+    if (nThread == 0) cout << "none";
+    else cout << nThread;
+    cout << fixed << setprecision(3) << setw(15) << 1e3 * time / nEvent
+         << scientific << setprecision(12) << setw(25) << sum << endl;
+  }
+
+  // Done.
+  return 0;
+}
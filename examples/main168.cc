@@ -0,0 +1,137 @@
+// main168.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: rope hadronization; heavy ions; timing; benchmark;
+
+// Benchmark of flavour ropes as a function of the number of participating
+// nucleons. A heavy-ion collision is mimicked by overlaying the parton
+// levels of nPart/2 nucleon-nucleon collisions, each shifted in impact
+// parameter to a random point inside a disc with the radius of a nucleus
+// of nPart/2 nucleons. The hadronization of the combined event, with
+// decays switched off, is timed both with the default search for string
+// overlaps, which considers all pairs of dipoles, and with the faster
+// preselection in the lab frame, Ropewalk:fastOverlaps = on. As a crude
+// check of the physics, also the fraction of strange hadrons is shown.
+// The default search is only run up to a maximal nPart, above which it
+// becomes too slow.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Numbers of participating nucleons, and number of events for each.
+  vector<int> nParts = { 2, 8, 32, 64, 128, 256, 416 };
+  int nEvent = 2;
+
+  // Largest number of participants for the default overlap search.
+  int nPartMaxAll = 128;
+
+  // Generator of parton-level minimum-bias events, with vertices.
+  Pythia pythiaPL;
+  pythiaPL.readString("Beams:eCM = 5020.");
+  pythiaPL.readString("SoftQCD:nonDiffractive = on");
+  pythiaPL.readString("PartonVertex:setVertex = on");
+  pythiaPL.readString("HadronLevel:all = off");
+  pythiaPL.readString("Next:numberCount = 0");
+  pythiaPL.readString("Print:quiet = on");
+  if (!pythiaPL.init()) return 1;
+
+  // One generator for each overlap search, only doing the hadron level.
+  vector<Pythia*> pythias;
+  for (int iFast = 0; iFast < 2; ++iFast) {
+    Pythia* pythiaPtr = new Pythia("../share/Pythia8/xmldoc", false);
+    pythiaPtr->readString("ProcessLevel:all = off");
+    pythiaPtr->readString("HadronLevel:Decay = off");
+    pythiaPtr->readString("Check:event = off");
+    pythiaPtr->readString("Print:quiet = on");
+    pythiaPtr->readString("Ropewalk:RopeHadronization = on");
+    pythiaPtr->readString("Ropewalk:doFlavour = on");
+    pythiaPtr->readString("PartonVertex:setVertex = on");
+    if (iFast == 1) pythiaPtr->readString("Ropewalk:fastOverlaps = on");
+    if (!pythiaPtr->init()) return 1;
+    pythias.push_back(pythiaPtr);
+  }
+  Rndm& rndm = pythiaPL.rndm;
+
+  // Header of table.
+  cout << "\n                   time per event (s)    fraction strange\n"
+       << "   nPart   partons     all pairs     fast   all pairs     fast\n";
+
+  // Loop over numbers of participants and events.
+  for (int nPart : nParts) {
+    int nColl = max( 1, nPart / 2);
+    double rNucleus = 1.2 * pow( double(nColl), 1. / 3.);
+    vector<double> times(2, 0.), nStrange(2, 0.), nHadron(2, 0.);
+    double nParton = 0.;
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+
+      // Overlay the final partons and junctions of the collisions, each
+      // shifted in colour tags and in impact parameter.
+      Event& eventAll = pythias[0]->event;
+      eventAll.reset();
+      for (int iColl = 0; iColl < nColl; ++iColl) {
+        if (!pythiaPL.next()) continue;
+        double rNow   = rNucleus * sqrt(rndm.flat());
+        double phiNow = 2. * M_PI * rndm.flat();
+        Vec4 vShift( rNow * cos(phiNow), rNow * sin(phiNow), 0., 0.);
+        int colOffset = eventAll.lastColTag();
+        for (int i = 0; i < pythiaPL.event.size(); ++i)
+        if (pythiaPL.event[i].isFinal()) {
+          Particle parton = pythiaPL.event[i];
+          parton.mothers( 0, 0);
+          if (parton.col() > 0)  parton.col( parton.col() + colOffset);
+          if (parton.acol() > 0) parton.acol( parton.acol() + colOffset);
+          parton.vProdAdd( vShift * FM2MM);
+          eventAll.append( parton);
+        }
+        for (int iJun = 0; iJun < pythiaPL.event.sizeJunction(); ++iJun) {
+          Junction junction = pythiaPL.event.getJunction(iJun);
+          for (int j = 0; j < 3; ++j) junction.cols( j,
+            junction.col(j) + colOffset, junction.endCol(j) + colOffset);
+          eventAll.appendJunction( junction);
+        }
+      }
+      nParton += eventAll.size() - 1;
+      pythias[1]->event = eventAll;
+
+      // Time the hadron level for both overlap searches.
+      for (int iFast = 0; iFast < 2; ++iFast) {
+        if (iFast == 0 && nPart > nPartMaxAll) continue;
+        Pythia& pythia = *pythias[iFast];
+        clock_t timeBeg = clock();
+        if (!pythia.forceHadronLevel(false)) continue;
+        times[iFast] += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+        for (int i = 0; i < pythia.event.size(); ++i)
+        if (pythia.event[i].isFinal() && pythia.event[i].isHadron()) {
+          ++nHadron[iFast];
+          int idAbs = pythia.event[i].idAbs();
+          if ( (idAbs / 10) % 10 == 3 || (idAbs / 100) % 10 == 3
+            || (idAbs / 1000) % 10 == 3) ++nStrange[iFast];
+        }
+      }
+    }
+
+    // Print results for this number of participants.
+    cout << setw(8) << nPart << setw(10) << int(nParton / nEvent) << fixed;
+    for (int iFast = 0; iFast < 2; ++iFast) {
+      if (iFast == 0 && nPart > nPartMaxAll) cout << setw(13) << "-";
+      else cout << setprecision(3) << setw(iFast == 0 ? 13 : 9)
+                << times[iFast] / nEvent;
+    }
+    for (int iFast = 0; iFast < 2; ++iFast) {
+      if (iFast == 0 && nPart > nPartMaxAll) cout << setw(12) << "-";
+      else cout << setprecision(4) << setw(iFast == 0 ? 12 : 9)
+                << nStrange[iFast] / max( 1., nHadron[iFast]);
+    }
+    cout << endl;
+  }
+
+  // Done.
+  for (Pythia* pythiaPtr : pythias) delete pythiaPtr;
+  return 0;
+}
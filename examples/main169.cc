@@ -0,0 +1,98 @@
+// main169.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: deuterons; heavy ions; timing; benchmark;
+
+// Benchmark of deuteron production as a function of the number of
+// nucleons in an event. High-multiplicity events are mimicked by
+// overlaying the final particles of several minimum-bias events, up to
+// numbers of nucleons typical of central heavy-ion collisions, and the
+// resulting events are handed to the hadron level for the deuteron
+// production. Since all nucleon pairs are tried, the time grows like
+// the number of nucleons squared, and the time per pair is shown, as
+// well as the number of (anti)deuterons formed per event. A checksum of
+// the final events allows to check that changes in the implementation
+// do not change the results, with the same random-number seed.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Numbers of overlaid events, and number of events for each.
+  vector<int> nOverlays = { 1, 4, 16, 64, 256 };
+  int nEvent = 4;
+
+  // Generator of minimum-bias events, without deuteron production.
+  Pythia pythiaMB;
+  pythiaMB.readString("Beams:eCM = 13000.");
+  pythiaMB.readString("SoftQCD:nonDiffractive = on");
+  pythiaMB.readString("Next:numberCount = 0");
+  pythiaMB.readString("Print:quiet = on");
+  if (!pythiaMB.init()) return 1;
+
+  // Generator only doing the hadron level, i.e. the deuteron production.
+  Pythia pythia("../share/Pythia8/xmldoc", false);
+  pythia.readString("ProcessLevel:all = off");
+  pythia.readString("HadronLevel:DeuteronProduction = on");
+  pythia.readString("HadronLevel:Decay = off");
+  pythia.readString("Check:event = off");
+  pythia.readString("Print:quiet = on");
+  pythia.readString("Random:setSeed = on");
+  pythia.readString("Random:seed = 4711");
+  if (!pythia.init()) return 1;
+
+  // Header of table.
+  cout << "\n   nucleons        pairs   ms per event   ns per pair"
+       << "   deuterons        checksum\n";
+
+  // Loop over multiplicities and events.
+  for (int nOverlay : nOverlays) {
+    double nNucleon = 0., nPair = 0., nDeuteron = 0., time = 0., sum = 0.;
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+
+      // Overlay the final particles of several minimum-bias events.
+      Event& event = pythia.event;
+      event.reset();
+      int nNuc[2] = { 0, 0};
+      for (int iOverlay = 0; iOverlay < nOverlay; ++iOverlay) {
+        if (!pythiaMB.next()) continue;
+        for (int i = 0; i < pythiaMB.event.size(); ++i)
+        if (pythiaMB.event[i].isFinal()) {
+          event.append( pythiaMB.event[i].id(), 81, 0, 0,
+            pythiaMB.event[i].p(), pythiaMB.event[i].m());
+          int idAbs = pythiaMB.event[i].idAbs();
+          if (idAbs == 2212 || idAbs == 2112)
+            ++nNuc[ (pythiaMB.event[i].id() > 0) ? 0 : 1];
+        }
+      }
+      nNucleon += nNuc[0] + nNuc[1];
+      nPair    += 0.5 * (nNuc[0] * (nNuc[0] - 1.) + nNuc[1] * (nNuc[1] - 1.));
+
+      // Time the hadron level, i.e. the deuteron production.
+      clock_t timeBeg = clock();
+      if (!pythia.forceHadronLevel(false)) continue;
+      time += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+      // Count deuterons, and find a checksum of the event.
+      for (int i = 0; i < event.size(); ++i) {
+        if (event[i].idAbs() == 1000010020) ++nDeuteron;
+        sum += (i + 1.) * (event[i].id() + event[i].px() + event[i].pz());
+      }
+    }
+
+    // Print results for this multiplicity.
+    cout << fixed << setprecision(1) << setw(11) << nNucleon / nEvent
+         << setprecision(0) << setw(13) << nPair / nEvent << setprecision(3)
+         << setw(15) << 1e3 * time / nEvent << setprecision(2) << setw(14)
+         << 1e9 * time / max( 1., nPair) << setw(12) << nDeuteron / nEvent
+         << scientific << setprecision(9) << setw(18) << sum << endl;
+  }
+
+  // Done.
+  return 0;
+}
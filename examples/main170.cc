@@ -0,0 +1,107 @@
+// main170.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: decays; timing; benchmark;
+
+// Test of lazy decays, HadronLevel:lazyDecays = on, where the decays are
+// only done when asked for. Minimum-bias events are generated with all
+// decays done as usual, and with lazy decays where only particles inside
+// a central region are decayed, and the time per event is compared. The
+// region is taken somewhat wider than where the charged particles are
+// counted, since decay products may end up at other rapidities.
+// Furthermore two generators with lazy decays and the same seed decay all
+// particles in opposite orders, which should give the same final state
+// apart from the order of the particles, and thereafter the same events.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+// The final particles of an event, sorted, to compare regardless of order.
+
+vector< pair<int, double> > finalState(const Event& event) {
+  vector< pair<int, double> > particles;
+  for (int i = 0; i < event.size(); ++i) if (event[i].isFinal())
+    particles.push_back( make_pair( event[i].id(), event[i].px()));
+  sort( particles.begin(), particles.end());
+  return particles;
+}
+
+//==========================================================================
+
+int main() {
+
+  // Number of events.
+  int nEvent = 2000;
+
+  // Central region where charged particles are counted, and the somewhat
+  // wider one where particles are decayed in the lazy case.
+  double etaMax = 1.;
+  auto isCentral = [etaMax](const Particle& prt) {
+    return abs(prt.eta()) < etaMax; };
+  auto toDecay = [etaMax](const Particle& prt) {
+    return abs(prt.eta()) < etaMax + 1.; };
+
+  // Header of table.
+  cout << "\n decays                ms per event   charged in |eta| < "
+       << fixed << setprecision(1) << etaMax << endl;
+
+  // Time events with all decays and with lazy decays in the central region.
+  for (int iLazy = 0; iLazy < 2; ++iLazy) {
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    pythia.readString("Beams:eCM = 13000.");
+    pythia.readString("SoftQCD:nonDiffractive = on");
+    pythia.readString("Next:numberCount = 0");
+    pythia.readString("Print:quiet = on");
+    if (iLazy == 1) pythia.readString("HadronLevel:lazyDecays = on");
+    if (!pythia.init()) return 1;
+    double nCharged = 0.;
+    clock_t timeBeg  = clock();
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent) {
+      if (!pythia.next()) continue;
+      if (iLazy == 1) pythia.decayPendingIf( toDecay);
+      for (int i = 0; i < pythia.event.size(); ++i)
+        if (pythia.event[i].isFinal() && pythia.event[i].isCharged()
+          && isCentral( pythia.event[i]) ) ++nCharged;
+    }
+    cout << (iLazy == 0 ? " all, as usual     " : " lazy, central only")
+         << setprecision(3) << setw(17) << 1e3 * double(clock() - timeBeg)
+      / CLOCKS_PER_SEC / nEvent << setprecision(2) << setw(16) << nCharged / nEvent << endl;
+  }
+
+  // Two generators with lazy decays and the same seed.
+  vector<Pythia*> pythias;
+  for (int iGen = 0; iGen < 2; ++iGen) {
+    Pythia* pythiaPtr = new Pythia("../share/Pythia8/xmldoc", false);
+    pythiaPtr->readString("Beams:eCM = 13000.");
+    pythiaPtr->readString("SoftQCD:nonDiffractive = on");
+    pythiaPtr->readString("HadronLevel:lazyDecays = on");
+    pythiaPtr->readString("Next:numberCount = 0");
+    pythiaPtr->readString("Print:quiet = on");
+    pythiaPtr->readString("Random:setSeed = on");
+    pythiaPtr->readString("Random:seed = 4711");
+    if (!pythiaPtr->init()) return 1;
+    pythias.push_back(pythiaPtr);
+  }
+
+  // Decay all particles, in opposite orders, and compare final states.
+  int nSame = 0;
+  int nTest = nEvent / 10;
+  for (int iEvent = 0; iEvent < nTest; ++iEvent) {
+    if (!pythias[0]->next() || !pythias[1]->next()) continue;
+    int sizeOld = pythias[0]->event.size();
+    for (int i = 0; i < sizeOld; ++i) pythias[0]->decayPending(i);
+    for (int i = sizeOld - 1; i >= 0; --i) pythias[1]->decayPending(i);
+    if (finalState( pythias[0]->event) == finalState( pythias[1]->event))
+      ++nSame;
+  }
+  cout << "\n Decays in opposite orders gave the same final state in "
+       << nSame << " out of " << nTest << " events." << endl;
+
+  // Done.
+  for (Pythia* pythiaPtr : pythias) delete pythiaPtr;
+  return 0;
+}
@@ -0,0 +1,101 @@
+// main171.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: tau decays; timing; benchmark;
+
+// Benchmark of tau decays with spin correlations. Z -> tau+ tau- and
+// W -> tau nu events are generated with the tau decays switched off,
+// whereafter the taus of the stored events are decayed with moreDecays(),
+// and the time per event is shown. This is done both with the default
+// decay model, where the tau polarization and the correlations between
+// the two taus are found from the helicity matrix elements of the hard
+// process and of the decays, and with the old isotropic decays for
+// comparison. The average energy fraction taken by the pion in
+// tau -> pi nu decays is sensitive to the tau polarization, and a checksum
+// of the events allows to check that changes in the implementation do not
+// change the results, with the same random-number seed.
+
+#include "Pythia8/Pythia.h"
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // Number of events.
+  int nEvent = 1000;
+
+  // Header of table.
+  cout << "\n sample        decay model   us per event   <x_pi>"
+       << "          checksum\n";
+
+  // Loop over the Z and W samples and over the decay models.
+  for (int iW = 0; iW < 2; ++iW)
+  for (int mode = 1; mode >= 0; --mode) {
+
+    // Set up the generator. Tau decays are off during the generation.
+    Pythia pythia("../share/Pythia8/xmldoc", false);
+    pythia.readString("Beams:eCM = 13000.");
+    if (iW == 0) {
+      pythia.readString("WeakSingleBoson:ffbar2gmZ = on");
+      pythia.readString("PhaseSpace:mHatMin = 80.");
+      pythia.readString("23:onMode = off");
+      pythia.readString("23:onIfAny = 15");
+    } else {
+      pythia.readString("WeakSingleBoson:ffbar2W = on");
+      pythia.readString("24:onMode = off");
+      pythia.readString("24:onIfAny = 15");
+    }
+    pythia.readString("PartonLevel:MPI = off");
+    pythia.readString("TauDecays:mode = " + to_string(mode));
+    pythia.readString("15:mayDecay = off");
+    pythia.readString("Next:numberCount = 0");
+    pythia.readString("Print:quiet = on");
+    pythia.readString("Random:setSeed = on");
+    pythia.readString("Random:seed = 4711");
+    if (!pythia.init()) return 1;
+
+    // Generate and store the events.
+    vector<Event> events;
+    for (int iEvent = 0; iEvent < nEvent; ++iEvent)
+      if (pythia.next()) events.push_back( pythia.event);
+
+    // Decay the taus of the stored events, and time it.
+    pythia.particleData.mayDecay( 15, true);
+    double sum = 0., xPi = 0., nPi = 0., time = 0.;
+    for (Event& eventNow : events) {
+      Event& event = pythia.event;
+      event = eventNow;
+      clock_t timeBeg = clock();
+      if (!pythia.moreDecays()) continue;
+      time += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+      // Energy fraction of the pion in tau -> pi nu, and the checksum.
+      for (int i = 0; i < event.size(); ++i) {
+        if (event[i].idAbs() == 15 && event[i].daughter2()
+          == event[i].daughter1() + 1) {
+          int iPi = event[i].daughter1();
+          if (event[iPi].idAbs() != 211) ++iPi;
+          if (event[iPi].idAbs() == 211) {
+            xPi += event[iPi].e() / event[i].e();
+            ++nPi;
+          }
+        }
+        sum += (i + 1.) * (event[i].id() + event[i].px() + event[i].pz());
+      }
+    }
+
+    // Print results for this sample and decay model.
+    cout << (iW == 0 ? " Z -> tau tau " : " W -> tau nu  ")
+         << (mode == 1 ? "   helicity" : "  isotropic") << fixed
+         << setprecision(1) << setw(15) << 1e6 * time
+         / max( 1, int(events.size()))
+         << setprecision(4) << setw(9) << xPi / max( 1., nPi)
+         << scientific << setprecision(9) << setw(18) << sum << endl;
+  }
+
+  // Done.
+  return 0;
+}
@@ -0,0 +1,78 @@
+// main172.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: parton distribution; timing; benchmark;
+
+// Test of the binary format for LHAPDF6 lhagrid1 files, read by the
+// internal LHAGrid1 class. A grid file is converted to the binary format,
+// whereafter the time to set up the PDF from the original file and from
+// the binary one is compared. The binary file is mapped into memory
+// rather than read, so that the pages holding the grid can be shared by
+// several processes on the same machine. The PDF values from the two
+// files are compared in a range of x and Q2 values, and should agree
+// exactly. The binary file is removed at the end.
+
+#include "Pythia8/Pythia.h"
+#include <cstdio>
+using namespace Pythia8;
+
+//==========================================================================
+
+int main() {
+
+  // The grid file, and the binary file to be made from it.
+  string pdfdataPath = "../share/Pythia8/pdfdata/";
+  string asciiFile   = "NNPDF31_nnlo_as_0118_luxqed_0000.dat";
+  string binFile     = "main172.dat.bin";
+
+  // Number of times the PDF is set up for each file.
+  int nInit = 20;
+
+  // Convert the grid file to the binary format.
+  clock_t timeBeg = clock();
+  if (!LHAGrid1::convertToBinary( pdfdataPath + asciiFile, binFile)) {
+    cout << " Failed to convert " << asciiFile << endl;
+    return 1;
+  }
+  cout << "\n Converted " << asciiFile << " in " << fixed
+       << setprecision(2) << 1e3 * double(clock() - timeBeg) / CLOCKS_PER_SEC
+       << " ms." << endl;
+
+  // Time the setup from the two files. Each PDF is deleted before the next
+  // one is set up, so that the grid is read in anew every time.
+  double times[2] = {0., 0.};
+  for (int iInit = 0; iInit < nInit; ++iInit)
+  for (int iBin = 0; iBin < 2; ++iBin) {
+    timeBeg = clock();
+    LHAGrid1 pdf( 2212, (iBin == 0) ? asciiFile : binFile,
+      (iBin == 0) ? pdfdataPath : "./");
+    times[iBin] += double(clock() - timeBeg) / CLOCKS_PER_SEC;
+  }
+  cout << "\n Time to set up the PDF from the grid file:   " << setw(9)
+       << setprecision(3) << 1e3 * times[0] / nInit << " ms"
+       << "\n Time to set up the PDF from the binary file: " << setw(9)
+       << 1e3 * times[1] / nInit << " ms" << endl;
+
+  // Compare the PDF values from the two files, for all flavours.
+  LHAGrid1 pdfAscii( 2212, asciiFile, pdfdataPath);
+  LHAGrid1 pdfBin( 2212, binFile, "./");
+  int nPoint = 0, nDiff = 0;
+  for (double lnx = log(1e-8); lnx < 0.; lnx += 0.1)
+  for (double lnQ2 = log(1.); lnQ2 < log(1e8); lnQ2 += 0.1) {
+    double x  = exp(lnx);
+    double Q2 = exp(lnQ2);
+    for (int id = -5; id <= 22; ++id) {
+      if (id > 5 && id != 21 && id != 22) continue;
+      ++nPoint;
+      if (pdfAscii.xf( id, x, Q2) != pdfBin.xf( id, x, Q2)) ++nDiff;
+    }
+  }
+  cout << "\n PDF values differ in " << nDiff << " out of " << nPoint
+       << " cases." << endl;
+
+  // Done.
+  remove( binFile.c_str());
+  return 0;
+}
@@ -0,0 +1,145 @@
+// main173.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Keywords: parton distribution; uncertainty bands; timing; benchmark;
+
+// Test of PDF uncertainties from all members of a set with the internal
+// LHAGrid1 class, where the search in the grid and the interpolation
+// weights are shared by all members. Since only the central member of
+// each set comes with Pythia, a set of pseudo-replicas is made from it,
+// by rescaling each flavour of the central grid by a random factor. The
+// ratios of PDFs used for PDF variations in the showers are found both
+// with calcPDFEnvelope, for all members at once, and with one PDF object
+// per member, one at a time, and the time per ratio and the largest
+// difference between the two are shown. The member files are removed at
+// the end.
+
+#include "Pythia8/Pythia.h"
+#include <cstdio>
+using namespace Pythia8;
+
+//==========================================================================
+
+// Write a pseudo-replica of a grid file, with each flavour rescaled. After
+// each --- separator follow the x, Q and flavour lines of a subgrid, and
+// then its grid values, one line per (x, Q) point.
+
+bool writeMember(string inFile, string outFile, Rndm& rndm) {
+  ifstream is( inFile.c_str() );
+  ofstream os( outFile.c_str() );
+  if (!is.good() || !os.good()) return false;
+  vector<double> factors;
+  for (int iid = 0; iid < 20; ++iid)
+    factors.push_back( 1. + 0.03 * rndm.gauss());
+  string line;
+  int iLine = -1;
+  while (getline( is, line)) {
+    if (line.find("---") != string::npos) iLine = 0;
+    else if (iLine >= 0) ++iLine;
+    if (iLine < 4) os << line << "\n";
+    else {
+      istringstream isLine(line);
+      double value;
+      for (int iid = 0; isLine >> value; ++iid)
+        os << scientific << setprecision(7) << setw(15)
+           << value * factors[iid];
+      os << "\n";
+    }
+  }
+  return os.good();
+}
+
+//==========================================================================
+
+int main() {
+
+  // The central member, and the name of the set made from it.
+  string pdfdataPath = "../share/Pythia8/pdfdata/";
+  string centralFile = "NNPDF23_lo_as_0130_qed_0000.dat";
+  string setName     = "main173";
+
+  // Number of members, including the central one, and of PDF ratios.
+  int nMember = 21;
+  int nRatio  = 20000;
+
+  // Write the members of the set, and the info file giving the error type.
+  Rndm rndm(4711);
+  vector<string> files;
+  for (int iMem = 0; iMem < nMember; ++iMem) {
+    string memberNum = to_string(iMem);
+    memberNum = string( 4 - memberNum.length(), '0') + memberNum;
+    files.push_back( setName + "_" + memberNum + ".dat");
+    ifstream isCentral( (pdfdataPath + centralFile).c_str() );
+    ofstream osMember( files.back().c_str() );
+    if (iMem == 0) osMember << isCentral.rdbuf();
+    else {
+      osMember.close();
+      if (!writeMember( pdfdataPath + centralFile, files.back(), rndm))
+        return 1;
+    }
+  }
+  ofstream osInfo( (setName + ".info").c_str() );
+  osInfo << "ErrorType: replicas" << endl;
+  osInfo.close();
+
+  // The set with all members, and one PDF for each member.
+  LHAGrid1 pdfSet( 2212, files[0], "./");
+  cout << "\n Found " << pdfSet.initMembers( nMember) << " members of "
+       << nMember << "." << endl;
+  vector<LHAGrid1*> pdfMembers;
+  for (int iMem = 0; iMem < nMember; ++iMem)
+    pdfMembers.push_back( new LHAGrid1( 2212, files[iMem], "./"));
+
+  // Points at which PDF ratios are found, as in the spacelike shower.
+  int idList[6] = { 21, 1, 2, -1, -2, 3};
+  vector<int> id1s, id2s;
+  vector<double> x1s, x2s, Q2s;
+  for (int iRatio = 0; iRatio < nRatio; ++iRatio) {
+    id1s.push_back( idList[int(6 * rndm.flat())]);
+    id2s.push_back( idList[int(6 * rndm.flat())]);
+    x1s.push_back( pow( 10., -5. + 4.9 * rndm.flat()));
+    x2s.push_back( x1s.back() * rndm.flat());
+    Q2s.push_back( pow( 10., 0.5 + 3.5 * rndm.flat()));
+  }
+
+  // Ratios for all members at once.
+  vector<double> ratiosSet, ratiosMembers;
+  clock_t timeBeg = clock();
+  for (int iRatio = 0; iRatio < nRatio; ++iRatio) {
+    pdfSet.calcPDFEnvelope( make_pair( id1s[iRatio], id2s[iRatio]),
+      make_pair( x1s[iRatio], x2s[iRatio]), Q2s[iRatio], 0);
+    PDF::PDFEnvelope envelope = pdfSet.getPDFEnvelope();
+    ratiosSet.insert( ratiosSet.end(), envelope.pdfMemberVars.begin(),
+      envelope.pdfMemberVars.end());
+  }
+  double timeSet = double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+  // Ratios for one member at a time.
+  timeBeg = clock();
+  for (int iRatio = 0; iRatio < nRatio; ++iRatio)
+  for (int iMem = 0; iMem < nMember; ++iMem)
+    ratiosMembers.push_back( max( 0., pdfMembers[iMem]->xf( id1s[iRatio],
+      x1s[iRatio], Q2s[iRatio])) / max( 1e-10, pdfMembers[iMem]->xf(
+      id2s[iRatio], x2s[iRatio], Q2s[iRatio])));
+  double timeMembers = double(clock() - timeBeg) / CLOCKS_PER_SEC;
+
+  // Compare the results.
+  double diffMax = 0.;
+  for (size_t i = 0; i < ratiosSet.size() && i < ratiosMembers.size(); ++i)
+    diffMax = max( diffMax, abs(ratiosSet[i] - ratiosMembers[i])
+      / max( 1e-10, abs(ratiosMembers[i])));
+  cout << "\n Time per ratio for " << nMember << " members, at once:    "
+       << fixed << setprecision(2) << setw(8) << 1e6 * timeSet / nRatio
+       << " us\n Time per ratio for " << nMember << " members, one by one: "
+       << setw(8) << 1e6 * timeMembers / nRatio << " us\n"
+       << "\n Largest relative difference: " << scientific
+       << setprecision(3) << diffMax << endl;
+
+  // Done.
+  for (LHAGrid1* pdfPtr : pdfMembers) delete pdfPtr;
+  for (string file : files) remove( file.c_str());
+  remove( (setName + ".info").c_str());
+  return 0;
+}
@@ -35,8 +35,9 @@ public:
     if (abs(power - 2.) < 0.01) powerInt = 2;
     powerMod = 0.5 * power - 1.;}
 
-  // Analyze event.
+  // Analyze event, either from the event record or stored by columns.
   bool analyze(const Event& event);
+  bool analyze(const EventColumns& columns);
 
   // Return info on results of analysis.
   double sphericity()      const {return 1.5 * (eVal2 + eVal3);}
@@ -70,6 +71,11 @@ private:
   // Error statistics;
   int    nFew;
 
+  // Add a particle to the tensor, and find the axes from the sum.
+  void addToTensor(double px, double py, double pz, double tt[4][4],
+    double& denom) const;
+  bool findAxes(double tt[4][4], double denom, int nStudy);
+
 };
 
 //==========================================================================
@@ -85,8 +91,9 @@ public:
   Thrust(int selectIn = 2) : select(selectIn), eVal1(), eVal2(), eVal3(),
     nFew(0) {}
 
-  // Analyze event.
+  // Analyze event, either from the event record or stored by columns.
   bool analyze(const Event& event);
+  bool analyze(const EventColumns& columns);
 
   // Return info on results of analysis.
   double thrust()       const {return eVal1;}
@@ -118,6 +125,9 @@ private:
   // Error statistics;
   int    nFew;
 
+  // Find the axes from the selected momenta.
+  bool findAxes(vector<Vec4>& pOrder);
+
 };
 
 //==========================================================================
@@ -446,9 +456,16 @@ public:
     if (useFJcore) return clusterFJ();
     while (clSize > 0) doStep();
     return true; }
+  bool analyze(const EventColumns& columns) {
+    if ( !setup(columns) ) return false;
+    if (useFJcore) return clusterFJ();
+    while (clSize > 0) doStep();
+    return true; }
 
-  // Set up list of particles to analyze, and initial distances.
+  // Set up list of particles to analyze, and initial distances, either
+  // from the event record or stored by columns (without SlowJetHook).
   bool setup(const Event& event);
+  bool setup(const EventColumns& columns);
 
   // Do one recombination step, possibly giving a jet.
   virtual bool doStep();
@@ -544,6 +561,10 @@ protected:
   int    origSize, clSize, clLast, jtSize, iMin, jMin;
   double dPhi, dijTemp, dMin;
 
+  // Store a selected particle, and find the initial distances.
+  void addCluster(const Vec4& pTemp, double mTemp, int i);
+  bool setupDistances();
+
   // Find next cluster pair to join.
   virtual void findNext();
 
@@ -338,41 +338,72 @@ public:
   // generates a random number uniformly distributed between 1 and 1.
   virtual double flat() = 0;
 
+  // Fill an array with n random numbers. Can be overloaded by a derived
+  // class that generates numbers faster in batches.
+  virtual void flat(double* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = flat();}
+
 };
 
 //==========================================================================
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm.
+// Marsaglia-Zaman-Tsang algorithm, or alternatively the xoshiro256**
+// algorithm, which allows to split the sequence into independent streams.
 
 class Rndm {
 
 public:
 
   // Constructors.
-  Rndm() : initRndm(false), i97(), j97(), seedSave(0), sequence(0), u(), c(),
-    cd(), cm(), useExternalRndm(false), rndmEngPtr(0) { }
-  Rndm(int seedIn) : initRndm(false), i97(), j97(), seedSave(0), sequence(0),
-    u(), c(), cd(), cm(), useExternalRndm(false), rndmEngPtr(0) {init(seedIn);}
+  Rndm() : initRndm(false), i97(), j97(), seedSave(0), algorithmSave(0),
+    sequence(0), u(), c(), cd(), cm(), xs(), useExternalRndm(false),
+    rndmEngPtr(0) { }
+  Rndm(int seedIn) : initRndm(false), i97(), j97(), seedSave(0),
+    algorithmSave(0), sequence(0), u(), c(), cd(), cm(), xs(),
+    useExternalRndm(false), rndmEngPtr(0) {init(seedIn);}
+
+  // Upper limit for the seeds of separate random-number streams,
+  // derived from the current one.
+  static const int SEEDMAX;
 
   // Possibility to pass in pointer for external random number generation.
   bool rndmEnginePtr( RndmEngine* rndmEngPtrIn);
 
-  // Initialize, normally at construction or in first call.
-  void init(int seedIn = 0) ;
+  // Initialize, normally at construction or in first call. The algorithm
+  // is 0 for Marsaglia-Zaman-Tsang and 1 for xoshiro256**.
+  void init(int seedIn = 0) {init( seedIn, algorithmSave);}
+  void init(int seedIn, int algorithmIn) ;
+
+  // Current algorithm.
+  int algorithm() const {return algorithmSave;}
+
+  // Jump ahead by nJump times 2^128 steps, to start an independent
+  // stream. Only possible for the xoshiro256** algorithm.
+  bool jump(int nJump = 1) ;
 
   // Generate next random number uniformly between 0 and 1.
   double flat() ;
 
+  // Fill an array with the next n random numbers, in the same order as
+  // n calls to flat(), but faster.
+  void flat(double* out, int n) ;
+
   // Generate random numbers according to exp(-x).
   double exp() { return -log(flat()) ;}
 
   // Generate random numbers according to x * exp(-x).
   double xexp() { return -log(flat() * flat()) ;}
 
-  // Generate random numbers according to exp(-x^2/2).
-  double gauss() {return sqrt(-2. * log(flat())) * cos(M_PI * flat());}
+  // Generate random numbers according to exp(-x^2/2). The two uniform
+  // numbers are drawn in a fixed order, first the one for the logarithm.
+  double gauss() {double r = sqrt(-2. * log(flat()));
+    return r * cos(M_PI * flat());}
+
+  // Fill an array with n random numbers according to exp(-x^2/2), in the
+  // same order as n calls to gauss().
+  void gauss(double* out, int n) ;
 
   // Generate two random numbers according to exp(-x^2/2-y^2/2).
   pair<double, double> gauss2() {double r = sqrt(-2. * log(flat()));
@@ -389,21 +420,41 @@ public:
   bool dumpState(string fileName);
   bool readState(string fileName);
 
+  // Number of random numbers generated so far by the internal generator,
+  // and whether an external generator is used instead.
+  long sequenceNumber() const {return sequence;}
+  bool useExternal() const {return useExternalRndm;}
+
 private:
 
-  // Default random number sequence.
-  static const int DEFAULTSEED;
+  // Default random number sequence, and size of batches.
+  static const int DEFAULTSEED, NBATCH;
 
   // State of the random number generator.
   bool   initRndm;
-  int    i97, j97, seedSave;
+  int    i97, j97, seedSave, algorithmSave;
   long   sequence;
   double u[97], c, cd, cm;
+  unsigned long long xs[4];
 
   // Pointer for external random number generation.
   bool   useExternalRndm;
   RndmEngine* rndmEngPtr;
 
+  // Next number of the xoshiro256** algorithm, uniformly in (0, 1).
+  // The 53 highest bits, offset by half a step, are scaled by 2^-53.
+  double xoshiroFlat() {
+    unsigned long long x = xs[1] * 5;
+    x = ((x << 7) | (x >> 57)) * 9;
+    unsigned long long t = xs[1] << 17;
+    xs[2] ^= xs[0];
+    xs[3] ^= xs[1];
+    xs[1] ^= xs[2];
+    xs[0] ^= xs[3];
+    xs[2] ^= t;
+    xs[3] = (xs[3] << 45) | (xs[3] >> 19);
+    return (double(x >> 11) + 0.5) * 1.1102230246251565e-16;}
+
 };
 
 //==========================================================================
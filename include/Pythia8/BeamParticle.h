@@ -149,10 +149,10 @@ public:
     hasResGammaInBeam(), isResUnres(), hasVMDstateInBeam(), initGammaBeam(),
     pTminISR(), pTminMPI(), pT2gm2qqbar(), iGamVal(), iPosVal(), gammaMode(),
     xGm(), Q2gm(), kTgamma(), phiGamma(), cPowerCache(-100), xsCache(-1),
-    resCache(), resolved(), nInit(0), hasJunctionBeam(), junCol(), nJuncs(),
-    nAjuncs(), nDiffJuncs(), allowBeamJunctions(), Q2ValFracSav(-1.),
-    uValInt(), dValInt(), idVal1(), idVal2(), idVal3(), zRel(), pxRel(),
-    pyRel() { }
+    resCache(), resolved(), nXfRecomputeSave(0), nInit(0), hasJunctionBeam(),
+    junCol(), nJuncs(), nAjuncs(), nDiffJuncs(), allowBeamJunctions(),
+    Q2ValFracSav(-1.), uValInt(), dValInt(), idVal1(), idVal2(), idVal3(),
+    zRel(), pxRel(), pyRel() { }
 
   // Initialize data on a beam particle and save pointers.
   void init( int idIn, double pzIn, double eIn, double mIn,
@@ -278,8 +278,12 @@ public:
   int size() const {return resolved.size();}
   int sizeInit() const {return nInit;}
 
-  // Clear list of resolved partons.
-  void clear() {resolved.resize(0); nInit = 0;}
+  // Clear list of resolved partons. Also reset the xfModified counter.
+  void clear() {resolved.resize(0); nInit = 0; nXfRecomputeSave = 0;}
+
+  // Number of calculations of the modified parton densities since the
+  // list was last cleared, i.e. normally in the current event.
+  int nXfRecompute() const {return nXfRecomputeSave;}
 
   // Reset variables related to photon beam.
   void resetGamma() {iGamVal = -1; iPosVal = -1; pT2gm2qqbar = 0.;
@@ -500,6 +504,9 @@ private:
   // The list of resolved partons.
   vector<ResolvedParton> resolved;
 
+  // Number of calculations of the modified parton densities.
+  int    nXfRecomputeSave;
+
   // Status after all initiators have been accounted for. Junction content.
   int    nInit;
   bool   hasJunctionBeam;
@@ -61,6 +61,10 @@ protected:
   // Pointer to the random number generator.
   Rndm*  rndmPtr;
 
+  // Pick a three-dimensional Gaussian truncated at maxDev.
+  void pickGauss3( double sigmaX, double sigmaY, double sigmaZ,
+    double maxDev, double& x, double& y, double& z);
+
 };
 
 //==========================================================================
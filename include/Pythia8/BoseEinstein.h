@@ -50,10 +50,10 @@ class BoseEinstein : public PhysicsBase {
 public:
 
   // Constructor.
-  BoseEinstein() : doPion(), doKaon(), doEta(), lambda(), QRef(),
-    nStep(), nStep3(), nStored(), QRef2(), QRef3(), R2Ref(), R2Ref2(),
-    R2Ref3(), mHadron(), mPair(), m2Pair(), deltaQ(), deltaQ3(), maxQ(),
-    maxQ3(), shift(), shift3() {}
+  BoseEinstein() : doPion(), doKaon(), doEta(), useQCut(), lambda(),
+    QRef(), QCut2(), nStep(), nStep3(), nStored(), QRef2(), QRef3(),
+    R2Ref(), R2Ref2(), R2Ref3(), mHadron(), mPair(), m2Pair(), deltaQ(),
+    deltaQ3(), maxQ(), maxQ3(), shift(), shift3() {}
 
   // Find settings. Precalculate table used to find momentum shifts.
   bool init();
@@ -68,8 +68,8 @@ private:
   static const double STEPSIZE, Q2MIN, COMPRELERR, COMPFACMAX;
 
   // Initialization data, read from Settings.
-  bool   doPion, doKaon, doEta;
-  double lambda, QRef;
+  bool   doPion, doKaon, doEta, useQCut;
+  double lambda, QRef, QCut2;
 
   // Table of momentum shifts for different hadron species.
   int    nStep[4], nStep3[4], nStored[10];
@@ -80,6 +80,14 @@ private:
   // Vector of hadrons to study.
   vector<BoseEinsteinHadron> hadronBE;
 
+  // Rapidity, transverse mass and rapidity order of the current species.
+  vector<double> yBE, mTBE;
+  vector<int>    iOrderBE;
+
+  // Shift all pairs of a species, or only those with Q below the cut.
+  void shiftAllPairs(int iBeg, int iEnd, int iTab);
+  void shiftClosePairs(int iBeg, int iEnd, int iTab);
+
   // Calculate shift and (unnormalized) compensation for pair.
   void shiftPair(int i1, int i2, int iHad);
 
@@ -44,7 +44,7 @@ public:
     iAcol(iAcolIn), colReconnection(colReconnectionIn), isJun(isJunIn),
     isAntiJun(isAntiJunIn),isActive(isActiveIn), isReal(isRealIn)
     {leftDip = 0; rightDip = 0; iColLeg = 0; iAcolLeg = 0; printed = false;
-    p1p2 = 0.;}
+    p1p2 = 0.; index = 0; usedStamp[0] = 0; usedStamp[1] = 0;}
 
   double mDip(Event & event) {
     if (isJun || isAntiJun) return 1E9;
@@ -58,6 +58,10 @@ public:
   vector<ColourDipole *> colDips, acolDips;
   double p1p2;
 
+  // Position in the dipole pool, and when last used in a reconnection,
+  // separately for the dipole and junction trial queues.
+  int    index, usedStamp[2];
+
   // Printing function, mainly intended for debugging.
   void list();
 
@@ -106,21 +110,81 @@ public:
 
   TrialReconnection(ColourDipole* dip1In = 0, ColourDipole* dip2In = 0,
     ColourDipole* dip3In = 0, ColourDipole* dip4In = 0, int modeIn = 0,
-    double lambdaDiffIn = 0) {
-    dips.push_back(dip1In); dips.push_back(dip2In);
-    dips.push_back(dip3In); dips.push_back(dip4In);
-    mode = modeIn; lambdaDiff = lambdaDiffIn;
-  }
+    double lambdaDiffIn = 0) : dips{dip1In, dip2In, dip3In, dip4In},
+    mode(modeIn), lambdaDiff(lambdaDiffIn), order() {}
 
   void list() {
     cout << "mode: " << mode << " " << "lambdaDiff: " << lambdaDiff << endl;
-    for (int i = 0;i < int(dips.size()) && dips[i] != 0;++i) {
+    for (int i = 0;i < 4 && dips[i] != 0;++i) {
       cout << "   "; dips[i]->list(); }
   }
 
-  vector<ColourDipole*> dips;
+  // Unused dipoles are null. The order is set when put in a TrialQueue.
+  ColourDipole* dips[4];
   int mode;
   double lambdaDiff;
+  int order;
+
+};
+
+//==========================================================================
+
+// TrialQueue class. Priority queue of trial reconnections, with the
+// largest lambda difference on top, and among equal ones the first
+// stored. Trials containing a dipole that has been used by a later
+// reconnection are not removed right away, but skipped when reached.
+
+//--------------------------------------------------------------------------
+
+class TrialQueue {
+
+public:
+
+  // Constructor. The stamp index separates the queues of a dipole.
+  TrialQueue(int iStampIn = 0) : iStamp(iStampIn), nStored() {}
+
+  // Remove all trials.
+  void clear() {trials.clear(); nStored = 0;}
+
+  // Add a trial reconnection.
+  void push(const TrialReconnection& trial) {trials.push_back(trial);
+    trials.back().order = nStored++;
+    push_heap(trials.begin(), trials.end(), lessThan);}
+
+  // Invalidate all trials containing the dipole stored so far.
+  void setUsed(ColourDipole* dip) {dip->usedStamp[iStamp] = nStored;}
+
+  // Check whether a trial is still valid.
+  bool isValid(const TrialReconnection& trial) const {
+    for (int i = 0; i < 4; ++i) if (trial.dips[i] != 0
+      && trial.dips[i]->usedStamp[iStamp] > trial.order) return false;
+    return true;}
+
+  // Check whether any valid trials remain, removing invalid ones on top.
+  bool empty() {
+    while (!trials.empty() && !isValid(trials.front())) pop();
+    return trials.empty();}
+
+  // The best trial, and removal of it. Only use when not empty().
+  TrialReconnection& top() {return trials.front();}
+  void pop() {pop_heap(trials.begin(), trials.end(), lessThan);
+    trials.pop_back();}
+
+  // Access to all stored trials, valid or not, in no particular order.
+  int size() const {return trials.size();}
+  TrialReconnection& operator[](int i) {return trials[i];}
+
+private:
+
+  // Ordering of trials in the heap.
+  static bool lessThan(const TrialReconnection& t1,
+    const TrialReconnection& t2) {return (t1.lambdaDiff < t2.lambdaDiff)
+    || (t1.lambdaDiff == t2.lambdaDiff && t1.order > t2.order);}
+
+  // Stamp index, trials in heap order, and number stored this event.
+  int iStamp;
+  vector<TrialReconnection> trials;
+  int nStored;
 
 };
 
@@ -151,6 +215,47 @@ public:
 
 //==========================================================================
 
+// RapidityBins class. Keeps track of which objects, e.g. dipoles, span
+// which rapidity ranges, to quickly find those relevant at a rapidity.
+
+//--------------------------------------------------------------------------
+
+class RapidityBins {
+
+public:
+
+  // Constructor.
+  RapidityBins() : yMax(), dyBinInv(), nBin() {}
+
+  // Set up equal bins between -yMax and yMax, and remove all objects.
+  void init(double yMaxIn, int nBinIn);
+
+  // Add or move an object covering a rapidity range, or remove it.
+  void add(int iObj, double yMinObj, double yMaxObj);
+  void remove(int iObj);
+
+  // Objects in the bin of a rapidity. Rapidities outside the range
+  // belong to the edge bins.
+  const vector<int>& objects(double y) const {return bins[bin(y)];}
+
+private:
+
+  // Find bin of a rapidity.
+  int bin(double y) const {
+    if (y <= -yMax) return 0;
+    if (y >= yMax) return nBin - 1;
+    return min( nBin - 1, int((y + yMax) * dyBinInv) );}
+
+  // Bin size, objects in each bin, and bin range of each object.
+  double yMax, dyBinInv;
+  int    nBin;
+  vector<vector<int> > bins;
+  vector<int> binMin, binMax;
+
+};
+
+//==========================================================================
+
 // The ColourReconnection class handles the colour reconnection.
 
 //--------------------------------------------------------------------------
@@ -166,7 +271,8 @@ public:
     pT0(), pT20Rec(), pT0Ref(), ecmRef(), ecmPow(), reconnectRange(), m0(),
     m0sqr(), m2Lambda(), fracGluon(), dLambdaCut(), timeDilationPar(),
     timeDilationParGeV(), tfrag(), blowR(), blowT(), rHadron(), kI(),
-    nColMove() {}
+    junTrials(1), dipTrials(0), nDipolePool(), reuseDipoles(), localSearch(),
+    dyLocal(), nColMove() {}
 
   // Initialization.
   bool init();
@@ -181,8 +287,8 @@ public:
 private:
 
   // Constants: could only be changed in the code itself.
-  static const double MINIMUMGAIN, MINIMUMGAINJUN, TINYP1P2;
-  static const int MAXRECONNECTIONS;
+  static const double MINIMUMGAIN, MINIMUMGAINJUN, TINYP1P2, YMAXLOCAL;
+  static const int MAXRECONNECTIONS, NBINLOCAL;
 
   // Variables needed.
   bool   allowJunctions, sameNeighbourCol, singleReconOnly, lowerLambdaOnly;
@@ -193,10 +299,28 @@ private:
          timeDilationParGeV, tfrag, blowR, blowT, rHadron, kI;
 
   // List of current dipoles.
-  vector<ColourDipole*> dipoles, usedDipoles;
+  vector<ColourDipole*> dipoles, usedDipoles, activeDipoles;
   vector<ColourJunction> junctions;
   vector<ColourParticle> particles;
-  vector<TrialReconnection> junTrials, dipTrials;
+  TrialQueue junTrials, dipTrials;
+
+  // Active dipoles that may form junctions, split into three groups.
+  vector<vector<ColourDipole*> > junCandidates;
+
+  // Pool of dipoles, reused between events if reuseDipoles is on. Only
+  // the first nDipolePool are in use in the current event. Addresses stay
+  // fixed in a deque. Else each dipole is allocated separately.
+  deque<ColourDipole> dipolePool;
+  int  nDipolePool;
+  bool reuseDipoles;
+
+  // Get a new dipole, from the pool or allocated.
+  ColourDipole* newDipole(const ColourDipole& dipIn);
+  ColourDipole* newDipole(int colIn, int iColIn, int iAcolIn,
+    int colReconnectionIn, bool isJunIn = false, bool isAntiJunIn = false,
+    bool isActiveIn = true, bool isRealIn = false) {
+    return newDipole( ColourDipole( colIn, iColIn, iAcolIn,
+    colReconnectionIn, isJunIn, isAntiJunIn, isActiveIn, isRealIn) );}
   vector<vector<int> > iColJun;
   map<int,double> formationTimes;
 
@@ -321,6 +445,9 @@ private:
   // Update the list of dipole trial swaps to account for latest swap.
   void updateJunctionTrials();
 
+  // Split active dipoles that may form junctions into three groups.
+  void findJunctionCandidates();
+
   // Check whether up to four dipoles are 'causally' connected.
   bool checkTimeDilation(ColourDipole* dip1 = 0, ColourDipole* dip2 = 0,
     ColourDipole* dip3 = 0, ColourDipole* dip4 = 0);
@@ -348,6 +475,21 @@ private:
   // The old MPI-based scheme.
   bool reconnectMPIs( Event& event, int oldSize);
 
+  // Optional local search in the MPI-based and gluon-move schemes,
+  // with dipoles or colour lines stored in rapidity bins.
+  bool   localSearch;
+  double dyLocal;
+  RapidityBins localBins;
+  vector<double> yLocalMin, yLocalMax;
+  vector<int> iLocal;
+
+  // Set the rapidity range of a dipole or colour line from its ends.
+  void setLocalRange(int iObj, double y1, double y2);
+
+  // Store in iLocal the dipoles or colour lines to compare with
+  // at a rapidity, either all or the local ones.
+  void selectLocal(double y, int nObj);
+
   // Vectors and methods needed for the new gluon-move model.
 
   // Array of (indices of) all final coloured particles.
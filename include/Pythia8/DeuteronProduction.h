@@ -25,7 +25,8 @@ public:
 
   // Constructor.
   DeuteronProduction() : valid(true), models(), ids(), parms(), masses(),
-    norm(), mPion(), mSafety(), kMin(), kMax(), kTol(), kSteps() {}
+    norm(), mPion(), mSafety(), kMin(), kMax(), kTol(), kSteps(),
+    sigmaMaxs(), kBinScale() {}
 
   // Find settings. Precalculate table used to find momentum shifts.
   bool init();
@@ -44,10 +45,14 @@ private:
   double mSafety;                        // Safety margin for decays.
   double kMin, kMax, kTol;               // Bracketing/tolerance in k for max.
   int kSteps;                            // Number of steps for grid search.
+  vector<vector<double> > sigmaMaxs;     // Cross-section bounds in k bins.
+  double kBinScale;                      // Bins per unit of log(k).
 
   // Constants: could only be changed in the code itself.
   static const int NTRYDECAY;           // Number of times to try a decay.
   static const double WTCORRECTION[11]; // M-generator parameters.
+  static const int NKBIN;               // Number of k bins for bounds.
+  static const double KBINMIN, KBINMAX; // Range of k bins for bounds.
 
   // Bind the nucleon-pair combinations.
   void bind(Event& event, vector<int>& prts);
@@ -61,6 +66,14 @@ private:
   // Return the cross-section for a given channel.
   double sigma(double k, int chn);
 
+  // Upper bound of the fit and of the cross-section in a range.
+  double fitMax(double xLo, double xHi, vector<double>& c, int i);
+  double sigmaMax(double kLo, double kHi, int chn);
+
+  // Bin of k, given k^2, for the cross-section bounds, -1 if outside.
+  int k2Bin(double k2) {return (k2 > KBINMIN*KBINMIN && k2 < KBINMAX*KBINMAX)
+    ? min(NKBIN - 1, int(0.5*kBinScale * log(k2/(KBINMIN*KBINMIN)))) : -1;}
+
   // N-body decay using the M-generator algorithm.
   bool decay(Event& event, int idx0, int idx1, int chn);
 
@@ -6,6 +6,7 @@
 // Header file for the Particle and Event classes.
 // Particle: information on an instance of a particle.
 // Junction: information on a junction between three colours.
+// EventColumns: the main particle properties of an event, stored by column.
 // Event: list of particles in the current event.
 
 #ifndef Pythia8_Event_H
@@ -374,6 +375,50 @@ private:
 
 //==========================================================================
 
+// The EventColumns class stores the most used properties of the particles
+// of an event as one contiguous array for each property. Loops that only
+// need a few of them then run over compact memory, rather than over the
+// full Particle objects, and are easier for the compiler to vectorize.
+// It is filled by Event::toColumns, and is not updated automatically.
+
+class EventColumns {
+
+public:
+
+  // Constructor.
+  EventColumns() : nSave(0) {}
+
+  // Number of particles, as in the event it was filled from.
+  int size() const {return nSave;}
+
+  // Set the number of particles. The memory is kept when shrinking, so
+  // refilling for each new event does not allocate once the largest
+  // event has been seen.
+  void resize(int sizeIn);
+
+  // Final state or not, as Particle::isFinal().
+  bool isFinal(int i) const {return status[i] > 0;}
+
+  // Identity, status and history, as in the Particle class.
+  vector<int>    id, status, mother1, mother2, daughter1, daughter2;
+
+  // Four-momentum and mass.
+  vector<double> px, py, pz, e, m;
+
+  // Charge and visibility, as Particle::isCharged(), isNeutral() and
+  // isVisible(); a particle without particle data is neither charged nor
+  // neutral.
+  vector<char>   isCharged, isNeutral, isVisible;
+
+private:
+
+  // Number of particles.
+  int nSave;
+
+};
+
+//==========================================================================
+
 // The Event class holds all info on the generated event.
 
 class Event {
@@ -480,6 +525,9 @@ public:
   void list(bool showScaleAndVertex = false,
     bool showMothersAndDaughters = false, int precision = 3) const;
 
+  // Copy the main particle properties into columns, e.g. for analysis.
+  void toColumns(EventColumns& columns) const;
+
   // Remove last n entries.
   void popBack(int nRemove = 1) { if (nRemove ==1) entry.pop_back();
     else {int newSize = max( 0, size() - nRemove);
@@ -156,8 +156,8 @@ public:
     return combine(flav1, flav2); }
 
   // Return hadron mass. Used one if present, pick otherwise.
-  virtual double getHadronMassWin(int idHad) { return
-    ((hadronMassWin < 0.0) ? particleDataPtr->mSel(idHad) : hadronMassWin); }
+  virtual double getHadronMassWin(int idHad) { return ((hadronMassWin < 0.0)
+    ? particleDataPtr->mSel(idHad, rndmPtr) : hadronMassWin); }
 
   // Assign popcorn quark inside an original (= rank 0) diquark.
   void assignPopQ(FlavContainer& flav);
@@ -221,10 +221,29 @@ protected:
   map< pair<int,int>, vector< pair<int,int> > > possibleHadronsLast;
   map< pair<int,int>, vector<double> > possibleRatePrefacsLast;
 
+  // Flat copies of the lists above, for sampling without allocations.
+  // The candidates of each list are stored contiguously, with the index
+  // range [first, second) given by the maps. For each candidate the
+  // hadron id, the rate prefactor and, for possibleHadrons, the id of
+  // the (di)quark to use next time are stored.
+  map< int, pair<int,int> > thermalRange;
+  map< pair<int,int>, pair<int,int> > thermalRangeLast;
+  vector<int>    thermalIDs, thermalIDsNext;
+  vector<double> thermalPrefacs;
+  // Work arrays for the masses and rates of the current candidates.
+  vector<double> thermalMasses, thermalRates;
+
   // Selection in thermal model.
   int    hadronIDwin, idNewWin;
   double hadronMassWin;
 
+  // Fill the flat lists of possible hadrons for the thermal model.
+  void initThermalTables();
+
+  // Pick one of the thermal candidates in a range, return its index.
+  int pickThermalIndex(int iBeg, int iEnd, double pT, double temprNow,
+    double sigmaNow, double& massPicked);
+
 };
 
 //==========================================================================
@@ -240,7 +259,8 @@ public:
     usePetersonB(), usePetersonH(), mc2(), mb2(), aLund(), bLund(),
     aExtraSQuark(), aExtraDiquark(), rFactC(), rFactB(), rFactH(), aNonC(),
     aNonB(), aNonH(), bNonC(), bNonB(), bNonH(), epsilonC(), epsilonB(),
-    epsilonH(), stopM(), stopNF(), stopS() {}
+    epsilonH(), stopM(), stopNF(), stopS(), useLundTable(false),
+    dLogBTable() {}
 
   // Destructor.
   virtual ~StringZ() {}
@@ -266,7 +286,9 @@ public:
 protected:
 
   // Constants: could only be changed in the code itself.
-  static const double CFROMUNITY, AFROMZERO, AFROMC, EXPMAX;
+  static const double CFROMUNITY, AFROMZERO, AFROMC, EXPMAX, BTABLEMIN,
+                      BTABLEMAX, ZTABLEMIN;
+  static const int    NCLASSLUND, NBTABLE, NUTABLE, NZINTEGRAL;
 
   // Initialization data, to be read from Settings.
   bool   useNonStandC, useNonStandB, useNonStandH,
@@ -279,6 +301,22 @@ protected:
   double zLund( double a, double b, double c = 1.);
   double zPeterson( double epsilon);
 
+  // Shape parameters a, c and b/mT2 of the Lund function for light, c
+  // and b fragmentation, classified by the old and new flavour kinds.
+  vector<double> aClass, cClass, bClass;
+
+  // Optional tables of ln(z) as a function of the cumulative fraction
+  // of the Lund function, for a grid in b, built for each flavour class
+  // when first needed. The a and c values used are stored with them.
+  bool   useLundTable;
+  double dLogBTable;
+  vector< vector<double> > lundTable;
+  vector<double> aTable, cTable;
+
+  // Build the table of a flavour class and select z from it.
+  void initLundTable( int iClass);
+  double zLundTable( int iClass, double b);
+
 };
 
 //==========================================================================
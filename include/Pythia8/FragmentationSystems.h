@@ -102,6 +102,13 @@ public:
   // Only used when stringPT:closePacking is on.
   vector< vector< pair<double,double> > > rapPairs;
 
+  // Store the rapidity ranges, and sort their ends for fast lookup.
+  void setRapPairs(const vector< vector< pair<double,double> > >&
+    rapPairsIn);
+
+  // Number of string pieces with a rapidity range around y.
+  int nRapPairs(double y) const;
+
 private:
 
   // Constants: could only be changed in the code itself.
@@ -119,6 +126,9 @@ private:
   // List of all separate colour singlets.
   vector<ColSinglet> singlets;
 
+  // Lower and upper ends of the non-empty rapidity ranges, each sorted.
+  vector<double> yMinSorted, yMaxSorted;
+
   // Join two legs of junction to a diquark for small invariant masses.
   bool joinJunction( vector<int>& iPartonIn, Event& event,
     double massExcessIn);
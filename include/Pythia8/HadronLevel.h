@@ -63,6 +63,15 @@ public:
   // Special routine to allow more decays if on/off switches changed.
   bool moreDecays(Event& event);
 
+  // Lazy decays: check whether the decay of a particle is pending, and
+  // decay a particle, or all selected ones, together with their products.
+  bool isDecayPending(int i, const Event& event) const {
+    return i >= 0 && i < int(seedLazy.size()) && seedLazy[i] > 0
+      && event[i].isFinal() && event[i].canDecay() && event[i].mayDecay();}
+  bool decayPending(int i, Event& event);
+  bool decayPendingIf(function<bool(const Particle&)> select,
+    Event& event);
+
   // Prepare and pick process for a low-energy hadron-hadron scattering.
   bool initLowEnergyProcesses();
   int pickLowEnergyProcess(int idA, int idB, double eCM, double mA, double mB);
@@ -94,6 +103,7 @@ protected:
     registerSubObject(pTSel);
     registerSubObject(zSel);
     registerSubObject(stringFrag);
+    registerSubObject(parallelFrag);
     registerSubObject(ministringFrag);
     registerSubObject(decays);
     registerSubObject(lowEnergyProcess);
@@ -112,7 +122,8 @@ private:
 
   // Initialization data, read from Settings.
   bool doHadronize{}, doDecay{}, doPartonVertex{}, doBoseEinstein{},
-    doDeuteronProd{}, allowRH{}, closePacking{}, doNonPertAll{};
+    doDeuteronProd{}, allowRH{}, closePacking{}, doNonPertAll{},
+    doLazyDecays{};
   double mStringMin{}, eNormJunction{}, widthSepBE{}, widthSepRescatter{};
   vector<int> nonPertProc{};
 
@@ -127,6 +138,17 @@ private:
   // The generator class for normal string fragmentation.
   StringFragmentation stringFrag;
 
+  // Optional concurrent string fragmentation of independent systems.
+  ParallelStringFragmentation parallelFrag;
+  bool doParallelFrag{};
+  bool fragmentParallel(Event& event);
+
+  // Fragment the colour singlet systems of the event.
+  bool fragmentSinglets(Event& event);
+
+  // Random-number seeds of particles with pending lazy decays, else 0.
+  vector<int> seedLazy{};
+
   // The generator class for special low-mass string fragmentation.
   MiniStringFragmentation ministringFrag;
 
@@ -164,6 +186,9 @@ private:
   // Option to keep junctions, needed for rope hadronization.
   bool findSinglets(Event& event, bool keepJunctions = false);
 
+  // Lazy decays: decay a particle with its own stream, and its products.
+  bool decayLazy(int i, Event& event);
+
   // Class to displace hadron vertices from parton impact-parameter picture.
   PartonVertexPtr partonVertexPtr;
 
@@ -101,17 +101,20 @@ protected:
 
 private:
 
+  // Tabulate the matrix element for all helicity combinations.
+  void tabulateME(vector<HelicityParticle>&);
+
   // Recursive sub-method to calculate the density matrix for a particle.
   void calculateRho(unsigned int, vector<HelicityParticle>&,
-    vector<int>&, vector<int>&, unsigned int);
+    vector<int>&, vector<int>&, unsigned int, int, int);
 
   // Recursive sub-method to calculate the decay matrix for a particle.
   void calculateD(vector<HelicityParticle>&, vector<int>&, vector<int>&,
-    unsigned int);
+    unsigned int, int, int);
 
   // Recursive sub-method to calculate the matrix element weight for a decay.
   void decayWeight(vector<HelicityParticle>&, vector<int>&, vector<int>&,
-    complex&, unsigned int);
+    complex&, unsigned int, int, int);
 
   // Calculate the product of the decay matrices for a hard process.
   complex calculateProductD(unsigned int, unsigned int,
@@ -121,6 +124,14 @@ private:
   complex calculateProductD(vector<HelicityParticle>&,
     vector<int>&, vector<int>&);
 
+  // Number of spin states of each particle, and helicity vectors, kept
+  // between calls to avoid allocations.
+  vector<int> nSpin, h1Now, h2Now;
+
+  // The matrix element for each helicity combination, with the helicity
+  // of the last particle running fastest.
+  vector<complex> meTable;
+
 };
 
 //==========================================================================
@@ -28,6 +28,7 @@ class BeamParticle;
 class PartonSystems;
 class SigmaTotal;
 class HadronWidths;
+class InitCache;
 
 // Forward declaration of HIInfo class.
 class HIInfo;
@@ -115,6 +116,9 @@ public:
   // Pointer to the UserHooks object set for the run.
   UserHooksPtr   userHooksPtr{};
 
+  // Pointer to the cache of initialization tables.
+  InitCache*     initCachePtr{};
+
   // Pointer to information about a HeavyIons run and the current event.
   // (Is NULL if HeavyIons object is inactive.)
   HIInfo*        hiInfo{};
@@ -281,7 +285,7 @@ public:
   int    iBMPI(int i)         const {return iBMPISave[i];}
 
   // Cross section estimate, optionally process by process.
-  vector<int> codesHard();
+  vector<int> codesHard() const;
   string nameProc(int i = 0)  const {return (i == 0) ? "sum"
     : ( (procNameM.at(i) == "") ? "unknown process" : procNameM.at(i) );}
   long   nTried(int i = 0)    const {return (i == 0) ? nTry : nTryM.at(i);}
@@ -297,9 +301,23 @@ public:
   void   setCounter( int i, int value = 0) {counters[i]  = value;}
   void   addCounter( int i, int value = 1) {counters[i] += value;}
 
+  // Numbers of hits, misses and evictions in the optional PDF caches,
+  // summed over all PDF objects of the run, and how to update them.
+  long   nPDFCacheHit()   const {return nPDFCacheSave[0];}
+  long   nPDFCacheMiss()  const {return nPDFCacheSave[1];}
+  long   nPDFCacheEvict() const {return nPDFCacheSave[2];}
+  void   addPDFCacheCount( int i) {++nPDFCacheSave[i];}
+  void   resetPDFCacheCounts() {
+    nPDFCacheSave[0] = nPDFCacheSave[1] = nPDFCacheSave[2] = 0;}
+
   // Reset to empty map of error messages.
   void   errorReset() {messages.clear();}
 
+  // Add the error messages of another Info object, e.g. a parallel one.
+  void   errorCombine(const Info& other) {
+    for (const pair<const string, int>& messageEntry : other.messages)
+      messages[messageEntry.first] += messageEntry.second;}
+
   // Print a message the first few times. Insert in database.
   void   errorMsg(string messageIn, string extraIn = " ",
     bool showAlways = false);
@@ -546,6 +564,9 @@ public:
   // Vector of various loop counters.
   int    counters[50];
 
+  // Hits, misses and evictions in the PDF caches.
+  long   nPDFCacheSave[3] = {};
+
   // Map for all error messages.
   map<string, int> messages;
 
@@ -0,0 +1,113 @@
+// InitCache.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains the class that stores results of time-consuming
+// initialization steps on file, so that they can be reused by later runs.
+// InitCache: read and write initialization tables, keyed by configuration.
+
+#ifndef Pythia8_InitCache_H
+#define Pythia8_InitCache_H
+
+#include "Pythia8/Basics.h"
+#include "Pythia8/Info.h"
+#include "Pythia8/ParticleData.h"
+#include "Pythia8/PythiaStdlib.h"
+#include "Pythia8/Settings.h"
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The InitCache class keeps tables of numbers, e.g. the MPI Sudakov
+// tables or the phase-space maxima of processes, in a file. Each table
+// is identified by a key, a hash of all settings and particle data that
+// could affect it, and a tag, which gives the kind and order of the table.
+// Tables are calculated with random numbers from a separate stream for
+// each tag, so that they do not depend on the seed of the run.
+
+class InitCache {
+
+public:
+
+  // Constructor.
+  InitCache() : isActive(false), hasNew(false), isOnStream(false),
+    infoPtr(), rndmPtr(), nKeysMax(), nLoadedSave(0), nStoredSave(0) {}
+
+  // Prepare for a new initialization. Reads the cache file, if any,
+  // and finds the key of the current settings and particle data.
+  bool init(Info* infoPtrIn, bool canUse = true);
+
+  // Check whether tables can be read and stored.
+  bool isOn() const {return isActive;}
+
+  // Unique tag of the next table of a given kind in this initialization.
+  string tag(string kind);
+
+  // Retrieve a table.
+  bool get(string tagIn, vector<double>& values);
+
+  // Switch the random number generator to the stream of the tag, to
+  // calculate a table with, until set() or endTable() is called.
+  void startTable(string tagIn);
+
+  // Store a calculated table, and switch back to the normal random numbers.
+  void set(string tagIn, const vector<double>& values);
+
+  // Switch back to the normal random numbers without storing a table.
+  void endTable();
+
+  // Write all new tables to the cache file. Only the tables of the
+  // latest few keys written are kept.
+  bool write();
+
+  // Number of tables read from and stored to the cache in the last init.
+  int nLoaded() const {return nLoadedSave;}
+  int nStored() const {return nStoredSave;}
+
+private:
+
+  // Constants: could only be changed in the code itself.
+  static const string HEADER;
+
+  // Settings groups that do not affect initialization tables.
+  static const int    NIGNORE;
+  static const string IGNOREPREFIX[8];
+
+  // Lock while writing a cache file.
+  static mutex fileMutex;
+
+  // Status and pointers.
+  bool   isActive, hasNew, isOnStream;
+  Info*  infoPtr;
+  Rndm*  rndmPtr;
+
+  // State of the normal random numbers while a table is calculated.
+  Rndm   rndmSave;
+
+  // Cache file name, current key and maximum number of keys in the file.
+  string fileName, keyNow;
+  int    nKeysMax;
+
+  // Tables of the current key, tags of new ones, and number of each kind.
+  map<string, vector<double> > tables;
+  vector<string> newTags;
+  map<string, int> nTags;
+
+  // Statistics.
+  int    nLoadedSave, nStoredSave;
+
+  // Find the key of the current configuration.
+  string findKey();
+
+  // Read all tables of the current key from the file.
+  void readFile();
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_InitCache_H
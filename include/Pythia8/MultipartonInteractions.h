@@ -14,6 +14,7 @@
 #include "Pythia8/BeamParticle.h"
 #include "Pythia8/Event.h"
 #include "Pythia8/Info.h"
+#include "Pythia8/InitCache.h"
 #include "Pythia8/PartonSystems.h"
 #include "Pythia8/PartonVertex.h"
 #include "Pythia8/PhysicsBase.h"
@@ -306,6 +307,10 @@ private:
   // Integrate the parton-parton interaction cross section.
   void jetCrossSection();
 
+  // Save or restore the results of the pT0 search to or from the cache.
+  vector<double> cacheTable(double pT4dSigmaMaxBeg);
+  bool useCacheTable(const vector<double>& table, double& pT4dSigmaMaxBeg);
+
   // Evaluate "Sudakov form factor" for not having a harder interaction.
   double sudakov(double pT2sud, double enhance = 1.);
 
@@ -58,6 +58,7 @@ public:
 
   // Assignment operator.
   DecayChannel& operator=( const DecayChannel& oldDC) { if (this != &oldDC) {
+    ++nChangesSave;
     onModeSave = oldDC.onModeSave; bRatioSave = oldDC.bRatioSave;
     currentBRSave = oldDC.currentBRSave;
     onShellWidthSave = oldDC.onShellWidthSave; openSecPos = oldDC.openSecPos;
@@ -66,10 +67,13 @@ public:
     hasChangedSave = oldDC.hasChangedSave; } return *this; }
 
   // Member functions for input.
-  void onMode(int onModeIn) {onModeSave = onModeIn; hasChangedSave = true;}
+  void onMode(int onModeIn) {onModeSave = onModeIn; hasChangedSave = true;
+    ++nChangesSave;}
   void bRatio(double bRatioIn, bool countAsChanged = true) {
-    bRatioSave = bRatioIn; if (countAsChanged) hasChangedSave = true;}
-  void rescaleBR(double fac) {bRatioSave *= fac; hasChangedSave = true;}
+    bRatioSave = bRatioIn; if (countAsChanged) hasChangedSave = true;
+    ++nChangesSave;}
+  void rescaleBR(double fac) {bRatioSave *= fac; hasChangedSave = true;
+    ++nChangesSave;}
   void meMode(int meModeIn) {meModeSave = meModeIn; hasChangedSave = true;}
   void multiplicity(int multIn)  {nProd = multIn; hasChangedSave = true;}
   void product(int i, int prodIn) {prod[i] = prodIn; nProd = 0;
@@ -90,6 +94,11 @@ public:
   bool   contains(int id1, int id2) const;
   bool   contains(int id1, int id2, int id3) const;
 
+  // Number of changes of branching ratios or on/off switches in any
+  // decay table so far, to tell when cached selection tables are outdated.
+  static long nChanges() {return nChangesSave;}
+  static void countChange() {++nChangesSave;}
+
   // Input/output for current selection of decay modes.
   // Takes into account on/off switches and dynamic width for resonances.
   void   currentBR(double currentBRIn) {currentBRSave = currentBRIn;}
@@ -116,6 +125,9 @@ private:
   int    meModeSave, nProd, prod[8];
   bool   hasChangedSave;
 
+  // Counter of changes, common to all decay channels.
+  static atomic<long> nChangesSave;
+
 };
 
 //==========================================================================
@@ -202,7 +214,8 @@ public:
     for (int i = 0; i < int(oldPDE.channels.size()); ++i) {
       DecayChannel oldDC = oldPDE.channels[i]; channels.push_back(oldDC); }
     currentBRSum = oldPDE.currentBRSum; resonancePtr = 0;
-    particleDataPtr = 0; } return *this; }
+    particleDataPtr = 0; pickChanges[0] = pickChanges[1] = -1; iPickNow = -1;
+    } return *this; }
 
   // Destructor: delete any ResonanceWidths object.
   ~ParticleDataEntry();
@@ -312,7 +325,7 @@ public:
   // Set and give back several mass-related quantities.
   void   initBWmass();
   double constituentMass()        const { return constituentMassSave; }
-  double mSel()                   const;
+  double mSel(Rndm* rndmPtrIn = nullptr) const;
   double mRun(double mH)          const;
 
   // Give back other quantities.
@@ -340,14 +353,15 @@ public:
   int    nQuarksInCode(int idQIn)       const;
 
   // Reset to empty decay table.
-  void clearChannels() {channels.resize(0);}
+  void clearChannels() {channels.resize(0); DecayChannel::countChange();}
 
   // Add a decay channel to the decay table.
   void addChannel(int onMode = 0, double bRatio = 0., int meMode = 0,
     int prod0 = 0, int prod1 = 0, int prod2 = 0, int prod3 = 0,
     int prod4 = 0, int prod5 = 0, int prod6 = 0, int prod7 = 0) {
     channels.push_back( DecayChannel( onMode, bRatio, meMode, prod0,
-    prod1, prod2, prod3, prod4, prod5, prod6, prod7) ); }
+    prod1, prod2, prod3, prod4, prod5, prod6, prod7) );
+    DecayChannel::countChange(); }
 
   // Decay table size.
   int sizeChannels() const {return channels.size();}
@@ -380,7 +394,7 @@ private:
   // Constants: could only be changed in the code itself.
   static const int    INVISIBLENUMBER, INVISIBLETABLE[80], KNOWNNOWIDTH[3];
   static const double MAXTAU0FORDECAY,MINMASSRESONANCE, NARROWMASS,
-                      CONSTITUENTMASSTABLE[10];
+                      CONSTITUENTMASSTABLE[10], MAXROUNDING;
 
   // Particle data.
   int    idSave;
@@ -402,6 +416,13 @@ private:
   // Summed branching ratio of currently open channels.
   double currentBRSum;
 
+  // Branching ratios of open channels and their running sums, for particle
+  // and antiparticle, with the count of channel changes when filled, and
+  // the table used in the current pick, if any. Not for resonances.
+  vector<double> pickBR[2], pickSum[2];
+  long pickChanges[2] = {-1, -1};
+  int  iPickNow = -1;
+
   // Pointer to ResonanceWidths object; only used for some particles.
   ResonanceWidths* resonancePtr;
 
@@ -436,7 +457,8 @@ public:
     for ( map<int, ParticleDataEntry>::const_iterator pde = oldPD.pdt.begin();
       pde != oldPD.pdt.end(); pde++) { int idTmp = pde->first;
       pdt[idTmp] = pde->second; pdt[idTmp].initPtr(this); }
-    particlePtr = 0; isInit = oldPD.isInit;
+    indexParticles();
+    particlePtr = 0; isInit = oldPD.isInit; xmlFileSav = oldPD.xmlFileSav;
     readingFailedSave = oldPD.readingFailedSave; }
 
   // Assignment operator.
@@ -448,7 +470,8 @@ public:
     for ( map<int, ParticleDataEntry>::const_iterator pde = oldPD.pdt.begin();
       pde != oldPD.pdt.end(); pde++) { int idTmp = pde->first;
       pdt[idTmp] = pde->second; pdt[idTmp].initPtr(this); }
-    particlePtr = 0; isInit = oldPD.isInit;
+    indexParticles();
+    particlePtr = 0; isInit = oldPD.isInit; xmlFileSav = oldPD.xmlFileSav;
     readingFailedSave = oldPD.readingFailedSave; } return *this; }
 
   // Initialize pointers.
@@ -478,6 +501,7 @@ public:
   bool readXML(string inFile, bool reset = true) ;
   void listXML(string outFile);
   bool readXML(istream& is, bool reset=true);
+  void listXML(ostream& os);
 
   // Copy and process XML information from another particleData object.
   bool copyXML(const ParticleData &particleDataIn);
@@ -530,7 +554,7 @@ public:
     double tau0In = 0., bool varWidthIn = false) {
     pdt[abs(idIn)] = ParticleDataEntry(idIn, nameIn, spinTypeIn, chargeTypeIn,
       colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In, varWidthIn);
-    pdt[abs(idIn)].initPtr(this); }
+    pdt[abs(idIn)].initPtr(this); indexParticle(abs(idIn)); }
   void addParticle(int idIn, string nameIn, string antiNameIn,
     int spinTypeIn = 0, int chargeTypeIn = 0, int colTypeIn = 0,
     double m0In = 0., double mWidthIn = 0., double mMinIn = 0.,
@@ -538,7 +562,7 @@ public:
     pdt[abs(idIn)] = ParticleDataEntry(idIn, nameIn, antiNameIn, spinTypeIn,
       chargeTypeIn, colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In,
       varWidthIn);
-    pdt[abs(idIn)].initPtr(this); }
+    pdt[abs(idIn)].initPtr(this); indexParticle(abs(idIn)); }
 
   // Reset all the properties of an entry in one go.
   void setAll(int idIn, string nameIn, string antiNameIn,
@@ -550,26 +574,19 @@ public:
     colTypeIn, m0In, mWidthIn, mMinIn, mMaxIn, tau0In, varWidthIn); }
 
   // Query existence of an entry.
-  bool isParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if ( found == pdt.end() ) return false;
-    if ( idIn > 0 || found->second.hasAnti() ) return true;
-    return false;
-  }
+  bool isParticle(int idIn) const { return findParticle(idIn) != nullptr; }
 
-  // Query existence of an entry and return an iterator.
+  // Query existence of an entry and return a pointer to it.
   ParticleDataEntry* findParticle(int idIn) {
-    map<int,ParticleDataEntry>::iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return nullptr;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    ParticleDataEntry* ptr = findEntry( abs(idIn) );
+    if ( ptr && (idIn > 0 || ptr->hasAnti()) ) return ptr;
     return nullptr;
   }
 
-  // Query existence of an entry and return a const iterator.
+  // Query existence of an entry and return a const pointer to it.
   const ParticleDataEntry* findParticle(int idIn) const {
-    map<int,ParticleDataEntry>::const_iterator found = pdt.find( abs(idIn) );
-    if( found == pdt.end() ) return nullptr;
-    if ( idIn > 0 || found->second.hasAnti() ) return &((*found).second);
+    const ParticleDataEntry* ptr = findEntry( abs(idIn) );
+    if ( ptr && (idIn > 0 || ptr->hasAnti()) ) return ptr;
     return nullptr;
   }
 
@@ -721,9 +738,9 @@ public:
   double constituentMass(int idIn) const {
     const ParticleDataEntry* ptr = findParticle(idIn);
     return ( ptr ) ? ptr->constituentMass() : 0. ; }
-  double mSel(int idIn) const {
+  double mSel(int idIn, Rndm* rndmPtrIn = nullptr) const {
     const ParticleDataEntry* ptr = findParticle(idIn);
-    return ( ptr ) ? ptr->mSel() : 0. ; }
+    return ( ptr ) ? ptr->mSel(rndmPtrIn) : 0. ; }
   double mRun(int idIn, double mH) const {
     const ParticleDataEntry* ptr = findParticle(idIn);
     return ( ptr ) ? ptr->mRun(mH) : 0. ; }
@@ -837,6 +854,36 @@ private:
   // All particle data stored in a map.
   map<int, ParticleDataEntry> pdt;
 
+  // Fast lookup of entries in the map, which never move once stored.
+  // Codes below IDDENSE are indexed directly, higher ones, e.g. for SUSY
+  // and Hidden Valley states, by a binary search in a sorted vector.
+  static const int IDDENSE;
+  vector<ParticleDataEntry*> pdtDense, pdtSparse;
+  vector<int> idSparse;
+
+  // Find the entry for a given positive code, or null pointer if none.
+  // The binary search is written without branches in the loop.
+  ParticleDataEntry* findEntry(int idAbs) const {
+    if (idAbs < int(pdtDense.size())) return (idAbs >= 0) ? pdtDense[idAbs]
+      : nullptr;
+    int nSparse = int(idSparse.size());
+    if (nSparse == 0) return nullptr;
+    const int* idPtr = idSparse.data();
+    while (nSparse > 1) {
+      int nHalf = nSparse / 2;
+      idPtr    += (idPtr[nHalf] <= idAbs) ? nHalf : 0;
+      nSparse  -= nHalf;
+    }
+    return (*idPtr == idAbs) ? pdtSparse[idPtr - idSparse.data()] : nullptr;
+  }
+
+  // Update the fast lookup for one code, or rebuild it for the whole map.
+  void indexParticle(int idAbs);
+  void indexParticles();
+
+  // Remove an entry from the map and from the fast lookup.
+  void eraseParticle(int idIn) {pdt.erase(idIn); indexParticle(idIn);}
+
   // Pointer to current particle (e.g. when reading decay channels).
   ParticleDataEntry* particlePtr;
 
@@ -858,7 +905,13 @@ private:
   double doubleAttributeValue(string line, string attribute);
 
   // Vector of strings containing the readable lines of the XML file.
-  vector<string> xmlFileSav;
+  // It is never changed once read, and so can be shared between copies.
+  shared_ptr<const vector<string> > xmlFileSav;
+
+  // Databases already read from file, keyed by file name, so that
+  // several Pythia instances need only parse the XML file once.
+  static map<string, shared_ptr<const ParticleData> > xmlCache;
+  static mutex xmlCacheMutex;
 
   // Stored history of readString statements (common and by subrun).
   vector<string> readStringHistory;
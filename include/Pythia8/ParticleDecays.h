@@ -78,6 +78,12 @@ public:
   // Did decay result in new partons to hadronize?
   bool moreToDo() const {return hasPartons && keepPartons;}
 
+  // Partner a tau may be decayed together with by the tau decay package.
+  // The particle itself if there is none.
+  int tauPartner(int iDec, const Event& event) const {
+    return (tauMode && event[iDec].idAbs() == 15)
+      ? tauDecayer.partner( iDec, event) : iDec;}
+
 protected:
 
   virtual void onInitInfoPtr() override {
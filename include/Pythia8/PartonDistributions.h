@@ -6,6 +6,7 @@
 // Header files for parton densities.
 // PDF:           base class.
 // LHAPDF:        interface to the LHAPDF library.
+// LHAGrid1Data:  data of an LHAPDF6 lhagrid1 file, for sharing.
 // LHAGrid1:      internal read and use files in the LHAPDF6 lhagrid1 format.
 // GRV94L:        GRV 94L parton densities.
 // CTEQ5L:        CTEQ 5L parton densities.
@@ -74,6 +75,10 @@ public:
   // Allow extrapolation beyond boundaries. This is optional.
   virtual void setExtrapolate(bool) {}
 
+  // Switch on an optional cache of the PDF values at recent (x, Q2)
+  // points, with the number of entries and the relative tolerance.
+  void initCache(int nCacheIn, double tolCacheIn = 0., Info* infoPtrIn = 0);
+
   // Read out parton density.
   virtual double xf(int id, double x, double Q2);
 
@@ -171,12 +176,45 @@ protected:
   // Update parton densities.
   virtual void xfUpdate(int id, double x, double Q2) = 0;
 
+  // Update parton densities if flavour, x or Q2 changed, possibly taken
+  // from the cache.
+  void xfUpdateIfNew(int id, double x, double Q2) {
+    if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav) {
+      if (cache.size() > 0) xfUpdateCached(id, x, Q2);
+      else {idSav = id; xfUpdate(id, x, Q2);}
+      xSav = x; Q2Sav = Q2;
+    }
+  }
+
   // Small routine for error printout, depending on infoPtr existing or not.
   void printErr(string errMsg, Info* infoPtr = 0) {
     if (infoPtr !=0) infoPtr->errorMsg(errMsg);
     else cout << errMsg << endl;
   }
 
+private:
+
+  // Number of PDF values stored in a cache entry.
+  static const int NCACHEVAL = 21;
+
+  // An entry of the cache: the keys of the quantized x and Q2 values,
+  // the flavours updated, and the PDF values.
+  struct CacheEntry {
+    unsigned long long keyX = 0, keyQ2 = 0;
+    int    idSav = 0;
+    bool   isUsed = false;
+    double val[NCACHEVAL];
+  };
+
+  // The direct-mapped cache, the inverse tolerance of the quantization,
+  // zero for exact keys, and the Info object keeping count of the use.
+  vector<CacheEntry> cache;
+  double tolCacheInv{};
+  Info*  cacheInfoPtr{};
+
+  // Update parton densities via the cache.
+  void xfUpdateCached(int id, double x, double Q2);
+
 };
 
 //==========================================================================
@@ -263,8 +301,53 @@ private:
 
 //==========================================================================
 
+// Grid data read in from a file in the LHAPDF6 lhagrid1 format. It is not
+// changed after initialization, and can therefore be shared by several
+// LHAGrid1 objects reading the same file, e.g. in parallel Pythia runs.
+
+class LHAGrid1Data {
+
+public:
+
+  // Constructor.
+  LHAGrid1Data() : nx(), nq(), nqSub(), xMin(), xMax(), qMin(), qMax(),
+    lnxBinInv(), lnqBinInv(), pdfData() {}
+
+  // Grid values for flavour iid at (ix, iq).
+  double grid(int iid, int iq, int ix) const {
+    return pdfData[(iq * nx + ix) * 12 + iid];}
+
+  // Data members. The pdfGrid value for flavour iid at (ix, iq) is stored
+  // at index (iq * nx + ix) * 12 + iid, the pdfSlope one at iq * 12 + iid,
+  // i.e. with the twelve flavours next to each other.
+  int    nx, nq, nqSub;
+  vector<int> nqSum;
+  double xMin, xMax, qMin, qMax;
+  vector<double> xGrid, lnxGrid, qGrid, lnqGrid, qDiv, pdfGrid, pdfSlope;
+
+  // Denominators lnxGrid[m3 + i] - lnxGrid[m3 + j] of the weights for cubic
+  // interpolation from knot m3 onwards, at index (m3 * 4 + i) * 4 + j.
+  // Correspondingly for ln(q).
+  vector<double> lnxDen, lnqDen;
+
+  // Knots to start from when searching for the ones around a point: for
+  // bins of equal size in ln(x), from lnxGrid[0] on, the last knot at or
+  // below the lower bin edge. Correspondingly for ln(q).
+  double lnxBinInv, lnqBinInv;
+  vector<int> ixBin, iqBin;
+
+  // The pdfGrid values actually used: either those in pdfGrid, or those
+  // of a memory-mapped binary file, which is then kept mapped by mapPtr.
+  const double* pdfData;
+  shared_ptr<const char> mapPtr;
+
+};
+
+//==========================================================================
+
 // The LHAGrid1 can be used to read files in the LHAPDF6 lhagrid1 format,
-// assuming that the same x grid is used for all Q subgrids.
+// assuming that the same x grid is used for all Q subgrids. Such files
+// can be converted to a binary format, which is mapped into memory.
 // Results are not identical with LHAPDF6, owing to different interpolation.
 
 class LHAGrid1 : public PDF {
@@ -274,36 +357,69 @@ public:
   // Constructor.
   LHAGrid1(int idBeamIn = 2212, string pdfWord = "void",
     string xmlPath = "../share/Pythia8/xmldoc/", Info* infoPtr = 0)
-    : PDF(idBeamIn), doExtraPol(false), nx(), nq(), nqSub(), xMin(), xMax(),
-    qMin(), qMax(), pdfVal(), pdfGrid(), pdfSlope(NULL) {
-    init( pdfWord, xmlPath, infoPtr); };
+    : PDF(idBeamIn), doExtraPol(false), pdfVal(), errorType(0),
+    gridPtr() { init( pdfWord, xmlPath, infoPtr); };
 
   // Constructor with a stream.
   LHAGrid1(int idBeamIn, istream& is, Info* infoPtr = 0)
-    : PDF(idBeamIn), doExtraPol(false), nx(), nq(), nqSub(), xMin(), xMax(),
-    qMin(), qMax(), pdfVal(), pdfGrid(), pdfSlope(NULL) {
-    init( is, infoPtr); };
-
-  // Destructor.
-  ~LHAGrid1() { for (int iid = 0; iid < 12; ++iid) {
-    for (int iq = 0; iq < nq; ++iq) delete[] pdfGrid[iid][iq];
-    delete[] pdfGrid[iid]; }
-    if (pdfSlope) { for (int iid = 0; iid < 12; ++iid) delete[] pdfSlope[iid];
-    delete[] pdfSlope;} };
+    : PDF(idBeamIn), doExtraPol(false), pdfVal(), errorType(0),
+    gridPtr() { init( is, infoPtr); };
 
   // Allow extrapolation beyond boundaries. This is optional.
   void setExtrapolate(bool doExtraPolIn) {doExtraPol = doExtraPolIn;}
 
+  // Evaluate all flavours at the n points (x[i], Q2[i]) in one go. For
+  // each point the twelve x*f(x, Q2) grid values are stored from out[12*i]
+  // on, in the order g, d, u, s, c, b, dbar, ubar, sbar, cbar, bbar, gamma.
+  void xfxBatch(const double* x, const double* Q2, size_t n,
+    double* out) const;
+
+  // Convert a grid file to the binary format, which is read much faster.
+  static bool convertToBinary(string asciiFile, string binFile,
+    Info* infoPtr = 0);
+
+  // Read in the other members of the set, for PDF uncertainties.
+  int initMembers(int nMembersIn, Info* infoPtr = 0);
+
+  // Evaluate flavour id for all members at (x, Q2), stored in xfOut.
+  void xfxMembers(int id, double x, double Q2, double* xfOut) const;
+
+  // Number of members, and PDF uncertainties, like for LHAPDF6.
+  int nMembers() {return max( 1, int(memberPtrs.size()));}
+  void calcPDFEnvelope(int idNow, double xNow, double Q2Now, int valSea);
+  void calcPDFEnvelope(pair<int,int> idNows, pair<double,double> xNows,
+    double Q2Now, int valSea);
+  PDFEnvelope getPDFEnvelope() {return pdfEnvelope;}
+
 private:
 
+  // Constants: could only be changed in the code itself.
+  static const int NBINPERKNOT, NBINHEAD;
+  static const unsigned long long BINMAGIC, BINVERSION;
+  static const double PDFMINVALUE;
+
   // Variables to be set during code initialization.
   bool   doExtraPol;
-  int    nx, nq, nqSub;
-  vector<int> nqSum;
-  double xMin, xMax, qMin, qMax, pdfVal[12];
-  vector<double> xGrid, lnxGrid, qGrid, lnqGrid, qDiv;
-  double** pdfGrid[12];
-  double** pdfSlope;
+  double pdfVal[12];
+
+  // The members of the set, the first being the central one, the way
+  // to find uncertainties from them, 0 for replicas, 1 for symmetric and
+  // 2 for asymmetric Hessian, and the file the central one was read from.
+  vector< shared_ptr<const LHAGrid1Data> > memberPtrs;
+  int    errorType;
+  string dataFileSav;
+
+  // PDF uncertainties, and member values used to find them.
+  PDFEnvelope pdfEnvelope;
+  vector<double> xfMemSav, xfMemSav2;
+
+  // The grid data, possibly shared with other LHAGrid1 objects.
+  shared_ptr<const LHAGrid1Data> gridPtr;
+
+  // Grids already read from file, keyed by file name. Only weak pointers
+  // are stored, so that a grid is deleted when no longer in use.
+  static map<string, weak_ptr<const LHAGrid1Data> > gridCache;
+  static mutex gridCacheMutex;
 
   // Initialization of data array.
   void init( string pdfSet, string pdfdataPath, Info* infoPtr);
@@ -311,12 +427,38 @@ private:
   // Initialization through a stream.
   void init( istream& is, Info* infoPtr);
 
+  // Initialization from a file, of either format, unless already read.
+  void initFile( string dataFile, Info* infoPtr);
+
+  // Initialization from a binary file, mapped into memory.
+  void initBinary( string binFile, Info* infoPtr);
+
+  // Set up the quantities derived from the grid.
+  static void initDerived( LHAGrid1Data& grid);
+
+  // Checksum of the words of a binary file.
+  static unsigned long long binChecksum(
+    const unsigned long long* words, size_t nWords);
+
   // Update PDF values.
   void xfUpdate(int id, double x, double Q2);
 
   // Interpolation in the grid for a given PDF flavour.
   void xfxevolve(double x, double Q2);
 
+  // Interpolation weights in ln(x) and ln(q), and the interpolation
+  // of all flavours with these weights.
+  void xWeights(double x, int& inx, int& m3x, double wx[4]) const;
+  void qWeights(double Q2, int& m3q, int& n3q, double wq[4]) const;
+  void interpolate(double x, int inx, int m3x, const double wx[4],
+    int m3q, int n3q, const double wq[4], double* val) const;
+
+  // Values for all members of flavour id, or of its valence or sea part,
+  // with the same weights, and the PDF uncertainties from them.
+  void memberValues(int id, double x, double Q2, int valSea,
+    double* val) const;
+  void calcEnvelope(const vector<double>& xfCalc);
+
 };
 
 //==========================================================================
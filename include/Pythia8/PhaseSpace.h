@@ -243,6 +243,9 @@ protected:
   void solveSys( int n, int bin[8], double vec[8], double mat[8][8],
     double coef[8]);
 
+  // Provide cumulative sum of phase-space coefficients in 2 -> 1/2/3.
+  void setupCoefSum();
+
   // Properties specific to resonance mass selection in 2 -> 2 and 2 -> 3.
   bool   useBW[6], useNarrowBW[6];
   int    idMass[6];
@@ -47,6 +47,13 @@ public:
   double parm(string key) const {return settingsPtr->parm(key);}
   string word(string key) const {return settingsPtr->word(key);}
 
+  // Shorthand to read settings values from handles, without search.
+  bool   flag(FlagHandle handle) const {return settingsPtr->flag(handle);}
+  int    mode(ModeHandle handle) const {return settingsPtr->mode(handle);}
+  double parm(ParmHandle handle) const {return settingsPtr->parm(handle);}
+  const string& word(WordHandle handle) const {
+    return settingsPtr->word(handle);}
+
 protected:
 
   // Default constructor.
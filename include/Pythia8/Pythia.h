@@ -22,6 +22,7 @@
 #include "Pythia8/HadronLevel.h"
 #include "Pythia8/HadronWidths.h"
 #include "Pythia8/Info.h"
+#include "Pythia8/InitCache.h"
 #include "Pythia8/JunctionSplitting.h"
 #include "Pythia8/LesHouches.h"
 #include "Pythia8/Merging.h"
@@ -215,6 +216,13 @@ public:
   // Special routine to allow more decays if on/off switches changed.
   bool moreDecays() {return hadronLevel.moreDecays(event);}
 
+  // Lazy decays: check or do the pending decay of a particle, or of all
+  // particles selected by a user function.
+  bool isDecayPending(int i) {return hadronLevel.isDecayPending(i, event);}
+  bool decayPending(int i) {return hadronLevel.decayPending(i, event);}
+  bool decayPendingIf(function<bool(const Particle&)> select) {
+    return hadronLevel.decayPendingIf(select, event);}
+
   // Special routine to force R-hadron decay when not done before.
   bool forceRHadronDecays() {return doRHadronDecays();}
 
@@ -454,6 +462,9 @@ private:
   // Pointers to external calculation of resonance widths.
   vector<ResonanceWidths*> resonancePtrs = {};
 
+  // Cache of time-consuming initialization tables, stored on file.
+  InitCache initCache = {};
+
   // Pointers to timelike and spacelike showers, including Vincia and Dire.
   TimeShowerPtr  timesDecPtr = {};
   TimeShowerPtr  timesPtr = {};
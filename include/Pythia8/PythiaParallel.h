@@ -0,0 +1,124 @@
+// PythiaParallel.h is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// This file contains the driver class for multithreaded event generation.
+// PythiaParallel: run several Pythia instances in parallel threads.
+
+#ifndef Pythia8_PythiaParallel_H
+#define Pythia8_PythiaParallel_H
+
+#include "Pythia8/Pythia.h"
+#include "Pythia8/PythiaStdlib.h"
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The PythiaParallel class clones a configured Pythia object into a
+// number of worker instances, each with its own random number seed,
+// and generates events in parallel threads. Statistics on cross sections,
+// weights and errors are combined at the end.
+
+class PythiaParallel {
+
+public:
+
+  // Constructor, with the same arguments as the Pythia one.
+  PythiaParallel(string xmlDir = "../share/Pythia8/xmldoc",
+    bool printBanner = true);
+
+  // Copy and = constructors cannot be used.
+  PythiaParallel(const PythiaParallel&) = delete;
+  PythiaParallel& operator=(const PythiaParallel&) = delete;
+
+  // Read in one update for a setting or particle data from a single line.
+  bool readString(string line, bool warn = true) {
+    return pythiaHelper.readString(line, warn);}
+
+  // Read in updates for settings or particle data from user-defined file.
+  bool readFile(string fileName, bool warn = true,
+    int subrun = SUBRUNDEFAULT) {
+    return pythiaHelper.readFile(fileName, warn, subrun);}
+  bool readFile(string fileName, int subrun) {
+    return readFile(fileName, true, subrun);}
+
+  // Initialize all worker instances. The optional function is called
+  // for each instance before its Pythia::init(), e.g. to set pointers.
+  bool init() {return init(nullptr);}
+  bool init(function<bool(Pythia&)> customInit);
+
+  // Generate the requested number of events, distributed dynamically
+  // over the worker instances. The callback is called for each
+  // successfully generated event. Returns number of events generated.
+  long run(long nEvents, function<void(Pythia&)> callback);
+  long run(function<void(Pythia&)> callback) {
+    return run( settings.mode("Main:numberOfEvents"), callback);}
+
+  // Perform an action on each worker instance, one at a time.
+  void foreach(function<void(Pythia&)> action);
+
+  // Combined statistics on generation, cross sections and errors.
+  void stat();
+
+  // Combined cross section and event statistics over all instances.
+  long   nTried()         const {return nTrySum;}
+  long   nSelected()      const {return nSelSum;}
+  long   nAccepted()      const {return nAccSum;}
+  double sigmaGen()       const {return sigGenSum;}
+  double sigmaErr()       const {return sigErrSum;}
+  double weightSum()      const {return wtSum;}
+  int    errorTotalNumber() const {return infoSum.errorTotalNumber();}
+
+  // Number of worker instances and number of failed next() calls.
+  int    nInstances()     const {return int(pythiaObjects.size());}
+  long   nFailed()        const {return nFailedSum;}
+
+  // Read in settings values: shorthand, not new functionality.
+  bool   flag(string key) {return settings.flag(key);}
+  int    mode(string key) {return settings.mode(key);}
+  double parm(string key) {return settings.parm(key);}
+  string word(string key) {return settings.word(key);}
+
+private:
+
+  // Negative integer to denote that no subrun has been set.
+  static const int    SUBRUNDEFAULT = -999;
+  // Default seed of the random number generator, cf. Rndm.
+  static const int    DEFAULTSEED, MAXSEED;
+
+  // Helper instance, which holds the master copy of settings and
+  // particle data. Never initialized itself.
+  Pythia pythiaHelper;
+
+public:
+
+  // Settings and particle data, to be modified before init().
+  Settings&     settings;
+  ParticleData& particleData;
+
+private:
+
+  // The worker instances.
+  vector<unique_ptr<Pythia> > pythiaObjects;
+
+  // Initialization data, extracted from database.
+  bool   isInit, processAsync;
+  int    nTimesAllowErrors;
+
+  // Collect the statistics of all worker instances.
+  void   collectStat();
+
+  // Combined statistics.
+  long   nTrySum, nSelSum, nAccSum, nFailedSum;
+  double sigGenSum, sigErrSum, wtSum;
+  Info   infoSum;
+
+};
+
+//==========================================================================
+
+} // end namespace Pythia8
+
+#endif // Pythia8_PythiaParallel_H
@@ -28,6 +28,12 @@
 #include <list>
 #include <functional>
 
+// Stdlib header files for multithreading.
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
 // Stdlib header file for dynamic library loading.
 #include <dlfcn.h>
 
@@ -88,6 +94,14 @@ using std::multiset;
 using std::list;
 using std::function;
 
+// Threading and synchronisation.
+using std::thread;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::condition_variable;
+using std::atomic;
+
 // Input/output streams.
 using std::cin;
 using std::cout;
@@ -116,6 +130,7 @@ using std::shared_ptr;
 using std::weak_ptr;
 using std::dynamic_pointer_cast;
 using std::make_shared;
+using std::unique_ptr;
 
 } // end namespace Pythia8
 
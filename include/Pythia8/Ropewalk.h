@@ -10,7 +10,8 @@
 // which calculates parameters for the rope.
 //
 // The file contains the following classes: RopeDipoleEnd,
-// OverlappingRopeDipole, RopeDipole, Ropewalk, RopeFragPars and FlavourRope.
+// RopeIntervalTree, OverlappingRopeDipole, RopeDipole, Ropewalk,
+// RopeFragPars and FlavourRope.
 
 #ifndef Pythia8_Ropewalk_H
 #define Pythia8_Ropewalk_H
@@ -61,6 +62,66 @@ private:
 
 //==================================================================
 
+// The RopeIntervalTree class is a static interval tree, used to find all
+// rapidity ranges that overlap a given range, in a time that grows only
+// logarithmically with the number of ranges. The ranges are sorted in
+// their lower end, and a binary tree over them keeps track of the largest
+// upper end of the ranges below each node.
+
+class RopeIntervalTree {
+
+public:
+
+  // Constructor.
+  RopeIntervalTree() : ranges(), yMaxNode() {}
+
+  // Remove all ranges.
+  void clear() { ranges.resize(0); yMaxNode.resize(0); }
+
+  // Add a range, with an index that is returned when it is found.
+  void add(double yMinIn, double yMaxIn, int indexIn);
+
+  // Sort the ranges and set up the tree. Needed after the last add.
+  void build();
+
+  // Append the indices of all ranges overlapping [yMinIn, yMaxIn],
+  // end points included, to a list.
+  void overlapping(double yMinIn, double yMaxIn, vector<int>& indices)
+    const;
+
+  // Number of ranges.
+  int size() const { return ranges.size(); }
+
+private:
+
+  // Constant: number of ranges in a node below which no further split.
+  static const int NRANGELEAF;
+
+  // A range, with its lower and upper end and its index.
+  struct Range {
+    Range(double yMinIn = 0., double yMaxIn = 0., int indexIn = 0) :
+      yMin(yMinIn), yMax(yMaxIn), index(indexIn) {}
+    double yMin, yMax;
+    int index;
+  };
+
+  // Set up a node of the tree, covering ranges iBeg to iEnd - 1.
+  double buildNode(int iNode, int iBeg, int iEnd);
+
+  // Search a node of the tree, covering ranges iBeg to iEnd - 1.
+  void search(int iNode, int iBeg, int iEnd, double yMinIn, double yMaxIn,
+    vector<int>& indices) const;
+
+  // The ranges, sorted in their lower end after build.
+  vector<Range> ranges;
+
+  // The largest upper end of the ranges below each node.
+  vector<double> yMaxNode;
+
+};
+
+//==================================================================
+
 // A dipole has many dipoles overlapping with it. The OverlappingRopeDipole
 // class does bookkeeping of this. Holds a pointer to the original dipole.
 
@@ -136,7 +197,11 @@ public:
 
   // Add an overlapping dipole.
   void addOverlappingDipole(OverlappingRopeDipole& d) {
-    overlaps.push_back(d); }
+    overlaps.push_back(d); hasOverlapTree = false; }
+
+  // Check if an overlapping dipole can pass the impact-parameter test of
+  // getOverlaps for any rapidity, else it need not be stored.
+  bool canOverlap(OverlappingRopeDipole& d, double m0, double r0);
 
   // Get the maximal and minimal rapidity of the dipole.
   double maxRapidity(double m0) { return (max(d1.rap(m0), d2.rap(m0))); }
@@ -195,6 +260,17 @@ private:
   // The dipoles overlapping with this one.
   vector<OverlappingRopeDipole> overlaps;
 
+  // Rapidity ranges of the overlapping dipoles, in the dipole rest frame,
+  // and a list of those found at a given rapidity.
+  RopeIntervalTree overlapTree;
+  bool hasOverlapTree;
+  vector<int> iOverlapsHere;
+
+  // Impact parameter at a rapidity fraction t, in the dipole rest frame,
+  // as bFrac0 + t * bFrac1, used to check overlaps before storing them.
+  Vec4 bFrac0, bFrac1;
+  bool hasBFrac;
+
   // All excitations belonging to this dipole ordered in rapidity in lab frame.
   map<double, Particle*> excitations;
 
@@ -217,7 +293,8 @@ public:
     shoveJunctionStrings(),
     shoveMiniStrings(), shoveGluonLoops(), mStringMin(), limitMom(), rCutOff(),
     gAmplitude(), gExponent(), deltay(), deltat(), tShove(), tInit(),
-    showerCut(), alwaysHighest() {}
+    showerCut(), alwaysHighest(), fastOverlaps(), yMarginFast(),
+    bMarginFast() {}
 
   // The Ropewalk init function sets parameters and pointers.
   virtual bool init();
@@ -250,6 +327,9 @@ public:
 
 private:
 
+  // Constants: could only be changed in the code itself.
+  static const double NCELLMAX;
+
   // Parameters of the ropewalk.
   double r0, m0, pTcut;
   // Include junction strings in shoving.
@@ -278,6 +358,9 @@ private:
   double showerCut;
   // Assume we are always in highest multiplet.
   bool alwaysHighest;
+  // Preselect overlapping dipoles in the lab frame, with margins.
+  bool fastOverlaps;
+  double yMarginFast, bMarginFast;
 
   // All dipoles in the event sorted by event record.
   // Index of the two partons.
@@ -12,6 +12,8 @@
 // MVec: vector of Modes (integers).
 // PVec: vector of Parms (doubles).
 // WVec: vector of Words (strings).
+// SettingsStore: flat storage of all settings of one kind.
+// SettingsHandle: index of a setting, for fast repeated access.
 // Settings: maps of flags, modes, parms and words with input/output.
 
 #ifndef Pythia8_Settings_H
@@ -188,6 +190,128 @@ public:
 
 //==========================================================================
 
+// Flat storage of all settings of one kind, e.g. all Parm objects.
+// Entries are stored contiguously in the order they are added, so the
+// position of an entry never changes, and can be used as a handle to it.
+// An index sorted by the lowercase key gives search and ordered loops.
+// The interface mimics the subset of std::map used by Settings.
+
+template<class T> class SettingsStore {
+
+public:
+
+  // An entry consists of the lowercase key and the setting itself.
+  typedef pair<string, T> Entry;
+
+  // Iterator over entries, in alphabetical order of the keys.
+  class iterator {
+
+  public:
+
+    // Constructor.
+    iterator(SettingsStore* storePtrIn = 0, int iOrderIn = 0)
+      : storePtr(storePtrIn), iOrder(iOrderIn) {}
+
+    // Access the entry and step to the next one.
+    Entry& operator*() const {
+      return storePtr->entries[storePtr->order[iOrder]];}
+    Entry* operator->() const {return &(**this);}
+    iterator& operator++() {++iOrder; return *this;}
+    bool operator==(const iterator& other) const {
+      return iOrder == other.iOrder;}
+    bool operator!=(const iterator& other) const {
+      return iOrder != other.iOrder;}
+
+  private:
+
+    // Store that is looped over, and position in the sorted index.
+    SettingsStore* storePtr;
+    int iOrder;
+
+  };
+
+  // Begin and end of a loop over entries.
+  iterator begin() {return iterator(this, 0);}
+  iterator end() {return iterator(this, int(order.size()));}
+
+  // Find entry with a given lowercase key, else return end().
+  iterator find(const string& key) {
+    int iOrder = lowerBound(key);
+    return (iOrder < int(order.size()) && entries[order[iOrder]].first == key)
+      ? iterator(this, iOrder) : end();}
+
+  // Position of the entry with a given lowercase key, or -1 if none.
+  int index(const string& key) const {
+    int iOrder = lowerBound(key);
+    return (iOrder < int(order.size()) && entries[order[iOrder]].first == key)
+      ? order[iOrder] : -1;}
+
+  // Access entry with a given lowercase key, adding it if not found.
+  T& operator[](const string& key) {
+    int iOrder = lowerBound(key);
+    if (iOrder < int(order.size()) && entries[order[iOrder]].first == key)
+      return entries[order[iOrder]].second;
+    order.insert( order.begin() + iOrder, int(entries.size()));
+    entries.push_back( Entry(key, T()));
+    return entries.back().second;}
+
+  // Access setting at a given position.
+  T&       at(int i)       {return entries[i].second;}
+  const T& at(int i) const {return entries[i].second;}
+
+  // Number of entries, and removal of all of them.
+  int  size() const {return int(entries.size());}
+  void clear() {entries.clear(); order.clear();}
+
+private:
+
+  // Entries in the order they were added, and sorted index of them.
+  vector<Entry> entries;
+  vector<int>   order;
+
+  // Binary search for first position in index not before a given key.
+  int lowerBound(const string& key) const {
+    int iLow = 0;
+    int iHigh = int(order.size());
+    while (iLow < iHigh) {
+      int iMid = (iLow + iHigh) / 2;
+      if (entries[order[iMid]].first < key) iLow = iMid + 1;
+      else iHigh = iMid;
+    }
+    return iLow;}
+
+};
+
+//==========================================================================
+
+// Handle to a setting of a given kind: its position in the flat storage.
+// It is found once, by name, and then gives access to the current value
+// without any search or string operation. It stays valid as long as
+// the database is not read anew, and is also valid in copies of it.
+
+template<class T> class SettingsHandle {
+
+public:
+
+  // Constructor. By default the handle is not connected to any setting.
+  SettingsHandle(int indexIn = -1) : index(indexIn) {}
+
+  // Check whether the handle is connected to a setting.
+  bool isValid() const {return index >= 0;}
+
+  // Position of setting in storage.
+  int index;
+
+};
+
+// Shorthand for the handles of the four main kinds of settings.
+typedef SettingsHandle<Flag> FlagHandle;
+typedef SettingsHandle<Mode> ModeHandle;
+typedef SettingsHandle<Parm> ParmHandle;
+typedef SettingsHandle<Word> WordHandle;
+
+//==========================================================================
+
 // This class holds info on flags (bool), modes (int), parms (double),
 // words (string), fvecs (vector of bool), mvecs (vector of int),
 // pvecs (vector of double) and wvecs (vector of string).
@@ -244,21 +368,21 @@ public:
 
   // Query existence of an entry.
   bool isFlag(string keyIn) {
-    return (flags.find(toLower(keyIn)) != flags.end()); }
+    return (flags.index(toLower(keyIn)) >= 0); }
   bool isMode(string keyIn) {
-    return (modes.find(toLower(keyIn)) != modes.end()); }
+    return (modes.index(toLower(keyIn)) >= 0); }
   bool isParm(string keyIn) {
-    return (parms.find(toLower(keyIn)) != parms.end()); }
+    return (parms.index(toLower(keyIn)) >= 0); }
   bool isWord(string keyIn) {
-    return (words.find(toLower(keyIn)) != words.end()); }
+    return (words.index(toLower(keyIn)) >= 0); }
   bool isFVec(string keyIn) {
-    return (fvecs.find(toLower(keyIn)) != fvecs.end()); }
+    return (fvecs.index(toLower(keyIn)) >= 0); }
   bool isMVec(string keyIn) {
-    return (mvecs.find(toLower(keyIn)) != mvecs.end()); }
+    return (mvecs.index(toLower(keyIn)) >= 0); }
   bool isPVec(string keyIn) {
-    return (pvecs.find(toLower(keyIn)) != pvecs.end()); }
+    return (pvecs.index(toLower(keyIn)) >= 0); }
   bool isWVec(string keyIn) {
-    return (wvecs.find(toLower(keyIn)) != wvecs.end()); }
+    return (wvecs.index(toLower(keyIn)) >= 0); }
 
   // Add new entry.
   void addFlag(string keyIn, bool defaultIn) {
@@ -293,6 +417,25 @@ public:
   vector<double> pvec(string keyIn);
   vector<string> wvec(string keyIn);
 
+  // Find handle to an entry, for fast repeated access to its value.
+  // An invalid handle is returned, with an error message, if no such key.
+  FlagHandle flagHandle(string keyIn);
+  ModeHandle modeHandle(string keyIn);
+  ParmHandle parmHandle(string keyIn);
+  WordHandle wordHandle(string keyIn);
+
+  // Give back current value from a handle, without any search.
+  // An invalid handle gives the same values as an unknown key.
+  bool   flag(FlagHandle handle) const {return (handle.index >= 0
+    && handle.index < flags.size()) ? flags.at(handle.index).valNow : false;}
+  int    mode(ModeHandle handle) const {return (handle.index >= 0
+    && handle.index < modes.size()) ? modes.at(handle.index).valNow : 0;}
+  double parm(ParmHandle handle) const {return (handle.index >= 0
+    && handle.index < parms.size()) ? parms.at(handle.index).valNow : 0.;}
+  const string& word(WordHandle handle) const {return (handle.index >= 0
+    && handle.index < words.size()) ? words.at(handle.index).valNow
+    : WORDDEFAULT;}
+
   // Give back default value, with check that key exists.
   bool   flagDefault(string keyIn);
   int    modeDefault(string keyIn);
@@ -354,32 +497,35 @@ public:
 
  private:
 
+  // Value of a word for an invalid handle.
+  static const string WORDDEFAULT;
+
   // Pointer to various information on the generation.
   Info* infoPtr;
 
-  // Map for bool flags.
-  map<string, Flag> flags;
+  // Storage of bool flags.
+  SettingsStore<Flag> flags;
 
-  // Map for integer modes.
-  map<string, Mode> modes;
+  // Storage of integer modes.
+  SettingsStore<Mode> modes;
 
-  // Map for double parms.
-  map<string, Parm> parms;
+  // Storage of double parms.
+  SettingsStore<Parm> parms;
 
-  // Map for string words.
-  map<string, Word> words;
+  // Storage of string words.
+  SettingsStore<Word> words;
 
-  // Map for vectors of bool.
-  map<string, FVec> fvecs;
+  // Storage of vectors of bool.
+  SettingsStore<FVec> fvecs;
 
-  // Map for vectors of int.
-  map<string, MVec> mvecs;
+  // Storage of vectors of int.
+  SettingsStore<MVec> mvecs;
 
-  // Map for vectors of double.
-  map<string, PVec> pvecs;
+  // Storage of vectors of double.
+  SettingsStore<PVec> pvecs;
 
-  // Map for vectors of string.
-  map<string, WVec> wvecs;
+  // Storage of vectors of string.
+  SettingsStore<WVec> wvecs;
 
   // Flags that initialization has been performed; whether any failures.
   bool isInit, readingFailedSave;
@@ -392,6 +538,14 @@ public:
   vector<string> readStringHistory;
   map<int, vector<string> > readStringSubrun;
 
+  // Databases already read from file, keyed by file name, so that
+  // several Pythia instances need only parse the XML files once.
+  static map<string, shared_ptr<const Settings> > xmlCache;
+  static mutex xmlCacheMutex;
+
+  // Read in database from specific file, called from init.
+  bool readXML(string startFile, bool append);
+
   // Print out table of database, called from listAll and listChanged.
   void list(bool doListAll, bool doListString, string match);
 
@@ -100,8 +100,8 @@ public:
     dopTlimit1(), dopTlimit2(), dopTdamp(), pT2damp(), kRad(), kEmt(),
     pdfScale2(), doTrialNow(), canEnhanceEmission(), canEnhanceTrial(),
     canEnhanceET(), doUncertaintiesNow(), dipSel(), iDipSel(), nHard(),
-    nFinalBorn(), nMaxGlobalBranch(), nGlobal(), globalRecoilMode(),
-    limitMUQ(), weakHardSize() { beamOffset = 0;}
+    nFinalBorn(), nMaxGlobalBranch(), nFinalBornHandle(), nGlobal(),
+    globalRecoilMode(), limitMUQ(), weakHardSize() { beamOffset = 0;}
 
   // Destructor.
   virtual ~SimpleTimeShower() {}
@@ -280,6 +280,8 @@ private:
   // hard event (to distinguish between S and H), maximally allowed number of
   // global recoil branchings.
   int nHard, nFinalBorn, nMaxGlobalBranch;
+  // Handle to the number of Born partons, which is read for each event.
+  ModeHandle nFinalBornHandle;
   // Number of proposed splittings in hard scattering systems.
   map<int,int> nProposed;
   // Number of splittings with global recoil (currently only 1).
@@ -6,6 +6,7 @@
 // This file contains the classes for string fragmentation.
 // StringEnd: keeps track of the fragmentation step.
 // StringFragmentation: is the top-level class.
+// ParallelStringFragmentation: fragments several systems concurrently.
 
 #ifndef Pythia8_StringFragmentation_H
 #define Pythia8_StringFragmentation_H
@@ -35,17 +36,19 @@ class StringEnd {
 public:
 
   // Constructor.
-  StringEnd() : particleDataPtr(), flavSelPtr(), pTSelPtr(), zSelPtr(),
-    fromPos(), thermalModel(), mT2suppression(), iEnd(), iMax(), idHad(),
-    iPosOld(), iNegOld(), iPosNew(), iNegNew(), hadSoFar(), colOld(), colNew(),
-    pxOld(), pyOld(), pxNew(), pyNew(), pxHad(), pyHad(), mHad(), mT2Had(),
-    zHad(), GammaOld(), GammaNew(), xPosOld(), xPosNew(), xPosHad(), xNegOld(),
-    xNegNew(), xNegHad(), aLund(), bLund() {}
+  StringEnd() : particleDataPtr(), rndmPtr(), flavSelPtr(), pTSelPtr(),
+    zSelPtr(), fromPos(), thermalModel(), mT2suppression(), iEnd(), iMax(),
+    idHad(), iPosOld(), iNegOld(), iPosNew(), iNegNew(), hadSoFar(),
+    colOld(), colNew(), pxOld(), pyOld(), pxNew(), pyNew(), pxHad(), pyHad(),
+    mHad(), mT2Had(), zHad(), GammaOld(), GammaNew(), xPosOld(), xPosNew(),
+    xPosHad(), xNegOld(), xNegNew(), xNegHad(), aLund(), bLund() {}
 
   // Save pointers.
-  void init( ParticleData* particleDataPtrIn, StringFlav* flavSelPtrIn,
-    StringPT* pTSelPtrIn, StringZ* zSelPtrIn, Settings& settings) {
-    particleDataPtr = particleDataPtrIn; flavSelPtr = flavSelPtrIn;
+  void init( ParticleData* particleDataPtrIn, Rndm* rndmPtrIn,
+    StringFlav* flavSelPtrIn, StringPT* pTSelPtrIn, StringZ* zSelPtrIn,
+    Settings& settings) {
+    particleDataPtr = particleDataPtrIn; rndmPtr = rndmPtrIn;
+    flavSelPtr = flavSelPtrIn;
     pTSelPtr = pTSelPtrIn; zSelPtr = zSelPtrIn;
     bLund = zSelPtr->bAreaLund(); aLund = zSelPtr->aAreaLund();
     thermalModel   = settings.flag("StringPT:thermalModel");
@@ -67,18 +70,29 @@ public:
 
   // Generate momentum for some possible next hadron, based on mean values
   // to get an estimate for rapidity and pT.
-  Vec4 kinematicsHadronTmp(StringSystem system, Vec4 pRem, double phi,
-    double mult);
+  Vec4 kinematicsHadronTmp(StringSystem& system, Vec4 pRem, double phi,
+    double mult) const;
 
   // Update string end information after a hadron has been removed.
   void update();
 
+  // Forget information from a previous string, which otherwise may enter
+  // the first hadron of the next one.
+  void reset() { iEnd = iMax = idHad = iPosOld = iNegOld = iPosNew
+    = iNegNew = hadSoFar = colOld = colNew = 0; pxOld = pyOld = pxNew
+    = pyNew = pxHad = pyHad = mHad = mT2Had = zHad = GammaOld = GammaNew
+    = xPosOld = xPosNew = xPosHad = xNegOld = xNegNew = xNegHad = 0.;
+    flavOld = flavNew = FlavContainer(); pHad = pSoFar = Vec4(); }
+
   // Constants: could only be changed in the code itself.
   static const double TINY, PT2SAME, MEANMMIN, MEANM, MEANPT;
 
   // Pointer to the particle data table.
   ParticleData* particleDataPtr;
 
+  // Pointer to the random number generator, used for hadron masses.
+  Rndm*         rndmPtr;
+
   // Pointers to classes for flavour, pT and z generation.
   StringFlav*   flavSelPtr;
   StringPT*     pTSelPtr;
@@ -125,6 +139,10 @@ public:
   // Find the boost matrix to the rest frame of a junction.
   RotBstMatrix junctionRestFrame(Vec4& p0, Vec4& p1, Vec4& p2);
 
+  // Forget information from the previous string kept in the string ends,
+  // so that the outcome does not depend on which string came before.
+  void resetEnds() {posEnd.reset(); negEnd.reset();}
+
 private:
 
   // Constants: could only be changed in the code itself.
@@ -185,7 +203,7 @@ private:
   vector<int> findFirstRegion(int iSub, ColConfig& colConfig, Event& event);
 
   // Set flavours and momentum position for initial string endpoints.
-  void setStartEnds(int idPos, int idNeg, StringSystem systemNow,
+  void setStartEnds(int idPos, int idNeg, StringSystem& systemNow,
     int legNow = 3);
 
   // Check remaining energy-momentum whether it is OK to continue.
@@ -217,8 +235,87 @@ private:
   int extraJoin(double facExtra, Event& event);
 
   // Get the number of nearby strings given the energies.
-  double nearStringPieces(StringEnd end,
-    vector< vector< pair<double,double> > >& rapPairs);
+  double nearStringPieces(const StringEnd& end, const ColConfig& colConfig);
+
+};
+
+//==========================================================================
+
+// The ParallelStringFragmentation class fragments a set of independent
+// colour singlet systems concurrently, on a pool of threads, each with
+// its own StringFragmentation and flavour, pT and z selection objects.
+// Every system is given a random-number stream of its own, seeded from
+// the main generator in the order of the systems, and its hadrons are
+// kept in a local buffer until stored in the event record, again in the
+// order of the systems. The outcome therefore does not depend on the
+// number of threads, or on which thread handled which system.
+
+class ParallelStringFragmentation : public PhysicsBase {
+
+public:
+
+  // Constructor and destructor.
+  ParallelStringFragmentation() = default;
+  ~ParallelStringFragmentation() {stopThreads();}
+
+  // Set up the fragmentation objects of each thread, and start threads.
+  void init(int nThreadsIn);
+
+  // Number of threads used, including the calling one.
+  int nThreads() const {return workers.size();}
+
+  // Fragment the listed systems, with the results kept in local buffers.
+  void fragment(const vector<int>& iSubIn, ColConfig& colConfig,
+    const Event& event);
+
+  // Store the hadrons of one of the systems in the event record.
+  bool store(int iSub, Event& event);
+
+private:
+
+  // The objects used by each thread, including a local event record.
+  struct Worker {
+    Info                info;
+    Rndm                rndm;
+    StringFlav          flavSel;
+    StringPT            pTSel;
+    StringZ             zSel;
+    StringFragmentation stringFrag;
+    Event               event;
+    thread              workThread;
+  };
+  vector< unique_ptr<Worker> > workers;
+
+  // The outcome of the fragmentation of one system: new entries, and
+  // status and daughters of the original partons.
+  struct Result {
+    bool             isOK;
+    vector<Particle> entries;
+    vector<int>      iMarked, statusMarked, dau1Marked, dau2Marked;
+  };
+
+  // The current systems, their random-number seeds and results.
+  vector<int>    iSubTask, taskOfSub, seedTask;
+  vector<Result> results;
+  ColConfig*     colConfigPtr{};
+  const Event*   eventPtr{};
+  int            nBase{};
+  atomic<int>    nClaimed{};
+
+  // Synchronization of the threads in the pool.
+  mutex              poolMutex;
+  condition_variable wakeCond, doneCond;
+  int                generation{}, nBusy{};
+  bool               doStop{};
+
+  // Loop run by each pool thread, waiting for a new set of systems.
+  void threadLoop(int iWorker, int generationSeen);
+
+  // Fragment systems not yet claimed by another thread.
+  void work(Worker& worker);
+
+  // Stop and join the pool threads.
+  void stopThreads();
 
 };
 
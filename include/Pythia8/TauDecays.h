@@ -40,6 +40,9 @@ public:
   // Decay a tau or correlated tau pair.
   bool decay(int iDec, Event& event);
 
+  // Find the partner a tau is decayed together with, if correlated.
+  int partner(int iDec, const Event& event) const;
+
   // Determine internal or external polarization and correlation mechanism.
   bool internalMechanism(Event &event);
   bool externalMechanism(Event &event);
@@ -39,9 +39,7 @@ const double Sphericity::EIGENVALUEMIN = 1e-10;
 
 bool Sphericity::analyze(const Event& event) {
 
-  // Initial values, tensor and counters zero.
-  eVal1 = eVal2 = eVal3 = 0.;
-  eVec1 = eVec2 = eVec3 = 0.;
+  // Initial tensor and counters zero.
   double tt[4][4];
   for (int j = 1; j < 4; ++j)
   for (int k = j; k < 4; ++k) tt[j][k] = 0.;
@@ -54,21 +52,78 @@ bool Sphericity::analyze(const Event& event) {
     if (select >  2 &&  event[i].isNeutral() ) continue;
     if (select == 2 && !event[i].isVisible() ) continue;
     ++nStudy;
+    addToTensor( event[i].px(), event[i].py(), event[i].pz(), tt, denom);
+  }
 
-    // Calculate matrix to be diagonalized. Special cases for speed.
-    double pNow[4];
-    pNow[1] = event[i].px();
-    pNow[2] = event[i].py();
-    pNow[3] = event[i].pz();
-    double p2Now = pNow[1]*pNow[1] + pNow[2]*pNow[2] + pNow[3]*pNow[3];
-    double pWeight = 1.;
-    if (powerInt == 1) pWeight = 1. / sqrt(max(P2MIN, p2Now));
-    else if (powerInt == 0) pWeight = pow( max(P2MIN, p2Now), powerMod);
-    for (int j = 1; j < 4; ++j)
-    for (int k = j; k < 4; ++k) tt[j][k] += pWeight * pNow[j] * pNow[k];
-    denom += pWeight * p2Now;
+  // Find the eigenvalues and eigenvectors.
+  return findAxes( tt, denom, nStudy);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Analyze event stored by columns, with the same result as above.
+
+bool Sphericity::analyze(const EventColumns& columns) {
+
+  // Initial tensor and counters zero.
+  double tt[4][4];
+  for (int j = 1; j < 4; ++j)
+  for (int k = j; k < 4; ++k) tt[j][k] = 0.;
+  int nStudy = 0;
+  double denom = 0.;
+
+  // Loop over desired particles in the event.
+  const int*    status    = columns.status.data();
+  const char*   isNeutral = columns.isNeutral.data();
+  const char*   isVisible = columns.isVisible.data();
+  const double* px        = columns.px.data();
+  const double* py        = columns.py.data();
+  const double* pz        = columns.pz.data();
+  for (int i = 0; i < columns.size(); ++i)
+  if (status[i] > 0) {
+    if (select >  2 &&  isNeutral[i] ) continue;
+    if (select == 2 && !isVisible[i] ) continue;
+    ++nStudy;
+    addToTensor( px[i], py[i], pz[i], tt, denom);
   }
 
+  // Find the eigenvalues and eigenvectors.
+  return findAxes( tt, denom, nStudy);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add a particle to the matrix to be diagonalized. Special cases for speed.
+
+void Sphericity::addToTensor(double px, double py, double pz,
+  double tt[4][4], double& denom) const {
+
+  double pNow[4];
+  pNow[1] = px;
+  pNow[2] = py;
+  pNow[3] = pz;
+  double p2Now = pNow[1]*pNow[1] + pNow[2]*pNow[2] + pNow[3]*pNow[3];
+  double pWeight = 1.;
+  if (powerInt == 1) pWeight = 1. / sqrt(max(P2MIN, p2Now));
+  else if (powerInt == 0) pWeight = pow( max(P2MIN, p2Now), powerMod);
+  for (int j = 1; j < 4; ++j)
+  for (int k = j; k < 4; ++k) tt[j][k] += pWeight * pNow[j] * pNow[k];
+  denom += pWeight * p2Now;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the eigenvalues and eigenvectors of the summed tensor.
+
+bool Sphericity::findAxes(double tt[4][4], double denom, int nStudy) {
+
+  // Initial values zero.
+  eVal1 = eVal2 = eVal3 = 0.;
+  eVec1 = eVec2 = eVec3 = 0.;
+
   // Very low multiplicities (0 or 1) not considered.
   if (nStudy < NSTUDYMIN) {
     if (nFew < TIMESTOPRINT) cout << " PYTHIA Error in "
@@ -226,27 +281,68 @@ const double Thrust::MAJORMIN     = 1e-10;
 
 bool Thrust::analyze(const Event& event) {
 
-  // Initial values and counters zero.
-  eVal1 = eVal2 = eVal3 = 0.;
-  eVec1 = eVec2 = eVec3 = 0.;
-  int nStudy = 0;
-  vector<Vec4> pOrder;
-  Vec4 pSum, nRef, pPart, pFull, pMax;
-
   // Loop over desired particles in the event.
+  vector<Vec4> pOrder;
   for (int i = 0; i < event.size(); ++i)
   if (event[i].isFinal()) {
     if (select >  2 &&  event[i].isNeutral() ) continue;
     if (select == 2 && !event[i].isVisible() ) continue;
-    ++nStudy;
 
     // Store momenta. Use energy component for absolute momentum.
     Vec4 pNow = event[i].p();
     pNow.e(pNow.pAbs());
-    pSum += pNow;
     pOrder.push_back(pNow);
   }
 
+  // Find the thrust, major and minor axes.
+  return findAxes( pOrder);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Analyze event stored by columns, with the same result as above.
+
+bool Thrust::analyze(const EventColumns& columns) {
+
+  // Loop over desired particles in the event.
+  vector<Vec4> pOrder;
+  pOrder.reserve( columns.size() );
+  const int*    status    = columns.status.data();
+  const char*   isNeutral = columns.isNeutral.data();
+  const char*   isVisible = columns.isVisible.data();
+  const double* px        = columns.px.data();
+  const double* py        = columns.py.data();
+  const double* pz        = columns.pz.data();
+  for (int i = 0; i < columns.size(); ++i)
+  if (status[i] > 0) {
+    if (select >  2 &&  isNeutral[i] ) continue;
+    if (select == 2 && !isVisible[i] ) continue;
+
+    // Store momenta. Use energy component for absolute momentum.
+    pOrder.push_back( Vec4( px[i], py[i], pz[i],
+      sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]) ) );
+  }
+
+  // Find the thrust, major and minor axes.
+  return findAxes( pOrder);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the axes from the selected momenta, with absolute momentum as
+// energy component.
+
+bool Thrust::findAxes(vector<Vec4>& pOrder) {
+
+  // Initial values zero.
+  eVal1 = eVal2 = eVal3 = 0.;
+  eVec1 = eVec2 = eVec3 = 0.;
+  int nStudy = pOrder.size();
+  Vec4 pSum, nRef, pPart, pFull, pMax;
+  for (int i = 0; i < nStudy; ++i) pSum += pOrder[i];
+
   // Very low multiplicities (0 or 1) not considered.
   if (nStudy < NSTUDYMIN) {
     if (nFew < TIMESTOPRINT) cout << " PYTHIA Error in "
@@ -922,7 +1018,7 @@ bool SlowJet::setup(const Event& event) {
 
   // Loop over final particles in the event.
   Vec4   pTemp;
-  double mTemp, pT2Temp, mTTemp, yTemp, phiTemp;
+  double mTemp;
   for (int i = 0; i < event.size(); ++i)
   if (event[i].isFinal()) {
 
@@ -952,15 +1048,96 @@ bool SlowJet::setup(const Event& event) {
       if ( !sjHookPtr->include( i, event, pTemp, mTemp) ) continue;
     }
 
-    // Store particle momentum, including some derived quantities.
-    pT2Temp  = max( TINY*TINY, pTemp.pT2());
-    mTTemp  = sqrt( mTemp*mTemp + pT2Temp);
-    yTemp   = (pTemp.pz() > 0)
-            ? log( max( TINY, pTemp.e() + pTemp.pz() ) / mTTemp )
-            : log( mTTemp / max( TINY, pTemp.e() - pTemp.pz() ) );
-    phiTemp = pTemp.phi();
-    clusters.push_back( SingleSlowJet(pTemp, pT2Temp, yTemp, phiTemp, i) );
+    // Store particle momentum.
+    addCluster( pTemp, mTemp, i);
+  }
+
+  // Find the initial distances.
+  return setupDistances();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up list of particles to analyze from an event stored by columns,
+// with the same result as above. A SlowJetHook needs the full event
+// record, and so cannot be used here.
+
+bool SlowJet::setup(const EventColumns& columns) {
+
+  // Initial values zero.
+  clusters.resize(0);
+  jets.resize(0);
+  jtSize = 0;
+  if (!noHook) {
+    cout << " PYTHIA Error in SlowJet::setup: SlowJetHook cannot be used "
+         << "with EventColumns" << endl;
+    return false;
+  }
+
+  // Loop over final particles in the event.
+  const int*    status    = columns.status.data();
+  const int*    id        = columns.id.data();
+  const char*   isNeutral = columns.isNeutral.data();
+  const char*   isVisible = columns.isVisible.data();
+  const double* px        = columns.px.data();
+  const double* py        = columns.py.data();
+  const double* pz        = columns.pz.data();
+  const double* e         = columns.e.data();
+  const double* m         = columns.m.data();
+  for (int i = 0; i < columns.size(); ++i)
+  if (status[i] > 0) {
+
+    // Always apply selection options for visible or charged particles.
+    if      (chargedOnly &&  isNeutral[i] ) continue;
+    else if (visibleOnly && !isVisible[i] ) continue;
+
+    // Pseudorapidity cut to describe detector range, as Particle::eta().
+    if (cutInEta) {
+      double pT = sqrt( px[i] * px[i] + py[i] * py[i]);
+      double pAbs = sqrt( pT * pT + pz[i] * pz[i]);
+      if (log( (pAbs + abs(pz[i])) / max( TINY, pT) ) > etaMax) continue;
+    }
+
+    // Optionally modify mass and energy.
+    Vec4   pTemp( px[i], py[i], pz[i], e[i]);
+    double mTemp = m[i];
+    if (modifyMass) {
+      mTemp = (massSet == 0 || id[i] == 22) ? 0. : PIMASS;
+      pTemp.e( sqrt(pTemp.pAbs2() + mTemp*mTemp) );
+    }
+
+    // Store particle momentum.
+    addCluster( pTemp, mTemp, i);
   }
+
+  // Find the initial distances.
+  return setupDistances();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store a particle momentum, including some derived quantities.
+
+void SlowJet::addCluster(const Vec4& pTemp, double mTemp, int i) {
+
+  double pT2Temp = max( TINY*TINY, pTemp.pT2());
+  double mTTemp  = sqrt( mTemp*mTemp + pT2Temp);
+  double yTemp   = (pTemp.pz() > 0)
+                 ? log( max( TINY, pTemp.e() + pTemp.pz() ) / mTTemp )
+                 : log( mTTemp / max( TINY, pTemp.e() - pTemp.pz() ) );
+  double phiTemp = pTemp.phi();
+  clusters.push_back( SingleSlowJet(pTemp, pT2Temp, yTemp, phiTemp, i) );
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the distances between the selected particles, and to the beams.
+
+bool SlowJet::setupDistances() {
+
   origSize = clusters.size();
 
   // Done here for FJcore machinery.
@@ -18,7 +18,7 @@ namespace Pythia8 {
 
 // Rndm class.
 // This class handles random number generation according to the
-// Marsaglia-Zaman-Tsang algorithm
+// Marsaglia-Zaman-Tsang algorithm or the xoshiro256** one.
 
 //--------------------------------------------------------------------------
 
@@ -28,6 +28,12 @@ namespace Pythia8 {
 // The default seed, i.e. the Marsaglia-Zaman random number sequence.
 const int Rndm::DEFAULTSEED     = 19780503;
 
+// Size of the batches of random numbers generated on the stack.
+const int Rndm::NBATCH          = 64;
+
+// Upper limit for the seeds of separate streams derived from this one.
+const int Rndm::SEEDMAX         = 2147483000;
+
 //--------------------------------------------------------------------------
 
 // Method to pass in pointer for external random number generation.
@@ -48,13 +54,31 @@ bool Rndm::rndmEnginePtr( RndmEngine* rndmEngPtrIn) {
 
 // Initialize, normally at construction or in first call.
 
-void Rndm::init(int seedIn) {
+void Rndm::init(int seedIn, int algorithmIn) {
 
   // Pick seed in convenient way. Assure it to be non-negative.
   int seed = seedIn;
   if (seedIn < 0) seed = DEFAULTSEED;
   else if (seedIn == 0) seed = int(time(0));
   if (seed < 0) seed = -seed;
+  algorithmSave = (algorithmIn == 1) ? 1 : 0;
+
+  // The xoshiro256** state is filled from the seed by the splitmix64
+  // algorithm, which never gives an all-zero state.
+  if (algorithmSave == 1) {
+    unsigned long long z = seed;
+    for (int ii = 0; ii < 4; ++ii) {
+      z += 0x9e3779b97f4a7c15ULL;
+      unsigned long long x = z;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      xs[ii] = x ^ (x >> 31);
+    }
+    initRndm  = true;
+    seedSave  = seed;
+    sequence  = 0;
+    return;
+  }
 
   // Unpack seed.
   int ij = (seed/30082) % 31329;
@@ -98,6 +122,44 @@ void Rndm::init(int seedIn) {
 
 //--------------------------------------------------------------------------
 
+// Jump ahead by nJump times 2^128 steps of the xoshiro256** algorithm.
+// Streams from different numbers of jumps never overlap in practice.
+
+bool Rndm::jump(int nJump) {
+
+  // Only possible for the internal xoshiro256** generator.
+  if (useExternalRndm || algorithmSave != 1 || nJump < 0) return false;
+  if (!initRndm) init(DEFAULTSEED);
+
+  // Polynomial of the jump, combined with the state bit by bit.
+  static const unsigned long long JUMP[4] = { 0x180ec6d33cfd0abaULL,
+    0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+  for (int iJump = 0; iJump < nJump; ++iJump) {
+    unsigned long long s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; ++i)
+    for (int b = 0; b < 64; ++b) {
+      if (JUMP[i] & (1ULL << b)) {
+        s0 ^= xs[0];
+        s1 ^= xs[1];
+        s2 ^= xs[2];
+        s3 ^= xs[3];
+      }
+      xoshiroFlat();
+    }
+    xs[0] = s0;
+    xs[1] = s1;
+    xs[2] = s2;
+    xs[3] = s3;
+  }
+
+  // The sequence counter restarts for the new stream.
+  sequence = 0;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Generate next random number uniformly between 0 and 1.
 
 double Rndm::flat() {
@@ -110,6 +172,7 @@ double Rndm::flat() {
 
   // Find next random number and update saved state.
   ++sequence;
+  if (algorithmSave == 1) return xoshiroFlat();
   double uni;
   do {
     uni = u[i97] - u[j97];
@@ -128,6 +191,88 @@ double Rndm::flat() {
 
 //--------------------------------------------------------------------------
 
+// Fill an array with the next n random numbers. The state is kept in
+// local variables during the loop, so the compiler can keep it in
+// registers, and the checks are done once per call rather than per number.
+
+void Rndm::flat(double* out, int n) {
+
+  // Use external random number generator if such has been linked.
+  if (n <= 0) return;
+  if (useExternalRndm) {
+    rndmEngPtr->flat( out, n);
+    return;
+  }
+
+  // Ensure that already initialized.
+  if (!initRndm) init(DEFAULTSEED);
+  sequence += n;
+
+  // The xoshiro256** algorithm.
+  if (algorithmSave == 1) {
+    unsigned long long s0 = xs[0], s1 = xs[1], s2 = xs[2], s3 = xs[3];
+    for (int i = 0; i < n; ++i) {
+      unsigned long long x = s1 * 5;
+      x = ((x << 7) | (x >> 57)) * 9;
+      unsigned long long t = s1 << 17;
+      s2 ^= s0;
+      s3 ^= s1;
+      s1 ^= s2;
+      s0 ^= s3;
+      s2 ^= t;
+      s3 = (s3 << 45) | (s3 >> 19);
+      out[i] = (double(x >> 11) + 0.5) * 1.1102230246251565e-16;
+    }
+    xs[0] = s0;
+    xs[1] = s1;
+    xs[2] = s2;
+    xs[3] = s3;
+    return;
+  }
+
+  // The Marsaglia-Zaman-Tsang algorithm, as in flat() above.
+  int    i97Now = i97, j97Now = j97;
+  double cNow   = c;
+  for (int i = 0; i < n; ++i) {
+    double uni;
+    do {
+      uni = u[i97Now] - u[j97Now];
+      if (uni < 0.) uni += 1.;
+      u[i97Now] = uni;
+      if (--i97Now < 0) i97Now = 96;
+      if (--j97Now < 0) j97Now = 96;
+      cNow -= cd;
+      if (cNow < 0.) cNow += cm;
+      uni -= cNow;
+      if(uni < 0.) uni += 1.;
+    } while (uni <= 0. || uni >= 1.);
+    out[i] = uni;
+  }
+  i97 = i97Now;
+  j97 = j97Now;
+  c   = cNow;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Fill an array with n numbers according to exp(-x^2/2). The uniform
+// numbers are generated in batches, two per Gaussian one.
+
+void Rndm::gauss(double* out, int n) {
+
+  double flats[2 * NBATCH];
+  for (int iBeg = 0; iBeg < n; iBeg += NBATCH) {
+    int nNow = min( NBATCH, n - iBeg);
+    flat( flats, 2 * nNow);
+    for (int i = 0; i < nNow; ++i) out[iBeg + i]
+      = sqrt(-2. * log(flats[2 * i])) * cos(M_PI * flats[2 * i + 1]);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Generate two random vectors according to the phase space distribution
 
 pair<Vec4, Vec4> Rndm::phaseSpace2(double eCM, double m1, double m2) {
@@ -137,9 +282,11 @@ pair<Vec4, Vec4> Rndm::phaseSpace2(double eCM, double m1, double m2) {
     * (eCM + m1 - m2) * (eCM - m1 + m2) ) / eCM;
 
   // Isotropic angles give three-momentum.
-  double cosTheta = 2. * flat() - 1.;
+  double rndmNow[2];
+  flat( rndmNow, 2);
+  double cosTheta = 2. * rndmNow[0] - 1.;
   double sinTheta = sqrt(1. - cosTheta*cosTheta);
-  double phi      = 2. * M_PI * flat();
+  double phi      = 2. * M_PI * rndmNow[1];
   double pX       = pAbs * sinTheta * cos(phi);
   double pY       = pAbs * sinTheta * sin(phi);
   double pZ       = pAbs * cosTheta;
@@ -189,6 +336,8 @@ bool Rndm::dumpState(string fileName) {
   ofs.write((char *) &cd,       sizeof(double));
   ofs.write((char *) &cm,       sizeof(double));
   ofs.write((char *) &u,        sizeof(double) * 97);
+  ofs.write((char *) &algorithmSave, sizeof(int));
+  ofs.write((char *) &xs,       sizeof(unsigned long long) * 4);
 
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::dumpState: seed = " << seedSave
@@ -222,6 +371,11 @@ bool Rndm::readState(string fileName) {
   ifs.read((char *) &cm,       sizeof(double));
   ifs.read((char *) &u,        sizeof(double) *97);
 
+  // Files written by older versions end here, with the default algorithm.
+  if (!ifs.read((char *) &algorithmSave, sizeof(int))) algorithmSave = 0;
+  else ifs.read((char *) &xs,  sizeof(unsigned long long) * 4);
+  initRndm = true;
+
   // Write confirmation on cout.
   cout << " PYTHIA Rndm::readState: seed " << seedSave
        << ", sequence no = " << sequence << endl;
@@ -394,6 +394,7 @@ double BeamParticle::xfModified(int iSkip, int idIn, double x, double Q2,
   xqgSea    = 0.;
   xqCompSum = 0.;
   const int rsize = size();
+  ++nXfRecomputeSave;
 
   // Fast procedure for first interaction.
   if (rsize == 0) return xfModified0(iSkip, idIn, x, Q2);
@@ -67,71 +67,22 @@ void BeamShape::pick() {
 
   // Set beam A momentum deviation by a three-dimensional Gaussian.
   if (allowMomentumSpread) {
-    double totalDev, gauss;
-    do {
-      totalDev = 0.;
-      if (sigmaPxA > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPxA  = sigmaPxA * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaPyA > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPyA  = sigmaPyA * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaPzA > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPzA  = sigmaPzA * gauss;
-        totalDev += gauss * gauss;
-      }
-    } while (totalDev > maxDevA * maxDevA);
+    pickGauss3( sigmaPxA, sigmaPyA, sigmaPzA, maxDevA,
+      deltaPxA, deltaPyA, deltaPzA);
 
     // Set beam B momentum deviation by a three-dimensional Gaussian.
-    do {
-      totalDev = 0.;
-      if (sigmaPxB > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPxB  = sigmaPxB * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaPyB > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPyB  = sigmaPyB * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaPzB > 0.) {
-        gauss     = rndmPtr->gauss();
-        deltaPzB  = sigmaPzB * gauss;
-        totalDev += gauss * gauss;
-      }
-    } while (totalDev > maxDevB * maxDevB);
+    pickGauss3( sigmaPxB, sigmaPyB, sigmaPzB, maxDevB,
+      deltaPxB, deltaPyB, deltaPzB);
   }
 
   // Set beam vertex location by a three-dimensional Gaussian.
   if (allowVertexSpread) {
-    double totalDev, gauss;
-    do {
-      totalDev = 0.;
-      if (sigmaVertexX > 0.) {
-        gauss     = rndmPtr->gauss();
-        vertexX   = sigmaVertexX * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaVertexY > 0.) {
-        gauss     = rndmPtr->gauss();
-        vertexY   = sigmaVertexY * gauss;
-        totalDev += gauss * gauss;
-      }
-      if (sigmaVertexZ > 0.) {
-        gauss     = rndmPtr->gauss();
-        vertexZ   = sigmaVertexZ * gauss;
-        totalDev += gauss * gauss;
-      }
-    } while (totalDev > maxDevVertex * maxDevVertex);
+    pickGauss3( sigmaVertexX, sigmaVertexY, sigmaVertexZ, maxDevVertex,
+      vertexX, vertexY, vertexZ);
 
     // Set beam collision time by a Gaussian.
     if (sigmaTime > 0.) {
+      double gauss;
       do gauss    = rndmPtr->gauss();
       while (abs(gauss) > maxDevTime);
       vertexT     = sigmaTime * gauss;
@@ -146,6 +97,37 @@ void BeamShape::pick() {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Pick a three-dimensional Gaussian, with components of vanishing width
+// left at zero, and retry until within maxDev standard deviations. The
+// numbers of each try are generated as one batch, in the same order as
+// separate calls would give.
+
+void BeamShape::pickGauss3( double sigmaX, double sigmaY, double sigmaZ,
+  double maxDev, double& x, double& y, double& z) {
+
+  // Find the components that are spread.
+  double  sigma[3]  = { sigmaX, sigmaY, sigmaZ };
+  double* result[3] = { &x, &y, &z };
+  int nGauss = 0;
+  for (int i = 0; i < 3; ++i) if (sigma[i] > 0.) ++nGauss;
+  if (nGauss == 0) return;
+
+  // Pick until inside the allowed range.
+  double gauss[3], totalDev;
+  do {
+    rndmPtr->gauss( gauss, nGauss);
+    totalDev = 0.;
+    for (int i = 0, j = 0; i < 3; ++i) if (sigma[i] > 0.) {
+      *result[i] = sigma[i] * gauss[j];
+      totalDev  += gauss[j] * gauss[j];
+      ++j;
+    }
+  } while (totalDev > maxDev * maxDev);
+
+}
+
 //==========================================================================
 
 } // end namespace Pythia8
@@ -50,6 +50,10 @@ bool BoseEinstein::init() {
   lambda   = parm("BoseEinstein:lambda");
   QRef     = parm("BoseEinstein:QRef");
 
+  // Optionally only pairs with Q below a cut are shifted.
+  useQCut  = flag("BoseEinstein:useQCut");
+  QCut2    = pow2( parm("BoseEinstein:QCutFactor") * QRef );
+
   // Multiples and inverses (= "radii") of distance parameters in Q-space.
   QRef2    = 2. * QRef;
   QRef3    = 3. * QRef;
@@ -138,9 +142,9 @@ bool BoseEinstein::shiftEvent( Event& event) {
     nStored[iSpecies + 1] = hadronBE.size();
 
     // Loop through pairs of identical particles and find shifts.
-    for (int i1 = nStored[iSpecies]; i1 < nStored[iSpecies+1] - 1; ++i1)
-    for (int i2 = i1 + 1; i2 < nStored[iSpecies+1]; ++i2)
-      shiftPair( i1, i2, iTab);
+    if (useQCut) shiftClosePairs( nStored[iSpecies], nStored[iSpecies+1],
+      iTab);
+    else shiftAllPairs( nStored[iSpecies], nStored[iSpecies+1], iTab);
   }
 
   // Must have at least two pairs to carry out compensation.
@@ -198,6 +202,64 @@ bool BoseEinstein::shiftEvent( Event& event) {
 
 //--------------------------------------------------------------------------
 
+// Find shifts for all pairs of identical particles in the range.
+
+void BoseEinstein::shiftAllPairs( int iBeg, int iEnd, int iTab) {
+
+  for (int i1 = iBeg; i1 < iEnd - 1; ++i1)
+  for (int i2 = i1 + 1; i2 < iEnd; ++i2)
+    shiftPair( i1, i2, iTab);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find shifts only for pairs of identical particles with Q below the cut.
+// Since m1 * m2 <= mT1 * mT2 - pT1 * pT2, it follows that
+// Q^2 >= 2 * mT1 * mT2 * (cosh(y1 - y2) - 1), for equal masses. With the
+// particles ordered in rapidity, partners need only be searched for up to
+// a maximal rapidity difference, which makes the search close to linear
+// in the number of particles when the rapidity range is large.
+
+void BoseEinstein::shiftClosePairs( int iBeg, int iEnd, int iTab) {
+
+  // Find rapidity and transverse mass, and the smallest of the latter.
+  int nNow = iEnd - iBeg;
+  if (nNow < 2) return;
+  yBE.resize(nNow);
+  mTBE.resize(nNow);
+  iOrderBE.resize(nNow);
+  double mTMin = 0.;
+  for (int i = 0; i < nNow; ++i) {
+    const Vec4& pNow = hadronBE[iBeg + i].p;
+    mTBE[i]     = sqrt( hadronBE[iBeg + i].m2 + pNow.pT2() );
+    yBE[i]      = (pNow.pz() > 0.) ? log( (pNow.e() + pNow.pz()) / mTBE[i] )
+                : log( mTBE[i] / (pNow.e() - pNow.pz()) );
+    iOrderBE[i] = i;
+    if (i == 0 || mTBE[i] < mTMin) mTMin = mTBE[i];
+  }
+  sort( iOrderBE.begin(), iOrderBE.end(),
+    [this](int i1, int i2) {return yBE[i1] < yBE[i2];} );
+
+  // Loop over particles in rapidity order, and partners within range.
+  for (int j1 = 0; j1 < nNow - 1; ++j1) {
+    int    i1    = iOrderBE[j1];
+    double dyMax = acosh( 1. + 0.5 * QCut2 / (mTBE[i1] * mTMin) );
+    for (int j2 = j1 + 1; j2 < nNow; ++j2) {
+      int i2 = iOrderBE[j2];
+      if (yBE[i2] - yBE[i1] > dyMax) break;
+
+      // Only pairs below the cut are shifted, in the standard order.
+      if (m2( hadronBE[iBeg + i1].p, hadronBE[iBeg + i2].p) - m2Pair[iTab]
+        > QCut2) continue;
+      shiftPair( iBeg + min( i1, i2), iBeg + max( i1, i2), iTab);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Calculate shift and (unnormalized) compensation for pair.
 
 void BoseEinstein::shiftPair( int i1, int i2, int iTab) {
@@ -152,6 +152,65 @@ void ColourParticle::listDips() {
 
 //==========================================================================
 
+// The RapidityBins class.
+
+//--------------------------------------------------------------------------
+
+// Set up equal bins between -yMax and yMax, and remove all objects.
+
+void RapidityBins::init(double yMaxIn, int nBinIn) {
+
+  yMax     = yMaxIn;
+  nBin     = nBinIn;
+  dyBinInv = 0.5 * nBin / yMax;
+  bins.resize(nBin);
+  for (int iBin = 0; iBin < nBin; ++iBin) bins[iBin].clear();
+  binMin.clear();
+  binMax.clear();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Add an object covering a rapidity range. If it is already stored,
+// it is first removed from its old bins.
+
+void RapidityBins::add(int iObj, double yMinObj, double yMaxObj) {
+
+  remove(iObj);
+  if (iObj >= int(binMin.size())) {
+    binMin.resize(iObj + 1, -1);
+    binMax.resize(iObj + 1, -1);
+  }
+  binMin[iObj] = bin(yMinObj);
+  binMax[iObj] = bin(yMaxObj);
+  for (int iBin = binMin[iObj]; iBin <= binMax[iObj]; ++iBin)
+    bins[iBin].push_back(iObj);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Remove an object from its bins. The order within a bin is not kept.
+
+void RapidityBins::remove(int iObj) {
+
+  if (iObj >= int(binMin.size()) || binMin[iObj] < 0) return;
+  for (int iBin = binMin[iObj]; iBin <= binMax[iObj]; ++iBin) {
+    vector<int>& binNow = bins[iBin];
+    for (int i = 0; i < int(binNow.size()); ++i) if (binNow[i] == iObj) {
+      binNow[i] = binNow.back();
+      binNow.pop_back();
+      break;
+    }
+  }
+  binMin[iObj] = -1;
+  binMax[iObj] = -1;
+
+}
+
+//==========================================================================
+
 // The ColourReconnection class.
 
 // Minimum needed gain in lambda for a reconnection (to avoid infinity loops).
@@ -168,12 +227,17 @@ const double ColourReconnection::TINYP1P2 = 1e-20;
 // are stacked on top of each other, this number needs to be raised.
 const int ColourReconnection::MAXRECONNECTIONS = 1000;
 
+// Rapidity range and number of bins for the optional local search.
+const double ColourReconnection::YMAXLOCAL = 10.;
+const int    ColourReconnection::NBINLOCAL = 40;
+
 //--------------------------------------------------------------------------
 
-// Simple comparison function for sort.
+// Simple comparison function for sort, giving the order of creation
+// of dipoles taken from the pool.
 
-bool cmpTrials(TrialReconnection j1, TrialReconnection j2) {
-    return (j1.lambdaDiff < j2.lambdaDiff);
+bool cmpDipoleIndex(ColourDipole* dip1, ColourDipole* dip2) {
+    return (dip1->index < dip2->index);
 }
 
 //--------------------------------------------------------------------------
@@ -203,6 +267,7 @@ bool ColourReconnection::init() {
   m0                  = parm("ColourReconnection:m0");
   m0sqr               = pow2(m0);
   allowJunctions      = flag("ColourReconnection:allowJunctions");
+  reuseDipoles        = flag("ColourReconnection:reuseDipoles");
   nReconCols          = mode("ColourReconnection:nColours");
   sameNeighbourCol    = flag("ColourReconnection:sameNeighbourColours");
   timeDilationMode    = mode("ColourReconnection:timeDilationMode");
@@ -215,6 +280,10 @@ bool ColourReconnection::init() {
   dLambdaCut          = parm("ColourReconnection:dLambdaCut");
   flipMode            = mode("ColourReconnection:flipMode");
 
+  // Optional local search in the MPI-based and gluon-move models.
+  localSearch         = flag("ColourReconnection:localSearch");
+  dyLocal             = parm("ColourReconnection:dyLocal");
+
   // Parameters of the e+e- CR models.
   singleReconOnly     = flag("ColourReconnection:singleReconnection");
   lowerLambdaOnly     = flag("ColourReconnection:lowerLambdaOnly");
@@ -266,11 +335,13 @@ bool ColourReconnection::next( Event& event, int iFirst) {
 
 bool ColourReconnection::nextNew( Event& event, int iFirst) {
 
-  // Clear old records.
-  while (!dipoles.empty()) {
+  // Clear old records. Pooled dipoles are kept for reuse.
+  if (reuseDipoles) dipoles.clear();
+  else while (!dipoles.empty()) {
     delete dipoles.back();
     dipoles.pop_back();
   }
+  nDipolePool = 0;
   particles.clear();
   junctions.clear();
   junTrials.clear();
@@ -307,7 +378,7 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
     bool finished = true;
 
     // Do inner loop for string reconnections
-    for (int iInnerLoop = 0;dipTrials.size() > 0; ++iInnerLoop) {
+    for (int iInnerLoop = 0; !dipTrials.empty(); ++iInnerLoop) {
 
       // Break if too many reonnections are carried out.
       if (iInnerLoop > MAXRECONNECTIONS) {
@@ -320,13 +391,17 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
 
       // Store all dipoles connected to the chosen dipole.
       usedDipoles.clear();
-      storeUsedDips(dipTrials.back());
+      storeUsedDips(dipTrials.top());
 
       // Do the reconnection.
-      doDipoleTrial(dipTrials.back());
+      doDipoleTrial(dipTrials.top());
+      dipTrials.pop();
 
       // Sort the used dipoles and remove copies of the same.
-      sort(usedDipoles.begin(), usedDipoles.end());
+      // Pooled dipoles in order of creation, else in order of address.
+      if (reuseDipoles)
+        sort(usedDipoles.begin(), usedDipoles.end(), cmpDipoleIndex);
+      else sort(usedDipoles.begin(), usedDipoles.end());
       for (int i = 0;i < int(usedDipoles.size() - 1); ++i)
         if (usedDipoles[i] == usedDipoles[i + 1]) {
           usedDipoles.erase(usedDipoles.begin() + i);
@@ -340,33 +415,28 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
     // Loop over list of dipoles to try and form junction structures.
     if (allowJunctions) {
 
-      // Split dipoles into three categories.
-      iDips.clear();
-      iDips.resize(3);
-      for (int i = 0; i < int(iDips.size()); ++i)
-        iDips[i] = vector<int>();
-
-      for (int i = 0; i < int(dipoles.size()); ++i)
-        if (dipoles[i]->isActive)
-          iDips[dipoles[i]->colReconnection % 3].push_back(i);
+      // Split dipoles that may form junctions into three categories.
+      findJunctionCandidates();
 
       // Loop over different "colours" (now only three different groups).
-      for (int i = 0;i < int(iDips.size()); ++i)
-        for (int j = 0; j < int(iDips[i].size()); ++j)
-          for (int k = j + 1; k < int(iDips[i].size()); ++k)
-            singleJunction(dipoles[iDips[i][j]], dipoles[iDips[i][k]]);
-
+      for (int i = 0;i < 3; ++i) {
+        vector<ColourDipole*>& group = junCandidates[i];
+        for (int j = 0; j < int(group.size()); ++j)
+          for (int k = j + 1; k < int(group.size()); ++k)
+            singleJunction(group[j], group[k]);
+      }
 
       // Loop over different "colours" (now only three different groups).
-      for (int i = 0;i < int(iDips.size()); ++i)
-        for (int j = 0; j < int(iDips[i].size()); ++j)
-          for (int k = j + 1; k < int(iDips[i].size()); ++k)
-            for (int l = k + 1; l < int(iDips[i].size()); ++l)
-              singleJunction(dipoles[iDips[i][j]], dipoles[iDips[i][k]],
-                                dipoles[iDips[i][l]]);
+      for (int i = 0;i < 3; ++i) {
+        vector<ColourDipole*>& group = junCandidates[i];
+        for (int j = 0; j < int(group.size()); ++j)
+          for (int k = j + 1; k < int(group.size()); ++k)
+            for (int l = k + 1; l < int(group.size()); ++l)
+              singleJunction(group[j], group[k], group[l]);
+      }
 
       // Do inner loop for junction reconnections
-      for (int iInnerLoop = 0;junTrials.size() > 0; ++iInnerLoop) {
+      for (int iInnerLoop = 0; !junTrials.empty(); ++iInnerLoop) {
 
         // Break if too many reonnections are carried out.
         if (iInnerLoop > MAXRECONNECTIONS) {
@@ -379,13 +449,16 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
 
         // Find all dipoles connected to the reconnection.
         usedDipoles.clear();
-        storeUsedDips(junTrials.back());
+        storeUsedDips(junTrials.top());
 
         // Do the reconnection.
-        doJunctionTrial(event, junTrials.back());
+        doJunctionTrial(event, junTrials.top());
+        junTrials.pop();
 
         // Sort the used dipoles and remove copies of the same.
-        sort(usedDipoles.begin(), usedDipoles.end());
+        if (reuseDipoles)
+          sort(usedDipoles.begin(), usedDipoles.end(), cmpDipoleIndex);
+        else sort(usedDipoles.begin(), usedDipoles.end());
         for (int i = 0;i < int(usedDipoles.size() - 1); ++i)
           if (usedDipoles[i] == usedDipoles[i + 1]) {
             usedDipoles.erase(usedDipoles.begin() + i);
@@ -412,6 +485,31 @@ bool ColourReconnection::nextNew( Event& event, int iFirst) {
 }
 
 
+//--------------------------------------------------------------------------
+
+// Get a new dipole, as a copy of the one given. The pool only grows
+// when more dipoles are needed than in earlier events, and dipoles keep
+// the memory of their vectors between events. Without the pool each
+// dipole is allocated, and deleted at the beginning of the next event.
+
+ColourDipole* ColourReconnection::newDipole(const ColourDipole& dipIn) {
+
+  ColourDipole* dip = 0;
+  if (!reuseDipoles) dip = new ColourDipole(dipIn);
+  else if (nDipolePool == int(dipolePool.size())) {
+    dipolePool.push_back(dipIn);
+    dip = &dipolePool.back();
+  } else {
+    dipolePool[nDipolePool] = dipIn;
+    dip = &dipolePool[nDipolePool];
+  }
+  dip->index        = nDipolePool++;
+  dip->usedStamp[0] = 0;
+  dip->usedStamp[1] = 0;
+  return dip;
+
+}
+
 //--------------------------------------------------------------------------
 
 // Setup initial guess on dipoles, here all colours are assumed
@@ -666,13 +764,13 @@ void ColourReconnection::setupDipoles( Event& event, int iFirst) {
         if (j == 0 && isAntiJun[i]) {
           int col = event.colJunction( - int(chains[i][j]/10) - 1,
                                        -chains[i][j] % 10);
-          dipoles.push_back(new ColourDipole(col, chains[i][j],
+          dipoles.push_back(newDipole(col, chains[i][j],
             chains[i][j+1], newCol));
           dipoles.back()->isAntiJun = true;
         }
 
         // Otherwise just make the dipole.
-        else dipoles.push_back(new ColourDipole(event[ chains[i][j] ].col(),
+        else dipoles.push_back(newDipole(event[ chains[i][j] ].col(),
           chains[i][j], chains[i][j+1], newCol));
 
         // If the chain in end a junction mark it.
@@ -696,7 +794,7 @@ void ColourReconnection::setupDipoles( Event& event, int iFirst) {
                 && !sameNeighbourCol) {
           newCol = int(rndmPtr->flat() * nReconCols);
         }
-        dipoles.push_back(new ColourDipole(event[ chains[i][j] ].col(),
+        dipoles.push_back(newDipole(event[ chains[i][j] ].col(),
           chains[i][j], chains[i][0], newCol));
 
         // Update links between dipoles.
@@ -949,8 +1047,7 @@ void ColourReconnection::singleReconnection(ColourDipole* dip1,
   // Insert into trial reconnection if anything is gained.
   if (lambdaDiff > MINIMUMGAIN) {
     TrialReconnection dipTrial(dip1, dip2, 0, 0, 5, lambdaDiff);
-    dipTrials.insert(lower_bound(dipTrials.begin(), dipTrials.end(),
-         dipTrial, cmpTrials), dipTrial);
+    dipTrials.push(dipTrial);
   }
 
 }
@@ -1072,8 +1169,7 @@ void ColourReconnection::singleJunction(ColourDipole* dip1,
   double lambdaDiff = getLambdaDiff(dip1, dip2, dip3, dip4, 0);
   if (lambdaDiff > MINIMUMGAINJUN) {
     TrialReconnection junTrial(dip1, dip2, dip3, dip4, 0, lambdaDiff);
-    junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-         junTrial, cmpTrials), junTrial);
+    junTrials.push(junTrial);
   }
   // Outer loop
   while (true) {
@@ -1094,8 +1190,7 @@ void ColourReconnection::singleJunction(ColourDipole* dip1,
         if (lambdaDiff > MINIMUMGAINJUN) {
 
           TrialReconnection junTrial(dip1, dip2, dip3, dip4, 1, lambdaDiff);
-          junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-             junTrial, cmpTrials), junTrial);
+          junTrials.push(junTrial);
         }
       }
 
@@ -1126,8 +1221,7 @@ void ColourReconnection::singleJunction(ColourDipole* dip1,
         if (lambdaDiff > MINIMUMGAINJUN) {
 
           TrialReconnection junTrial(dip1, dip2, dip3, dip4, 2, lambdaDiff);
-          junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(),
-             junTrial, cmpTrials), junTrial);
+          junTrials.push(junTrial);
         }
       }
 
@@ -1195,8 +1289,7 @@ void ColourReconnection::singleJunction(ColourDipole* dip1,
 
   if (lambdaDiff > MINIMUMGAINJUN) {
     TrialReconnection junTrial(dip1, dip2, dip3, 0, 3, lambdaDiff);
-    junTrials.insert(lower_bound(junTrials.begin(), junTrials.end(), junTrial,
-                                 cmpTrials), junTrial);
+    junTrials.push(junTrial);
   }
 
   // Done.
@@ -1571,7 +1664,7 @@ void ColourReconnection::makeAllPseudoParticles( Event & event, int iFirst) {
   // Make new copy of all the dipoles.
   int oldSize = int(dipoles.size());
   for (int i = 0; i < oldSize; ++i) {
-    dipoles.push_back(new ColourDipole(*dipoles[i]));
+    dipoles.push_back(newDipole(*dipoles[i]));
     dipoles[i + oldSize]->iColLeg = 0;
     dipoles[i + oldSize]->iAcolLeg = 0;
     dipoles[i]->iColLeg = 0;
@@ -1995,6 +2088,14 @@ bool ColourReconnection::checkTimeDilation(ColourDipole * dip1,
 // Find the momentum of the dipole.
 
 Vec4 ColourReconnection::getDipoleMomentum(ColourDipole * dip) {
+
+  // Simple case without junctions, summed in the same order as below.
+  if (!dip->isJun && !dip->isAntiJun) {
+    if (dip->iCol == dip->iAcol) return particles[dip->iCol].p();
+    return particles[min(dip->iCol, dip->iAcol)].p()
+      + particles[max(dip->iCol, dip->iAcol)].p();
+  }
+
   vector<int> iPar, usedJuncs;
   if (!dip->isJun) iPar.push_back(dip->iAcol);
   else addJunctionIndices(dip->iAcol, iPar, usedJuncs);
@@ -2349,6 +2450,46 @@ void ColourReconnection::listJunctions() {
 
 // ------------------------------------------------------------------
 
+// Set the rapidity range of a dipole or colour line from its two ends,
+// and store it in the bins, with the margin of the local search.
+
+void ColourReconnection::setLocalRange(int iObj, double y1, double y2) {
+
+  if (iObj >= int(yLocalMin.size())) {
+    yLocalMin.resize(iObj + 1);
+    yLocalMax.resize(iObj + 1);
+  }
+  yLocalMin[iObj] = min(y1, y2);
+  yLocalMax[iObj] = max(y1, y2);
+  localBins.add( iObj, yLocalMin[iObj] - dyLocal, yLocalMax[iObj] + dyLocal);
+
+}
+
+// ------------------------------------------------------------------
+
+// Store in iLocal the dipoles or colour lines to compare with at a given
+// rapidity, in increasing order. Without local search, or if none are
+// close enough, these are all of them.
+
+void ColourReconnection::selectLocal(double y, int nObj) {
+
+  iLocal.clear();
+  if (localSearch) {
+    const vector<int>& iObjs = localBins.objects(y);
+    for (int i = 0; i < int(iObjs.size()); ++i) {
+      int iObj = iObjs[i];
+      if (y > yLocalMin[iObj] - dyLocal && y < yLocalMax[iObj] + dyLocal)
+        iLocal.push_back(iObj);
+    }
+    sort(iLocal.begin(), iLocal.end());
+  }
+  if (iLocal.empty())
+    for (int iObj = 0; iObj < nObj; ++iObj) iLocal.push_back(iObj);
+
+}
+
+// ------------------------------------------------------------------
+
 // Allow colour reconnections by mergings of MPI collision subsystems.
 // iRec is system that may be reconnected, by moving its gluons to iSys,
 // where minimal pT (or equivalently Lambda) is used to pick location.
@@ -2461,6 +2602,14 @@ bool ColourReconnection::reconnectMPIs( Event&  event, int oldSize) {
       bmdipoles[iDip].p1p2 = event[bmdipoles[iDip].iCol].p()
                            * event[bmdipoles[iDip].iAcol].p();
 
+    // Optionally store the rapidity ranges of dipoles for a local search.
+    if (localSearch) {
+      localBins.init( YMAXLOCAL, NBINLOCAL);
+      for (int iDip = 0; iDip < int(bmdipoles.size()); ++iDip)
+        setLocalRange( iDip, event[bmdipoles[iDip].iCol].y(),
+          event[bmdipoles[iDip].iAcol].y() );
+    }
+
     // Loop over systems iRec to be merged with iSys.
     for (int iRec = iSys + 1; iRec < nSys; ++iRec) {
       if (iMerge[iRec] != iSys) continue;
@@ -2504,8 +2653,10 @@ bool ColourReconnection::reconnectMPIs( Event&  event, int oldSize) {
         Vec4   pGlu      = event[iGlu].p();
         int    iDipMin   = 0;
         double pT2DipMin = sCM;
-        for (int iDip = 0; iDip < int(bmdipoles.size()); ++iDip)
-        if (bmdipoles[iDip].p1p2 > TINYP1P2) {
+        selectLocal( event[iGlu].y(), bmdipoles.size());
+        for (int i = 0; i < int(iLocal.size()); ++i) {
+          int iDip = iLocal[i];
+          if (bmdipoles[iDip].p1p2 <= TINYP1P2) continue;
           double pT2Dip = (pGlu * event[bmdipoles[iDip].iCol].p())
             * (pGlu * event[bmdipoles[iDip].iAcol].p()) / bmdipoles[iDip].p1p2;
           if (pT2Dip < pT2DipMin) {
@@ -2528,6 +2679,11 @@ bool ColourReconnection::reconnectMPIs( Event&  event, int oldSize) {
         bmdipoles[iDipMin].p1p2 = event[iColDip].p() * pGlu;
         bmdipoles.push_back( BeamDipole( colGlu, iGlu, iAcolDip ) );
         bmdipoles.back().p1p2 = pGlu * event[iAcolDip].p();
+        if (localSearch) {
+          setLocalRange( iDipMin, event[iColDip].y(), event[iGlu].y());
+          setLocalRange( bmdipoles.size() - 1, event[iGlu].y(),
+            event[iAcolDip].y());
+        }
 
         // Remove gluon from old system: reconnect colours.
         for (int i = oldSize; i < event.size(); ++i)
@@ -2576,7 +2732,9 @@ bool ColourReconnection::reconnectMPIs( Event&  event, int oldSize) {
               Vec4   pGlu      = event[iQ].p() + event[iQbar].p();
               int    iDipMin   = 0;
               double pT2DipMin = sCM;
-              for (int iDip = 0; iDip < int(bmdipoles.size()); ++iDip) {
+              selectLocal( pGlu.rap(), bmdipoles.size());
+              for (int i = 0; i < int(iLocal.size()); ++i) {
+                int iDip = iLocal[i];
                 double pT2Dip = (pGlu * event[bmdipoles[iDip].iCol].p())
                   * (pGlu * event[bmdipoles[iDip].iAcol].p())
                   / bmdipoles[iDip].p1p2;
@@ -2600,6 +2758,12 @@ bool ColourReconnection::reconnectMPIs( Event&  event, int oldSize) {
               bmdipoles[iDipMin].p1p2 = event[iColDip].p() * event[iQbar].p();
               bmdipoles.push_back( BeamDipole( colGlu, iQ, iAcolDip ) );
               bmdipoles.back().p1p2 = event[iQ].p() * event[iAcolDip].p();
+              if (localSearch) {
+                setLocalRange( iDipMin, event[iColDip].y(),
+                  event[iQbar].y());
+                setLocalRange( bmdipoles.size() - 1, event[iQ].y(),
+                  event[iAcolDip].y());
+              }
 
               // Remove q-qbar pair from old system: reconnect colours.
               freeAnyRec[iQRec]    = false;
@@ -2693,7 +2857,8 @@ bool ColourReconnection::checkJunctionTrials() {
     int minus = 0;
     if (junTrials[i].mode == 3)
       minus = 1;
-    for (int j = 0;j < int(junTrials[i].dips.size()) - minus; ++j) {
+    if (!junTrials.isValid(junTrials[i])) continue;
+    for (int j = 0;j < 4 - minus; ++j) {
       ColourDipole* dip = junTrials[i].dips[j];
       if (dip->isJun || dip->isAntiJun) {
         junTrials[i].list();
@@ -2931,19 +3096,12 @@ void ColourReconnection::doDipoleTrial(TrialReconnection& trial) {
 
 void ColourReconnection::updateDipoleTrials() {
 
-  // Remove any dipTrials that contains an used dipole.
-  for (int i = 0; i < int(dipTrials.size()); ++i)
-    for (int j = 0;j < 2; ++j) {
-      if (binary_search(usedDipoles.begin(), usedDipoles.end(),
-                       dipTrials[i].dips[j]) ) {
-        dipTrials.erase(dipTrials.begin() + i);
-        i--;
-        break;
-      }
-    }
+  // Invalidate any dipTrials that contains an used dipole.
+  for (int i = 0; i < int(usedDipoles.size()); ++i)
+    dipTrials.setUsed(usedDipoles[i]);
 
   // Make list of active dipoles.
-  vector<ColourDipole*> activeDipoles;
+  activeDipoles.clear();
   for (int i = 0;i < int(dipoles.size()); ++i)
     if (dipoles[i]->isActive)
       activeDipoles.push_back(dipoles[i]);
@@ -2962,35 +3120,52 @@ void ColourReconnection::updateDipoleTrials() {
 
 void ColourReconnection::updateJunctionTrials() {
 
- // Remove any junTrials that contains an used dipole.
-  for (int i = 0; i < int(junTrials.size()); ++i)
-    for (int j = 0; j < 4; ++j) {
-      if (binary_search(usedDipoles.begin(), usedDipoles.end(),
-                       junTrials[i].dips[j]) ) {
-        junTrials.erase(junTrials.begin() + i);
-        i--;
-        break;
-      }
-    }
+  // Invalidate any junTrials that contains an used dipole.
+  for (int i = 0; i < int(usedDipoles.size()); ++i)
+    junTrials.setUsed(usedDipoles[i]);
 
-  // Make list of active dipoles.
-  vector<ColourDipole*> activeDipoles;
-  for (int i = 0;i < int(dipoles.size()); ++i)
-    if (dipoles[i]->isActive)
-      activeDipoles.push_back(dipoles[i]);
+  // Only the active dipoles in the same group can be used together.
+  findJunctionCandidates();
 
   // Loop over used dipoles and form new junction trials.
   for (int i = 0;i < int(usedDipoles.size()); ++i)
-    if (usedDipoles[i]->isActive)
-      for (int j = 0; j < int(activeDipoles.size()); ++j)
-        singleJunction(usedDipoles[i], activeDipoles[j]);
+    if (usedDipoles[i]->isActive) {
+      vector<ColourDipole*>& group
+        = junCandidates[usedDipoles[i]->colReconnection % 3];
+      for (int j = 0; j < int(group.size()); ++j)
+        singleJunction(usedDipoles[i], group[j]);
+    }
 
   // Loop over used dipoles and form new junction trials.
   for (int i = 0;i < int(usedDipoles.size()); ++i)
-    if (usedDipoles[i]->isActive)
-      for (int j = 0; j < int(activeDipoles.size()); ++j)
-        for (int k = j + 1; k < int(activeDipoles.size()); ++k)
-          singleJunction(usedDipoles[i], activeDipoles[j], activeDipoles[k]);
+    if (usedDipoles[i]->isActive) {
+      vector<ColourDipole*>& group
+        = junCandidates[usedDipoles[i]->colReconnection % 3];
+      for (int j = 0; j < int(group.size()); ++j)
+        for (int k = j + 1; k < int(group.size()); ++k)
+          singleJunction(usedDipoles[i], group[j], group[k]);
+    }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Split the active dipoles that may be part of a new junction into three
+// groups, according to colReconnection % 3. Other dipoles would anyhow
+// be rejected at the beginning of singleJunction, so the order and
+// outcome of the junction trials is unchanged.
+
+void ColourReconnection::findJunctionCandidates() {
+
+  junCandidates.resize(3);
+  for (int i = 0; i < 3; ++i) junCandidates[i].clear();
+  for (int i = 0; i < int(dipoles.size()); ++i) {
+    ColourDipole* dip = dipoles[i];
+    if (!dip->isActive || dip->isJun || dip->isAntiJun) continue;
+    if (int(particles[dip->iCol].dips.size()) != 1
+      || int(particles[dip->iAcol].dips.size()) != 1) continue;
+    junCandidates[dip->colReconnection % 3].push_back(dip);
+  }
 
 }
 
@@ -3067,28 +3242,28 @@ void ColourReconnection::doJunctionTrial(Event& event,
   // If the junction and antijunction are directly connected.
   int iActive1 = 0, iReal1 = 0;
   if (jtMode == 0) {
-    dipoles.push_back(new ColourDipole(newCol1, -( iAntiJun * 10 + 10 + 2) ,
+    dipoles.push_back(newDipole(newCol1, -( iAntiJun * 10 + 10 + 2) ,
       -( iJun * 10 + 10 + 2), junCol, true, true, false, true));
     iReal1 = dipoles.size() - 1;
-    dipoles.push_back(new ColourDipole(newCol1, -( iAntiJun * 10 + 10 + 2) ,
+    dipoles.push_back(newDipole(newCol1, -( iAntiJun * 10 + 10 + 2) ,
       -( iJun * 10 + 10 + 2), junCol, true, true));
     iActive1 = dipoles.size() - 1;
   } else if (jtMode == 1) {
     int iCol3real = particles[iCol3].dips[dip3->iColLeg].back()->iCol;
-     dipoles.push_back(new ColourDipole(newCol1, iCol3real ,
+     dipoles.push_back(newDipole(newCol1, iCol3real ,
       -( iJun * 10 + 10 + 2), junCol, true, false, false, true));
     iReal1 = dipoles.size() - 1;
     particles[iCol3].dips[dip3->iColLeg].back() = dipoles.back();
-    dipoles.push_back(new ColourDipole(newCol1, dip3->iCol,
+    dipoles.push_back(newDipole(newCol1, dip3->iCol,
       -( iJun * 10 + 10 + 2), junCol, true, false));
     iActive1 = dipoles.size() - 1;
   } else if (jtMode == 2) {
     int iCol4real = particles[iCol4].dips[dip4->iColLeg].back()->iCol;
-    dipoles.push_back(new ColourDipole(newCol1, iCol4real,
+    dipoles.push_back(newDipole(newCol1, iCol4real,
       -( iJun * 10 + 10 + 2), junCol, true, false, false, true));
     iReal1 = dipoles.size() - 1;
     particles[iCol4].dips[dip4->iColLeg].back() = dipoles.back();
-    dipoles.push_back(new ColourDipole(newCol1, dip4->iCol,
+    dipoles.push_back(newDipole(newCol1, dip4->iCol,
       -( iJun * 10 + 10 + 2), junCol, true, false));
     iActive1 = dipoles.size() - 1;
   }
@@ -3096,12 +3271,12 @@ void ColourReconnection::doJunctionTrial(Event& event,
   // Now make dipole between antijunction and iAcol1.
   // Start by finding real iAcol.
   int iAcol3real  = particles[iAcol3].dips[dip3->iAcolLeg].front()->iAcol;
-  dipoles.push_back(new ColourDipole(newCol2, -( iAntiJun * 10 + 10),
+  dipoles.push_back(newDipole(newCol2, -( iAntiJun * 10 + 10),
     iAcol3real, dip3->colReconnection, false, true, false, true));
   int iReal2 = dipoles.size() - 1;
   particles[iAcol3].dips[dip3->iAcolLeg].front() = dipoles.back();
 
-  dipoles.push_back(new ColourDipole(newCol2, -( iAntiJun * 10 + 10),
+  dipoles.push_back(newDipole(newCol2, -( iAntiJun * 10 + 10),
     iAcol3, dip3->colReconnection, false, true));
   dipoles.back()->iAcolLeg = dip3->iAcolLeg;
   int iActive2 = dipoles.size() - 1;
@@ -3109,12 +3284,12 @@ void ColourReconnection::doJunctionTrial(Event& event,
   // Now make dipole between antijunction and iAcol1.
   // Start by finding real iAcol.
   int iAcol4real = particles[iAcol4].dips[dip4->iAcolLeg].front()->iAcol;
-  dipoles.push_back(new ColourDipole(newCol3, -( iAntiJun * 10 + 10 + 1),
+  dipoles.push_back(newDipole(newCol3, -( iAntiJun * 10 + 10 + 1),
     iAcol4real, dip4->colReconnection, false, true, false, true));
   int iReal3 = dipoles.size() - 1;
   particles[iAcol4].dips[dip4->iAcolLeg].front() = dipoles.back();
 
-  dipoles.push_back(new ColourDipole(newCol3, -( iAntiJun * 10 + 10 + 1),
+  dipoles.push_back(newDipole(newCol3, -( iAntiJun * 10 + 10 + 1),
     iAcol4, dip4->colReconnection, false, true));
   dipoles.back()->iAcolLeg = dip4->iAcolLeg;
   int iActive3 = dipoles.size() - 1;
@@ -3397,12 +3572,12 @@ void ColourReconnection::doTripleJunctionTrial(Event& event,
   // Start by finding real iAcol.
   int iAcol1real
     = particles[iAcol1].dips[dip1->iAcolLeg].front()->iAcol;
-  dipoles.push_back(new ColourDipole(newCol1, -( iAntiJun * 10 + 10),
+  dipoles.push_back(newDipole(newCol1, -( iAntiJun * 10 + 10),
     iAcol1real, dip1->colReconnection, false, true, false, true));
   int iReal1 = dipoles.size() - 1;
   particles[iAcol1].dips[dip1->iAcolLeg].front() = dipoles.back();
 
-  dipoles.push_back(new ColourDipole(newCol1, -( iAntiJun * 10 + 10),
+  dipoles.push_back(newDipole(newCol1, -( iAntiJun * 10 + 10),
     iAcol1, dip1->colReconnection, false, true));
   dipoles.back()->iAcolLeg = dip1->iAcolLeg;
   int iActive1 = dipoles.size() - 1;
@@ -3411,12 +3586,12 @@ void ColourReconnection::doTripleJunctionTrial(Event& event,
   // Start by finding real iAcol2.
   int iAcol2real
     = particles[iAcol2].dips[dip2->iAcolLeg].front()->iAcol;
-  dipoles.push_back(new ColourDipole(newCol2, -( iAntiJun * 10 + 10 + 1),
+  dipoles.push_back(newDipole(newCol2, -( iAntiJun * 10 + 10 + 1),
     iAcol2real, dip2->colReconnection, false, true, false, true));
   int iReal2 = dipoles.size() - 1;
   particles[iAcol2].dips[dip2->iAcolLeg].front() = dipoles.back();
 
-  dipoles.push_back(new ColourDipole(newCol2, -( iAntiJun * 10 + 10 + 1),
+  dipoles.push_back(newDipole(newCol2, -( iAntiJun * 10 + 10 + 1),
     iAcol2, dip2->colReconnection, false, true));
   dipoles.back()->iAcolLeg = dip2->iAcolLeg;
   int iActive2 = dipoles.size() - 1;
@@ -3425,12 +3600,12 @@ void ColourReconnection::doTripleJunctionTrial(Event& event,
   // Start by finding real iAcol3.
   int iAcol3real
     = particles[iAcol3].dips[dip3->iAcolLeg].front()->iAcol;
-  dipoles.push_back(new ColourDipole(newCol3, -( iAntiJun * 10 + 10 + 2),
+  dipoles.push_back(newDipole(newCol3, -( iAntiJun * 10 + 10 + 2),
     iAcol3real, dip3->colReconnection, false, true, false, true));
   int iReal3 = dipoles.size() - 1;
   particles[iAcol3].dips[dip3->iAcolLeg].front() = dipoles.back();
 
-  dipoles.push_back(new ColourDipole(newCol3, -( iAntiJun * 10 + 10 + 2),
+  dipoles.push_back(newDipole(newCol3, -( iAntiJun * 10 + 10 + 2),
     iAcol3, dip3->colReconnection, false, true));
   dipoles.back()->iAcolLeg = dip3->iAcolLeg;
   int iActive3 = dipoles.size() - 1;
@@ -3618,6 +3793,21 @@ bool ColourReconnection::reconnectMove( Event&  event, int oldSize) {
     }
   }
 
+  // List the colour lines, optionally with their rapidity ranges
+  // stored for a local search, and the line of each colour.
+  vector<int> colLines;
+  map<int, int> lineOfCol;
+  if (localSearch) localBins.init( YMAXLOCAL, NBINLOCAL);
+  for (colM = colMap.begin(); colM != colMap.end(); ++colM) {
+    if (localSearch) setLocalRange( colLines.size(),
+      event[colM->second].y(), event[acolMap[colM->first]].y() );
+    lineOfCol[colM->first] = colLines.size();
+    colLines.push_back( colM->first);
+  }
+
+  // Gluon and colour line pairs already considered in a local search.
+  set< pair<int, int> > pairsLocal;
+
   // Set up initial possible gluon moves with lambda gains/losses.
   for (int iG = 0; iG < nGlu; ++iG) {
 
@@ -3631,9 +3821,11 @@ bool ColourReconnection::reconnectMove( Event&  event, int oldSize) {
     // Addition to Lambda of gluon in current position.
     lambdaRefNow = lambda123Move( iNow, iColNow, iAcolNow);
 
-    // Loop over all colour lines where gluon could be inserted.
-    for (colM = colMap.begin(); colM != colMap.end(); ++colM) {
-      col2Now   = colM->first;
+    // Loop over all colour lines where gluon could be inserted,
+    // or only the local ones.
+    selectLocal( event[iNow].y(), colLines.size());
+    for (int iLine = 0; iLine < int(iLocal.size()); ++iLine) {
+      col2Now   = colLines[iLocal[iLine]];
       iCol2Now  = colMap[col2Now];
       iAcol2Now = acolMap[col2Now];
 
@@ -3645,6 +3837,7 @@ bool ColourReconnection::reconnectMove( Event&  event, int oldSize) {
       // Add new container for gluon and colour line information.
       infoGM.push_back( InfoGluonMove( iNow, colNow, acolNow, iColNow,
         iAcolNow, col2Now, iCol2Now, iAcol2Now, lambdaRefNow, dLambdaNow ));
+      if (localSearch) pairsLocal.insert( make_pair( iNow, iLocal[iLine]) );
     }
   }
   int nPair = infoGM.size();
@@ -3721,6 +3914,36 @@ bool ColourReconnection::reconnectMove( Event&  event, int oldSize) {
           - tmpSM.lambdaRef;
     }
 
+    // In a local search, update the rapidity ranges of the three colour
+    // lines that were changed, and add the moves of gluons to them that
+    // now are close enough.
+    if (localSearch) for (int i = 0; i < 3; ++i) {
+      col2Now   = col2Mod[i];
+      iCol2Now  = colMap[col2Now];
+      iAcol2Now = acolMap[col2Now];
+      int iLine = lineOfCol[col2Now];
+      setLocalRange( iLine, event[iCol2Now].y(), event[iAcol2Now].y());
+      for (int iG = 0; iG < nGlu; ++iG) {
+        iNow = iGlu[iG];
+        double yNow = event[iNow].y();
+        if (yNow <= yLocalMin[iLine] - dyLocal
+          || yNow >= yLocalMax[iLine] + dyLocal
+          || !pairsLocal.insert( make_pair( iNow, iLine) ).second) continue;
+        colNow       = event[iNow].col();
+        acolNow      = event[iNow].acol();
+        iColNow      = acolMap[colNow];
+        iAcolNow     = colMap[acolNow];
+        lambdaRefNow = lambda123Move( iNow, iColNow, iAcolNow);
+        dLambdaNow   = (iCol2Now == iNow || iAcol2Now == iNow
+          || iColNow == iAcolNow) ? 2e4
+          : lambda123Move( iNow, iCol2Now, iAcol2Now) - lambdaRefNow;
+        infoGM.push_back( InfoGluonMove( iNow, colNow, acolNow, iColNow,
+          iAcolNow, col2Now, iCol2Now, iAcol2Now, lambdaRefNow,
+          dLambdaNow ));
+      }
+    }
+    nPair = infoGM.size();
+
   // End of loop over gluon shifting.
   }
 
@@ -27,6 +27,12 @@ const int DeuteronProduction::NTRYDECAY = 10;
 const double DeuteronProduction::WTCORRECTION[11] = { 1., 1., 1.,
   2., 5., 15., 60., 250., 1250., 7000., 50000. };
 
+// Number and range of logarithmic bins in k, where upper bounds of the
+// cross-sections are tabulated, to avoid calculating them for most pairs.
+const int DeuteronProduction::NKBIN = 800;
+const double DeuteronProduction::KBINMIN = 1e-3;
+const double DeuteronProduction::KBINMAX = 1e5;
+
 //--------------------------------------------------------------------------
 
 // Find settings. Precalculate table used to find momentum shifts.
@@ -134,6 +140,23 @@ bool DeuteronProduction::init() {
     if (s > max) max = s;
   }
 
+  // Tabulate upper bounds of the cross-sections in bins of k. Each bound
+  // also covers the neighbouring bins, and has a margin for rounding,
+  // while no bounds are used in the first and last bins.
+  sigmaMaxs.clear();
+  kBinScale = NKBIN / log(KBINMAX/KBINMIN);
+  for (int chn = 0; chn < int(ids.size()); ++chn) {
+    vector<double> sigmaMaxBin(NKBIN + 2,
+      std::numeric_limits<double>::infinity());
+    for (int bin = 0; bin < NKBIN; ++bin)
+      sigmaMaxBin[bin + 1] = sigmaMax(KBINMIN*exp(bin/kBinScale),
+        KBINMIN*exp((bin + 1)/kBinScale), chn);
+    sigmaMaxs.push_back(vector<double>(NKBIN, 0));
+    for (int bin = 0; bin < NKBIN; ++bin)
+      sigmaMaxs[chn][bin] = (1 + 1e-6) * std::max(sigmaMaxBin[bin],
+        std::max(sigmaMaxBin[bin + 1], sigmaMaxBin[bin + 2]));
+  }
+
   // Set normalization.
   norm = parm("DeuteronProduction:norm");
   if (norm < 1) norm = max;
@@ -194,22 +217,32 @@ void DeuteronProduction::bind(Event& event, vector<int>& prts) {
     Particle &prt1 = event[cmbs[cmb].second];
     if (prt0.status() < 0 || prt1.status() < 0) continue;
 
-    // Calculate the momentum difference.
+    // Find the bin of the momentum difference from the invariant masses,
+    // k^2 = lambda(s, m0^2, m1^2) / s, which is enough for the bounds.
     Vec4 p0(prt0.p()), p1(prt1.p()), p(p0 + p1);
-    p0.bstback(p);
-    p1.bstback(p);
-    double k((p0 - p1).pAbs());
+    double m02(p0.m2Calc()), m12(p1.m2Calc()), s(p.m2Calc());
+    int bin(s > 0 ? k2Bin((pow2(s - m02 - m12) - 4*m02*m12)/s) : -1);
 
-    // Try binding each channel.
-    double sum(0);
+    // Try binding each channel. The random number is picked first, so
+    // that the cross-section is only calculated if below its upper bound,
+    // and only then is the momentum difference calculated exactly.
+    double sum(0), k(-1);
     for (int chn = 0; chn < int(ids.size()); ++chn) {
-      if (prt0.idAbs() == ids[chn][0] && prt1.idAbs() == ids[chn][1])
-        sigmas[chn] = sigma(k, chn);
-      else {sigmas[chn] = 0; continue;}
+      if (prt0.idAbs() != ids[chn][0] || prt1.idAbs() != ids[chn][1])
+        {sigmas[chn] = 0; continue;}
+      double rndmNow(rndmPtr->flat());
+      if (bin >= 0 && rndmNow >= sigmaMaxs[chn][bin]/norm)
+        {sigmas[chn] = 0; continue;}
+      if (k < 0) {
+        p0.bstback(p);
+        p1.bstback(p);
+        k = (p0 - p1).pAbs();
+      }
+      sigmas[chn] = sigma(k, chn);
       if (sigmas[chn] > norm)
         infoPtr->errorMsg("Warning in DeuteronProduction::bind:",
           "maximum weight exceeded");
-      if (rndmPtr->flat() >= sigmas[chn]/norm) sigmas[chn] = 0;
+      if (rndmNow >= sigmas[chn]/norm) sigmas[chn] = 0;
       sum += sigmas[chn];
     }
 
@@ -299,6 +332,94 @@ double DeuteronProduction::sigma(double k, int chn) {
 
 //--------------------------------------------------------------------------
 
+// Upper bound of the single pion final state fit for x in [xLo, xHi],
+// from the monotonic power and exponential of x. Infinite if unknown.
+
+double DeuteronProduction::fitMax(double xLo, double xHi, vector<double>& c,
+  int i) {
+
+  // The power of x in the numerator.
+  double inf(std::numeric_limits<double>::infinity());
+  if (xLo <= 0 && c[i + 1] < 0) return inf;
+  double powLo(pow(xLo, c[i + 1])), powHi(pow(xHi, c[i + 1]));
+  double num(c[i] >= 0 ? c[i]*max(powLo, powHi) : c[i]*min(powLo, powHi));
+
+  // The denominator, smallest if the exponential crosses c[i + 2].
+  double expLo(exp(c[i + 3]*xLo)), expHi(exp(c[i + 3]*xHi));
+  if (expLo > expHi) swap(expLo, expHi);
+  double d2Lo(pow2(c[i + 2] - expLo)), d2Hi(pow2(c[i + 2] - expHi));
+  double denMin((c[i + 2] > expLo && c[i + 2] < expHi) ? c[i + 4]
+    : min(d2Lo, d2Hi) + c[i + 4]);
+  double denMax(max(d2Lo, d2Hi) + c[i + 4]);
+  if (denMin <= 0) return inf;
+  return num >= 0 ? num/denMin : num/denMax;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Upper bound of the cross-section for a given channel and k in
+// [kLo, kHi], following the models of sigma. Infinite if unknown.
+
+double DeuteronProduction::sigmaMax(double kLo, double kHi, int chn) {
+
+  double sum(0);
+  int model(models[chn]);
+  vector<double> &c = parms[chn];
+  vector<double> &m = masses[chn];
+  double inf(std::numeric_limits<double>::infinity());
+
+  // Vanishing below the phase-space threshold, where ecm rises with k.
+  double ecmLo(sqrt(m[0]*m[0] + kLo*kLo/4) + sqrt(m[1]*m[1] + kLo*kLo/4));
+  double ecmHi(sqrt(m[0]*m[0] + kHi*kHi/4) + sqrt(m[1]*m[1] + kHi*kHi/4));
+  double mtot(0);
+  for (int dtr = 3; dtr < int(m.size()); ++dtr) mtot += m[dtr];
+  if (ecmHi < mtot) return 0;
+
+  // Step function, e.g. coalescence model.
+  if (model == 0) {
+    sum = kLo < c[0] ? max(c[1], 0.) : 0;
+
+  // p n -> gamma d, term by term below the k-split and the largest
+  // exponent above it.
+  } else if (model == 1) {
+    if (kLo < c[0]) {
+      if (kLo <= 0) return inf;
+      for (int i = 1; i < 13; ++i)
+        sum += max(c[i]*pow(kLo, i - 2), c[i]*pow(kHi, i - 2));
+      sum = max(sum, 0.);
+    }
+    if (kHi >= c[0]) {
+      double kNow(max(kLo, c[0]));
+      double expMax(max(-c[13]*kNow - c[14]*kNow*kNow,
+          -c[13]*kHi - c[14]*kHi*kHi));
+      double kTop(c[14] > 0 ? -c[13]/(2*c[14]) : kNow);
+      if (kTop > kNow && kTop < kHi)
+        expMax = max(expMax, -c[13]*kTop - c[14]*kTop*kTop);
+      sum = max(sum, exp(expMax));
+    }
+
+  // p/n p/n -> pi d, where q rises with k if s is above
+  // |m_pi^2 - m_d^2|, as it is for the default channels.
+  } else if (model == 2)  {
+    double sLo(ecmLo*ecmLo), sHi(ecmHi*ecmHi);
+    if (sLo <= abs(m[3]*m[3] - m.back()*m.back())) return inf;
+    double qLo(sqrtpos(pow(sLo + m[3]*m[3] - m.back()*m.back(), 2)
+                       /(4*sLo) - m[3]*m[3]));
+    double qHi(sqrtpos(pow(sHi + m[3]*m[3] - m.back()*m.back(), 2)
+                       /(4*sHi) - m[3]*m[3]));
+    sum = fitMax(qLo/mPion, qHi/mPion, c, 0);
+
+  // p/n p/n -> pi pi d, term by term.
+  } else if (model == 3) {
+    for (int i = 0; i < int(c.size()); i += 5) sum += fitMax(kLo, kHi, c, i);
+  }
+  return isnan(sum) ? inf : sum*1e-3;
+
+}
+
+//--------------------------------------------------------------------------
+
 // N-body decay using the M-generator algorithm described in "Monte
 // Carlo Phase Space" by F. James in CERN 68-15, May 1968. Modified
 // from ParticleDecays::mGenerator.
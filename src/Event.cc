@@ -575,6 +575,35 @@ double m2(const Particle& pp1, const Particle& pp2) {
 
 //==========================================================================
 
+// EventColumns class.
+// This class holds the main particle properties of an event by column.
+
+//--------------------------------------------------------------------------
+
+// Set the number of particles in all columns.
+
+void EventColumns::resize(int sizeIn) {
+
+  nSave = max( 0, sizeIn);
+  id.resize(nSave);
+  status.resize(nSave);
+  mother1.resize(nSave);
+  mother2.resize(nSave);
+  daughter1.resize(nSave);
+  daughter2.resize(nSave);
+  px.resize(nSave);
+  py.resize(nSave);
+  pz.resize(nSave);
+  e.resize(nSave);
+  m.resize(nSave);
+  isCharged.resize(nSave);
+  isNeutral.resize(nSave);
+  isVisible.resize(nSave);
+
+}
+
+//==========================================================================
+
 // Event class.
 // This class holds info on the complete event record.
 
@@ -797,6 +826,49 @@ void Event::list(bool showScaleAndVertex, bool showMothersAndDaughters,
 
 //--------------------------------------------------------------------------
 
+// Copy the main particle properties into columns. Pointers to the
+// arrays are taken once, so that the loop only does plain copies.
+
+void Event::toColumns(EventColumns& columns) const {
+
+  int nSize = entry.size();
+  columns.resize(nSize);
+  int*    idNow   = columns.id.data();
+  int*    statNow = columns.status.data();
+  int*    mot1Now = columns.mother1.data();
+  int*    mot2Now = columns.mother2.data();
+  int*    dau1Now = columns.daughter1.data();
+  int*    dau2Now = columns.daughter2.data();
+  double* pxNow   = columns.px.data();
+  double* pyNow   = columns.py.data();
+  double* pzNow   = columns.pz.data();
+  double* eNow    = columns.e.data();
+  double* mNow    = columns.m.data();
+  char*   chgNow  = columns.isCharged.data();
+  char*   neuNow  = columns.isNeutral.data();
+  char*   visNow  = columns.isVisible.data();
+  for (int i = 0; i < nSize; ++i) {
+    const Particle& pNow = entry[i];
+    idNow[i]   = pNow.id();
+    statNow[i] = pNow.status();
+    mot1Now[i] = pNow.mother1();
+    mot2Now[i] = pNow.mother2();
+    dau1Now[i] = pNow.daughter1();
+    dau2Now[i] = pNow.daughter2();
+    pxNow[i]   = pNow.px();
+    pyNow[i]   = pNow.py();
+    pzNow[i]   = pNow.pz();
+    eNow[i]    = pNow.e();
+    mNow[i]    = pNow.m();
+    chgNow[i]  = pNow.isCharged();
+    neuNow[i]  = pNow.isNeutral();
+    visNow[i]  = pNow.isVisible();
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Erase junction stored in specified slot and move up the ones under.
 
 void Event::eraseJunction(int i) {
@@ -814,6 +814,9 @@ void StringFlav::init() {
         possibleHadronsLast[inPair]     = possibleHadronsNew;
       }
     }
+
+    // Store the lists in flat arrays for fast sampling.
+    initThermalTables();
   }
 
   // Initialize winning parameters.
@@ -919,6 +922,123 @@ FlavContainer StringFlav::pickGauss(FlavContainer& flavOld, bool allowPop) {
 
 //--------------------------------------------------------------------------
 
+// Store the lists of possible hadrons of the thermal model contiguously
+// in flat arrays, together with the (di)quark to use next time, so that
+// no maps or vectors need to be copied when a hadron is picked.
+
+void StringFlav::initThermalTables() {
+
+  // Reset arrays.
+  thermalRange.clear();
+  thermalRangeLast.clear();
+  thermalIDs.resize(0);
+  thermalIDsNext.resize(0);
+  thermalPrefacs.resize(0);
+  int nMax = 0;
+
+  // Lists for a single initial (di)quark.
+  for (map< int, vector< pair<int,int> > >::iterator
+    listNow = possibleHadrons.begin(); listNow != possibleHadrons.end();
+    ++listNow) {
+    int idIn = listNow->first;
+    vector<double>& prefacs = possibleRatePrefacs[idIn];
+    int iBeg = thermalIDs.size();
+    for (int iHad = 0; iHad < int(listNow->second.size()); ++iHad) {
+      int hadronID = listNow->second[iHad].first;
+      int iConst   = listNow->second[iHad].second;
+      // Flavour of (di)quark to use next time. Mesons use the first
+      // constituent pair, with diagonal mesons keeping the flavour.
+      vector< pair<int,int> >& constituentIDs = hadronConstIDs[hadronID];
+      if (particleDataPtr->isMeson(hadronID)) iConst = 0;
+      int idNext = 0;
+      if (iConst < int(constituentIDs.size())) {
+        int ID1 = constituentIDs[iConst].first;
+        int ID2 = constituentIDs[iConst].second;
+        if (particleDataPtr->isMeson(hadronID))
+          idNext = (ID1 == -ID2) ? idIn : (idIn == ID1 ? -ID2 : -ID1);
+        else {
+          if (ID1 == idIn) idNext = -ID2;
+          if (ID2 == idIn) idNext = -ID1;
+        }
+      }
+      thermalIDs.push_back( hadronID);
+      thermalIDsNext.push_back( idNext);
+      thermalPrefacs.push_back( prefacs[iHad]);
+    }
+    thermalRange[idIn] = make_pair( iBeg, int(thermalIDs.size()) );
+    nMax = max( nMax, int(thermalIDs.size()) - iBeg);
+  }
+
+  // Lists for the last two (di)quarks.
+  for (map< pair<int,int>, vector< pair<int,int> > >::iterator
+    listNow = possibleHadronsLast.begin();
+    listNow != possibleHadronsLast.end(); ++listNow) {
+    vector<double>& prefacs = possibleRatePrefacsLast[listNow->first];
+    int iBeg = thermalIDs.size();
+    for (int iHad = 0; iHad < int(listNow->second.size()); ++iHad) {
+      thermalIDs.push_back( listNow->second[iHad].first);
+      thermalIDsNext.push_back( 0);
+      thermalPrefacs.push_back( prefacs[iHad]);
+    }
+    thermalRangeLast[listNow->first]
+      = make_pair( iBeg, int(thermalIDs.size()) );
+    nMax = max( nMax, int(thermalIDs.size()) - iBeg);
+  }
+
+  // Work arrays large enough for the longest list.
+  thermalMasses.resize(nMax);
+  thermalRates.resize(nMax);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Pick one of the candidate hadrons in the range [iBeg, iEnd) of the
+// flat arrays, according to the thermal or mT2 suppression at given pT.
+// Masses are selected in order, so the random-number sequence agrees
+// with a per-candidate loop. Returns index and selected mass.
+
+int StringFlav::pickThermalIndex(int iBeg, int iEnd, double pT,
+  double temprNow, double sigmaNow, double& massPicked) {
+
+  // Calculate rates/suppression factors for given pT.
+  int nPossHads  = iEnd - iBeg;
+  double rateSum = 0.0;
+  for (int iHad = 0; iHad < nPossHads; iHad++) {
+    // Pick mass and calculate suppression factor.
+    double mass  = particleDataPtr->mSel(thermalIDs[iBeg + iHad],
+      rndmPtr);
+    thermalMasses[iHad] = mass;
+    double rate  = (mT2suppression)
+      ? exp( -(pow2(pT)+pow2(mass))/pow2(sigmaNow) )
+      : exp( -sqrt(pow2(pT)+pow2(mass))/temprNow );
+    // Multiply rate with prefactor, save it and add to sum.
+    rate *= thermalPrefacs[iBeg + iHad];
+    thermalRates[iHad] = rate;
+    rateSum += rate;
+  }
+
+  // Random number to decide which hadron to pick, compared with the
+  // accumulated normalized rates. Last one if rounding leaves a gap.
+  double rand  = rndmPtr->flat();
+  double accum = 0.0;
+  int iPick    = nPossHads - 1;
+  for (int iHad = 0; iHad < nPossHads; iHad++) {
+    accum += thermalRates[iHad] / rateSum;
+    if (rand <= accum) {
+      iPick = iHad;
+      break;
+    }
+  }
+
+  // Done.
+  massPicked = thermalMasses[iPick];
+  return iBeg + iPick;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Pick a hadron, based on generated pT value and initial (di)quark.
 // Check all possible hadrons and calculate their relative suppression
 // based on exp(-mThadron/T), possibly multiplied by spin counting, meson
@@ -959,81 +1079,22 @@ FlavContainer StringFlav::pickThermal(FlavContainer& flavOld,
     sigmaNow     *= pow(max(1.0,nNSP), exponentNSP);
   }
 
-  // Get the list of allowed hadrons and constituents for that
-  // initial (di)quark. First parameter of pair is hadron ID, second
-  // is nr of hadron constituents in the list.
-  vector<double> possibleRatePrefacsNow      = possibleRatePrefacs[idIn];
-  vector< pair<int,int> > possibleHadronsNow = possibleHadrons[idIn];
-  int nPossHads = int(possibleHadronsNow.size());
-  if (nPossHads < 1) {
+  // Get the range of allowed hadrons for that initial (di)quark.
+  map< int, pair<int,int> >::const_iterator rangeNow
+    = thermalRange.find(idIn);
+  if (rangeNow == thermalRange.end()
+    || rangeNow->second.first >= rangeNow->second.second) {
     infoPtr->errorMsg("Error in StringFlav::pickThermal: no possible "
       "hadrons found");
     return 0;
   }
 
-  // Vector with hadron masses. Is -1.0 if m0 is use for calculating
-  // the suppression rate and mSel if mSel is used.
-  vector<double> possibleHadronMasses;
-
-  // Calculate rates/suppression factors for given pT.
-  vector<double> rates;
-  double rateSum = 0.0;
-  for (int iHad = 0; iHad < nPossHads; iHad++) {
-    int hadronID = possibleHadronsNow[iHad].first;
-    // Pick mass and calculate suppression factor.
-    double mass  = particleDataPtr->mSel(hadronID);
-    possibleHadronMasses.push_back(mass);
-    double rate  = exp( -sqrt(pow2(pT)+pow2(mass))/temprNow );
-    // mT2 suppression with Gaussian pT?
-    if (mT2suppression) rate = exp( -(pow2(pT)+pow2(mass))/pow2(sigmaNow) );
-    // Multiply rate with prefactor.
-    rate *= possibleRatePrefacsNow[iHad];
-    // Save rate and add to sum
-    rates.push_back(rate);
-    rateSum += rate;
-  }
-  // Normalize rates
-  for (int iHad = 0; iHad < nPossHads; iHad++) rates[iHad] /= rateSum;
-
-  // Get accumulated rates
-  vector<double> accumRates;
-  for (int iHad = 0; iHad < nPossHads; iHad++) accumRates.push_back(0);
-  for (int iHad1 = 0; iHad1 < nPossHads; iHad1++)
-    for (int iHad2 = 0; iHad2 <= iHad1; iHad2++)
-      accumRates[iHad1] += rates[iHad2];
-
-  // Random number to decide which hadron to pick
-  double rand       = rndmPtr->flat();
-  int hadronID      = 0;
-  int iConst        = 0;
+  // Pick hadron and get flavour of (di)quark to use next time.
   double hadronMass = -1.0;
-  for (int iHad = 0; iHad < nPossHads; iHad++) {
-    if (rand <= accumRates[iHad]) {
-      hadronID   = possibleHadronsNow[iHad].first;
-      iConst     = possibleHadronsNow[iHad].second;
-      hadronMass = possibleHadronMasses[iHad];
-      break;
-    }
-  }
-
-  // Get flavour of (di)quark to use next time.
-  int idNext = 0;
-  vector< pair<int,int> > constituentIDs = hadronConstIDs[hadronID];
-  // Mesons
-  if (particleDataPtr->isMeson(hadronID)) {
-    int ID1 = constituentIDs[0].first;
-    int ID2 = constituentIDs[0].second;
-    // Special case for diagonal meson, flavour remains
-    if (ID1 == -ID2) idNext = idIn;
-    else idNext = (idIn == ID1 ? -ID2 : -ID1);
-  }
-  // Baryons
-  else {
-    int ID1 = constituentIDs[iConst].first;
-    int ID2 = constituentIDs[iConst].second;
-    if (ID1 == idIn) idNext = -ID2;
-    if (ID2 == idIn) idNext = -ID1;
-  }
+  int iPick    = pickThermalIndex( rangeNow->second.first,
+    rangeNow->second.second, pT, temprNow, sigmaNow, hadronMass);
+  int hadronID = thermalIDs[iPick];
+  int idNext   = thermalIDsNext[iPick];
 
   // Save new flavour and hadron.
   flavNew.id    = -idNext;  // id used to build hadron
@@ -1228,61 +1289,21 @@ int StringFlav::combineLastThermal(FlavContainer& flav1, FlavContainer& flav2,
     sigmaNow     *= pow(max(1.0,nNSP), exponentNSP);
   }
 
-  // Get the list of allowed hadrons and constituents for that combination
-  // of (di)quarks. First parameter of pair is hadron ID, second
-  // is nr of hadron constituents in the list.
+  // Get the range of allowed hadrons for that combination of (di)quarks.
   pair<int,int> inPr = pair<int,int>(idInNow[0], idInNow[1]);
-  vector<double> possibleRatePrefacsNow      = possibleRatePrefacsLast[inPr];
-  vector< pair<int,int> > possibleHadronsNow = possibleHadronsLast[inPr];
-  int nPossHads = int(possibleHadronsNow.size());
-  if (nPossHads < 1) {
+  map< pair<int,int>, pair<int,int> >::const_iterator rangeNow
+    = thermalRangeLast.find(inPr);
+  if (rangeNow == thermalRangeLast.end()
+    || rangeNow->second.first >= rangeNow->second.second) {
     infoPtr->errorMsg("Error in StringFlav::combineLastThermal: no "
       "possible hadrons found for last two");
     return 0;
   }
 
-  // Vector with hadron masses. Is -1.0 if m0 is use for calculating
-  // the suppression rate and mSel if mSel is used.
-  vector<double> possibleHadronMasses;
-
-  // Calculate rates/suppression factors for given pT.
-  vector<double> rates;
-  double rateSum = 0.0;
-  for (int iHad = 0; iHad < nPossHads; iHad++) {
-    int hadronID = possibleHadronsNow[iHad].first;
-    // Pick mass and calculate suppression factor.
-    double mass = particleDataPtr->mSel(hadronID);
-    possibleHadronMasses.push_back(mass);
-    double rate = exp( -sqrt(pow2(pT)+pow2(mass))/temprNow );
-    // mT2 suppression with Gaussian pT?
-    if (mT2suppression) rate = exp( -(pow2(pT)+pow2(mass))/pow2(sigmaNow) );
-    // Multiply rate with prefactor.
-    rate *= possibleRatePrefacsNow[iHad];
-    // Save rate and add to sum
-    rates.push_back(rate);
-    rateSum += rate;
-  }
-  // Normalize rates
-  for (int iHad = 0; iHad < nPossHads; iHad++) rates[iHad] /= rateSum;
-
-  // Get accumulated rates
-  vector<double> accumRates;
-  for (int iHad = 0; iHad < nPossHads; iHad++) accumRates.push_back(0);
-  for (int iHad1 = 0; iHad1 < nPossHads; iHad1++)
-    for (int iHad2 = 0; iHad2 <= iHad1; iHad2++)
-      accumRates[iHad1] += rates[iHad2];
-
-  // Random number to decide which hadron to pick
-  double rand       = rndmPtr->flat();
-  int hadronID      = 0;
+  // Pick hadron.
   double hadronMass = -1.0;
-  for (int iHad = 0; iHad < nPossHads; iHad++) {
-    if (rand <= accumRates[iHad]) {
-      hadronID   = possibleHadronsNow[iHad].first;
-      hadronMass = possibleHadronMasses[iHad];
-      break;
-    }
-  }
+  int hadronID = thermalIDs[ pickThermalIndex( rangeNow->second.first,
+    rangeNow->second.second, pT, temprNow, sigmaNow, hadronMass) ];
 
   // Save hadron.
   hadronIDwin   = hadronID;
@@ -1370,6 +1391,24 @@ const double StringZ::AFROMC     = 0.01;
 // Do not take exponent of too large or small number.
 const double StringZ::EXPMAX     = 50.;
 
+// Number of flavour classes: (light, c, b) * (old kind) * (new kind).
+const int    StringZ::NCLASSLUND = 27;
+
+// Range of b = bLund * mT2 covered by the optional tables, and number
+// of logarithmically spaced b values in it.
+const double StringZ::BTABLEMIN  = 0.01;
+const double StringZ::BTABLEMAX  = 50.;
+const int    StringZ::NBTABLE    = 128;
+
+// Number of intervals in the cumulative fraction of each table, where
+// the first and last are subdivided into as many again, and number of
+// ln(z) intervals used for the numerical integration behind it.
+const int    StringZ::NUTABLE    = 128;
+const int    StringZ::NZINTEGRAL = 4000;
+
+// Lower z limit of the integration, for very small b values.
+const double StringZ::ZTABLEMIN  = 1e-10;
+
 //--------------------------------------------------------------------------
 
 // Initialize data members of the string z selection.
@@ -1422,6 +1461,52 @@ void StringZ::init() {
   stopNF        = parm("StringFragmentation:stopNewFlav");
   stopS         = parm("StringFragmentation:stopSmear");
 
+  // Shape parameters of the Lund function for light, c and b flavour
+  // classes, with the old and new flavour either (0) a u/d quark or
+  // other, (1) an s quark or (2) a diquark.
+  aClass.resize(NCLASSLUND);
+  bClass.resize(NCLASSLUND);
+  cClass.resize(NCLASSLUND);
+  for (int iClass = 0; iClass < NCLASSLUND; ++iClass) {
+    int iFrag = iClass / 9;
+    int iOld  = (iClass / 3) % 3;
+    int iNew  = iClass % 3;
+    double aNow = aLund;
+    double bNow = bLund;
+    if (iFrag == 1 && useNonStandC) {
+      aNow = aNonC;
+      bNow = bNonC;
+    } else if (iFrag == 2 && useNonStandB) {
+      aNow = aNonB;
+      bNow = bNonB;
+    }
+    // Same order of operations as in zFrag for other flavours.
+    double aShape = aNow;
+    if (iOld == 1) aShape += aExtraSQuark;
+    if (iOld == 2) aShape += aExtraDiquark;
+    double cShape = 1.;
+    if (iOld == 1) cShape -= aExtraSQuark;
+    if (iNew == 1) cShape += aExtraSQuark;
+    if (iOld == 2) cShape -= aExtraDiquark;
+    if (iNew == 2) cShape += aExtraDiquark;
+    if (iFrag == 1) cShape += rFactC * bNow * mc2;
+    if (iFrag == 2) cShape += rFactB * bNow * mb2;
+    aClass[iClass] = aShape;
+    bClass[iClass] = bNow;
+    cClass[iClass] = cShape;
+  }
+
+  // Optional tables of the Lund function. Only keep existing tables when
+  // the shape parameters are unchanged, e.g. after a re-initialization.
+  useLundTable  = flag("StringZ:useLundTable");
+  dLogBTable    = log(BTABLEMAX / BTABLEMIN) / (NBTABLE - 1);
+  lundTable.resize(NCLASSLUND);
+  aTable.resize(NCLASSLUND, 0.);
+  cTable.resize(NCLASSLUND, 0.);
+  for (int iClass = 0; iClass < NCLASSLUND; ++iClass)
+  if (!useLundTable || aTable[iClass] != aClass[iClass]
+    || cTable[iClass] != cClass[iClass]) lundTable[iClass].resize(0);
+
 }
 
 //--------------------------------------------------------------------------
@@ -1498,7 +1583,17 @@ double StringZ::zFrag( int idOld, int idNew, double mT2) {
     return zPeterson( epsilon);
   }
 
-  // Nonstandard a and b values implemented for heavy flavours.
+  // Light, c and b flavours use precomputed shape parameters.
+  if (idFrag < 6) {
+    int iClass = 9 * max( 0, idFrag - 3)
+      + 3 * (isOldDiquark ? 2 : (isOldSQuark ? 1 : 0))
+      + (isNewDiquark ? 2 : (isNewSQuark ? 1 : 0));
+    double bShape = bClass[iClass] * mT2;
+    if (useLundTable) return zLundTable( iClass, bShape);
+    return zLund( aClass[iClass], bShape, cClass[iClass]);
+  }
+
+  // Nonstandard a and b values implemented for heavier flavours.
   double aNow = aLund;
   double bNow = bLund;
   if (idFrag == 4 && useNonStandC) {
@@ -1625,6 +1720,116 @@ double StringZ::zLund( double a, double b, double c) {
 
 //--------------------------------------------------------------------------
 
+// Build the table of ln(z) values at equidistant cumulative fractions of
+// the Lund function, for each b value of the grid, for a flavour class.
+// The function times z is integrated with the trapezoidal rule over a
+// uniform grid in ln(z), and the cumulative integral is inverted by
+// linear interpolation.
+
+void StringZ::initLundTable( int iClass) {
+
+  // Shape parameters and storage.
+  double a     = aClass[iClass];
+  double c     = cClass[iClass];
+  bool aIsZero = (a < AFROMZERO);
+  aTable[iClass] = a;
+  cTable[iClass] = c;
+  vector<double>& table = lundTable[iClass];
+  table.resize( NBTABLE * 3 * (NUTABLE + 1) );
+  vector<double> xVal(NZINTEGRAL + 1), fCum(NZINTEGRAL + 1);
+
+  // Loop over b values. Lower end where exp(-b/z) is negligible.
+  for (int iB = 0; iB < NBTABLE; ++iB) {
+    double b    = BTABLEMIN * exp( iB * dLogBTable);
+    double xMin = log( max( ZTABLEMIN, min( 0.5, b / (2. * EXPMAX) ) ) );
+
+    // Logarithm of f(z) * z on the grid, and its maximum.
+    for (int iZ = 0; iZ <= NZINTEGRAL; ++iZ) {
+      double x = xMin * (1. - double(iZ) / NZINTEGRAL);
+      double z = exp(x);
+      double fExp = -b / z + (1. - c) * x;
+      if (!aIsZero) fExp += (z < 1.) ? a * log(1. - z) : -1e10;
+      xVal[iZ] = x;
+      fCum[iZ] = fExp;
+    }
+    double fExpMax = fCum[0];
+    for (int iZ = 1; iZ <= NZINTEGRAL; ++iZ)
+      fExpMax = max( fExpMax, fCum[iZ]);
+
+    // Cumulative integral, normalized to unity.
+    double fPrev = exp( max( -2. * EXPMAX, fCum[0] - fExpMax) );
+    fCum[0] = 0.;
+    for (int iZ = 1; iZ <= NZINTEGRAL; ++iZ) {
+      double fNow = exp( max( -2. * EXPMAX, fCum[iZ] - fExpMax) );
+      fCum[iZ] = fCum[iZ - 1] + 0.5 * (fPrev + fNow);
+      fPrev = fNow;
+    }
+    for (int iZ = 1; iZ <= NZINTEGRAL; ++iZ) fCum[iZ] /= fCum[NZINTEGRAL];
+
+    // Invert to find ln(z) at equidistant cumulative fractions, for
+    // the full range and for finer steps inside the first and last step.
+    double* xNow = &table[iB * 3 * (NUTABLE + 1)];
+    for (int iRange = 0; iRange < 3; ++iRange)
+    for (int iU = 0; iU <= NUTABLE; ++iU) {
+      double u = (iRange == 0) ? double(iU) / NUTABLE
+               : double(iU) / pow2(NUTABLE);
+      if (iRange == 2) u += 1. - 1. / NUTABLE;
+      int iZ = upper_bound( fCum.begin(), fCum.end(), u) - fCum.begin() - 1;
+      iZ = max( 0, min( NZINTEGRAL - 1, iZ));
+      double dCum = fCum[iZ + 1] - fCum[iZ];
+      double wt   = (dCum > 0.) ? min( 1., max( 0., (u - fCum[iZ]) / dCum))
+                  : 0.5;
+      *(xNow++) = xVal[iZ] + wt * (xVal[iZ + 1] - xVal[iZ]);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate a random z according to the Lund function of a flavour class
+// from its table, interpolating linearly in ln(b) and in the cumulative
+// fraction. Use the accept-reject method of zLund outside the table.
+
+double StringZ::zLundTable( int iClass, double b) {
+
+  // Outside the tabulated range, or for extremes, use zLund.
+  if (b <= BTABLEMIN || b >= BTABLEMAX)
+    return zLund( aClass[iClass], b, cClass[iClass]);
+  if (lundTable[iClass].size() == 0) initLundTable( iClass);
+
+  // Position in the b grid and in the cumulative fraction.
+  double bPos = log(b / BTABLEMIN) / dLogBTable;
+  int    iB   = min( NBTABLE - 2, int(bPos));
+  double wB   = bPos - iB;
+  // The first and last steps are subdivided for a better description
+  // of the tails.
+  double uPos = rndmPtr->flat() * NUTABLE;
+  int    iU   = min( NUTABLE - 1, int(uPos));
+  int    iRow = 0;
+  if (iU == 0 || iU == NUTABLE - 1) {
+    iRow = (iU == 0) ? 1 : 2;
+    uPos = (uPos - iU) * NUTABLE;
+    iU   = min( NUTABLE - 1, int(uPos));
+  }
+  double wU   = uPos - iU;
+
+  // Bilinear interpolation of ln(z).
+  const double* x0
+    = &lundTable[iClass][(3 * iB + iRow) * (NUTABLE + 1) + iU];
+  const double* x1 = x0 + 3 * (NUTABLE + 1);
+  double x = (1. - wB) * ( (1. - wU) * x0[0] + wU * x0[1] )
+           + wB * ( (1. - wU) * x1[0] + wU * x1[1] );
+  double z = exp(x);
+
+  // Done, unless rounding gave a z at the upper edge.
+  if (z < 1.) return z;
+  return zLund( aClass[iClass], b, cClass[iClass]);
+
+}
+
+//--------------------------------------------------------------------------
+
 // Generate a random z according to the Peterson/SLAC formula
 // f(z) = 1 / ( z * (1 - 1/z - epsilon/(1-z))^2 )
 //      = z * (1-z)^2 / ((1-z)^2 + epsilon * z)^2.
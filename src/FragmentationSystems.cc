@@ -418,6 +418,45 @@ int ColConfig::findSinglet(int i) {
 
 //--------------------------------------------------------------------------
 
+// Store the rapidity ranges of string pieces. Also sort the lower and
+// upper ends of the non-empty ones separately, so that the number of
+// ranges around a given rapidity can be found by binary search.
+
+void ColConfig::setRapPairs(
+  const vector< vector< pair<double,double> > >& rapPairsIn) {
+
+  rapPairs = rapPairsIn;
+  yMinSorted.clear();
+  yMaxSorted.clear();
+  for (const vector< pair<double,double> >& rapsNow : rapPairs)
+  for (const pair<double,double>& rapNow : rapsNow)
+  if (rapNow.first < rapNow.second) {
+    yMinSorted.push_back( rapNow.first);
+    yMaxSorted.push_back( rapNow.second);
+  }
+  sort( yMinSorted.begin(), yMinSorted.end());
+  sort( yMaxSorted.begin(), yMaxSorted.end());
+
+}
+
+//--------------------------------------------------------------------------
+
+// Number of string pieces with y_min < y < y_max. For a non-empty range
+// y_max <= y implies y_min < y, so it is the number of lower ends below
+// y minus the number of upper ends at or below it.
+
+int ColConfig::nRapPairs(double y) const {
+
+  int nBelow = lower_bound( yMinSorted.begin(), yMinSorted.end(), y)
+    - yMinSorted.begin();
+  int nAbove = upper_bound( yMaxSorted.begin(), yMaxSorted.end(), y)
+    - yMaxSorted.begin();
+  return nBelow - nAbove;
+
+}
+
+//--------------------------------------------------------------------------
+
 // List all currently identified singlets.
 
 void ColConfig::list() const {
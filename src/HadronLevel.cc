@@ -67,6 +67,16 @@ bool HadronLevel::init( TimeShowerPtr timesDecPtr, RHadrons* rHadronsPtrIn,
   doBoseEinstein  = flag("HadronLevel:BoseEinstein");
   doDeuteronProd  = flag("HadronLevel:DeuteronProduction");
 
+  // Optionally keep decays pending until asked for. Not possible when
+  // later steps need the decay products, or without internal streams.
+  doLazyDecays    = doDecay && flag("HadronLevel:lazyDecays");
+  if (doLazyDecays && (doRescatter || doBoseEinstein || doDeuteronProd
+    || rndmPtr->useExternal())) {
+    infoPtr->errorMsg("Warning in HadronLevel::init: "
+      "lazy decays not possible with current settings; switched off");
+    doLazyDecays = false;
+  }
+
   // Boundary mass between string and ministring handling.
   mStringMin      = parm("HadronLevel:mStringMin");
 
@@ -91,6 +101,16 @@ bool HadronLevel::init( TimeShowerPtr timesDecPtr, RHadrons* rHadronsPtrIn,
     stringInteractionsPtrIn->getFragmentationModifier();
   stringRepulsionPtr = stringInteractionsPtrIn->getStringRepulsion();
 
+  // Tables of the Lund function would be rebuilt for each hadron when
+  // fragmentation parameters change from one hadron to the next.
+  if (flag("StringZ:useLundTable") && (fragmentationModifierPtr
+    || (userHooksPtr && userHooksPtr->canChangeFragPar()))) {
+    infoPtr->errorMsg("Warning in HadronLevel::init: "
+      "Lund function tables not possible with varying fragmentation "
+      "parameters; switched off");
+    settingsPtr->flag("StringZ:useLundTable", false);
+  }
+
   // Initialize auxiliary fragmentation classes.
   flavSel.init();
   pTSel.init();
@@ -103,6 +123,14 @@ bool HadronLevel::init( TimeShowerPtr timesDecPtr, RHadrons* rHadronsPtrIn,
   stringFrag.init(&flavSel, &pTSel, &zSel, fragmentationModifierPtr);
   ministringFrag.init(&flavSel, &pTSel, &zSel);
 
+  // Optionally fragment independent systems concurrently. Not when
+  // fragmentation parameters may be changed from one string to the next.
+  doParallelFrag  = flag("StringFragmentation:parallel")
+    && !fragmentationModifierPtr
+    && !(userHooksPtr && userHooksPtr->canChangeFragPar());
+  if (doParallelFrag)
+    parallelFrag.init( mode("StringFragmentation:numThreads"));
+
   // Initialize particle decays.
   decays.init(timesDecPtr, &flavSel, decayHandlePtr, handledParticles);
 
@@ -178,6 +206,7 @@ bool HadronLevel::next( Event& event) {
 
   // Store current event size to mark Parton Level content.
   event.savePartonLevelSize();
+  seedLazy.clear();
 
   // Do Hidden-Valley fragmentation, if necessary.
   if (useHiddenValley) hiddenvalleyFrag.fragment(event);
@@ -204,74 +233,12 @@ bool HadronLevel::next( Event& event) {
     decaysCausedHadronization = false;
 
     // First part: string fragmentation.
-    if (doHadronize) {
-
-      // Find the complete colour singlet configuration of the event.
-      // Keep junctions if we do shoving.
-      if (!findSinglets( event, (stringRepulsionPtr != nullptr) ))
-        return false;
-
-      // Fragment off R-hadrons, if necessary.
-      if (allowRH && !rHadronsPtr->produce( colConfig, event))
-        return false;
-
-      // Save list with rapidity pairs of the different string pieces.
-      if (closePacking) {
-        vector< vector< pair<double,double> > > rapPairs =
-          rapidityPairs(event);
-        colConfig.rapPairs = rapPairs;
-      }
-
-      // Let strings interact in rope hadronization treatment.
-      // Do the shoving treatment.
-      if ( stringRepulsionPtr ) {
-
-        // Extract all string segments from the event and do the
-        // string reulsion.
-        stringRepulsionPtr->stringRepulsion(event, colConfig);
-
-        // Find singlets again.
-        iParton.resize(0);
-        colConfig.clear();
-        if (!findSinglets( event)) {
-          infoPtr->errorMsg("Error in HadronLevel::next: "
-            "ropes: failed 2nd singlet tracing.");
-          return false;
-        }
-      }
-
-      // Prepare for flavour ropes.
-      if (fragmentationModifierPtr)
-        fragmentationModifierPtr->initEvent(event, colConfig);
-
-      // Process all colour singlet (sub)systems.
-      for (int iSub = 0; iSub < colConfig.size(); ++iSub) {
-
-        // Collect sequentially all partons in a colour singlet subsystem.
-        colConfig.collect(iSub, event);
-        int nBefFrag = event.size();
-
-        // String fragmentation of each colour singlet (sub)system.
-        if ( colConfig[iSub].massExcess > mStringMin ) {
-          if (!stringFrag.fragment( iSub, colConfig, event)) return false;
-
-        // Low-mass string treated separately. Tell if diffractive system.
-        } else {
-          bool isDiff = infoPtr->isDiffractiveA()
-                     || infoPtr->isDiffractiveB();
-          if (!ministringFrag.fragment( iSub, colConfig, event, isDiff))
-            return false;
-        }
-
-        // Displace hadron vertices transversely from parton MPI + shower.
-        if (doPartonVertex) partonVertexPtr->vertexHadrons( nBefFrag, event);
-      }
-    }
+    if (doHadronize && !fragmentSinglets(event)) return false;
 
     // Second part: sequential decays of short-lived particles (incl. K0).
 
     // If rescattering is off, we don't care about the order of the decays.
-    if (doDecay && !doRescatter) {
+    if (doDecay && !doRescatter && !doLazyDecays) {
       decaysCausedHadronization = decays.decayAll(event, widthSepBE);
 
     // If rescattering is on, decays/rescatterings must happen in order.
@@ -357,7 +324,7 @@ bool HadronLevel::next( Event& event) {
     }
 
     // Fourth part: sequential decays also of long-lived particles.
-    if (doDecay) {
+    if (doDecay && !doLazyDecays) {
       if (decays.decayAll(event))
         decaysCausedHadronization = true;
     }
@@ -373,6 +340,132 @@ bool HadronLevel::next( Event& event) {
   // (e.g. Upsilon decay can cause create unstable hadrons).
   } while (decaysCausedHadronization);
 
+  // Lazy decays: each particle that should decay is given a random-number
+  // seed, in the order of the event record, for use when it is decayed.
+  if (doLazyDecays) {
+    seedLazy.assign( event.size(), 0);
+    for (int i = 0; i < event.size(); ++i)
+    if (event[i].isFinal() && event[i].canDecay() && event[i].mayDecay())
+      seedLazy[i] = 1 + int(Rndm::SEEDMAX * rndmPtr->flat());
+  }
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Fragment the colour singlet systems of the event. Also used anew for
+// partons produced in decays.
+
+bool HadronLevel::fragmentSinglets( Event& event) {
+
+  // Find the complete colour singlet configuration of the event.
+  // Keep junctions if we do shoving.
+  if (!findSinglets( event, (stringRepulsionPtr != nullptr) ))
+    return false;
+
+  // Fragment off R-hadrons, if necessary.
+  if (allowRH && !rHadronsPtr->produce( colConfig, event))
+    return false;
+
+  // Save list with rapidity pairs of the different string pieces.
+  if (closePacking) colConfig.setRapPairs( rapidityPairs(event));
+
+  // Let strings interact in rope hadronization treatment.
+  // Do the shoving treatment.
+  if ( stringRepulsionPtr ) {
+
+    // Extract all string segments from the event and do the
+    // string reulsion.
+    stringRepulsionPtr->stringRepulsion(event, colConfig);
+
+    // Find singlets again.
+    iParton.resize(0);
+    colConfig.clear();
+    if (!findSinglets( event)) {
+      infoPtr->errorMsg("Error in HadronLevel::next: "
+        "ropes: failed 2nd singlet tracing.");
+      return false;
+    }
+  }
+
+  // Prepare for flavour ropes.
+  if (fragmentationModifierPtr)
+    fragmentationModifierPtr->initEvent(event, colConfig);
+
+  // Process all colour singlet (sub)systems, optionally in parallel.
+  if (doParallelFrag) {
+    if (!fragmentParallel(event)) return false;
+  } else for (int iSub = 0; iSub < colConfig.size(); ++iSub) {
+
+    // Collect sequentially all partons in a colour singlet subsystem.
+    colConfig.collect(iSub, event);
+    int nBefFrag = event.size();
+
+    // String fragmentation of each colour singlet (sub)system.
+    if ( colConfig[iSub].massExcess > mStringMin ) {
+      if (!stringFrag.fragment( iSub, colConfig, event)) return false;
+
+    // Low-mass string treated separately. Tell if diffractive system.
+    } else {
+      bool isDiff = infoPtr->isDiffractiveA()
+                 || infoPtr->isDiffractiveB();
+      if (!ministringFrag.fragment( iSub, colConfig, event, isDiff))
+        return false;
+    }
+
+    // Displace hadron vertices transversely from parton MPI + shower.
+    if (doPartonVertex) partonVertexPtr->vertexHadrons( nBefFrag, event);
+  }
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Fragment the colour singlet systems with independent strings handled
+// concurrently. Ministrings come first, in order, since they may take
+// recoil from a later system, which then has to be copied. Thereafter
+// junction systems are fragmented in place, while the hadrons from the
+// other systems are stored in the order of the systems.
+
+bool HadronLevel::fragmentParallel( Event& event) {
+
+  // Fragment ministrings and find the other systems.
+  vector<int> iSubString, iSubParallel;
+  for (int iSub = 0; iSub < colConfig.size(); ++iSub) {
+    if ( colConfig[iSub].massExcess > mStringMin ) {
+      iSubString.push_back(iSub);
+      continue;
+    }
+    colConfig.collect(iSub, event);
+    int nBefFrag = event.size();
+    bool isDiff = infoPtr->isDiffractiveA() || infoPtr->isDiffractiveB();
+    if (!ministringFrag.fragment( iSub, colConfig, event, isDiff))
+      return false;
+    if (doPartonVertex) partonVertexPtr->vertexHadrons( nBefFrag, event);
+  }
+
+  // Collect partons of the other systems. Fragment those without junctions.
+  for (int iSub : iSubString) {
+    colConfig.collect(iSub, event);
+    if (!colConfig[iSub].hasJunction) iSubParallel.push_back(iSub);
+  }
+  parallelFrag.fragment( iSubParallel, colConfig, event);
+
+  // Store the hadrons in order, with hadron vertices as usual.
+  for (int iSub : iSubString) {
+    int nBefFrag = event.size();
+    if (colConfig[iSub].hasJunction) {
+      if (!stringFrag.fragment( iSub, colConfig, event)) return false;
+    } else if (!parallelFrag.store( iSub, event)) return false;
+    if (doPartonVertex) partonVertexPtr->vertexHadrons( nBefFrag, event);
+  }
+
   // Done.
   return true;
 
@@ -388,6 +481,10 @@ bool HadronLevel::moreDecays( Event& event) {
   // Colour-octet onia states must be decayed to singlet + gluon.
   if (!decayOctetOnia(event)) return false;
 
+  // Pending lazy decays first, each with its own random numbers.
+  if (!decayPendingIf( [](const Particle&) {return true;}, event))
+    return false;
+
   // Loop through all entries to find those that should decay.
   int iDec = 0;
   do {
@@ -402,6 +499,86 @@ bool HadronLevel::moreDecays( Event& event) {
 
 //--------------------------------------------------------------------------
 
+// Decay a particle with a pending lazy decay, and in turn its unstable
+// decay products. A random-number stream of its own is used, so that the
+// outcome does not depend on which other particles are decayed, or in
+// which order, and the main stream is left as it was.
+
+bool HadronLevel::decayPending( int iDec, Event& event) {
+
+  // Nothing to do if the decay is not pending.
+  if (!isDecayPending( iDec, event)) return true;
+
+  // A tau can decay its partner together with itself. So a pending pair
+  // is always begun from the same tau, with its stream: the one with the
+  // lower index if both are taus.
+  int iTau = iDec;
+  vector<int> iSis = event[event[iDec].iTopCopyId()].sisterList();
+  for (int i = 0; i < int(iSis.size()); ++i) {
+    int iSisBot = event[iSis[i]].iBotCopyId();
+    if (event[iSisBot].idAbs() == 15 && isDecayPending( iSisBot, event)
+      && decays.tauPartner( iSisBot, event) == iDec
+      && (event[iDec].idAbs() != 15 || iSisBot < iDec)) iTau = iSisBot;
+  }
+  if (iTau != iDec && !decayLazy( iTau, event)) return false;
+
+  // The particle itself, unless decayed together with the tau.
+  return !isDecayPending( iDec, event) || decayLazy( iDec, event);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Decay a particle with a pending lazy decay with its own stream, and in
+// turn its unstable decay products.
+
+bool HadronLevel::decayLazy( int iDec, Event& event) {
+
+  // Switch to the stream of the particle. Only one decay of it.
+  Rndm rndmSave = *rndmPtr;
+  rndmPtr->init( seedLazy[iDec], 1);
+  seedLazy[iDec] = 0;
+
+  // Decay the particle, and in turn its unstable products. Partons from
+  // the decays are hadronized when all decays so far are done.
+  int  iBeg       = event.size();
+  bool isOK       = decays.decay( iDec, event);
+  bool doFragment = decays.moreToDo();
+  for (int i = iBeg; isOK && i < event.size(); ++i) {
+    if (event[i].isFinal() && event[i].canDecay() && event[i].mayDecay()) {
+      if (!decays.decay( i, event)) isOK = false;
+      if (decays.moreToDo()) doFragment = true;
+    }
+    if (isOK && doFragment && i == event.size() - 1) {
+      doFragment = false;
+      if (doHadronize && !fragmentSinglets( event)) isOK = false;
+    }
+  }
+
+  // Restore the main stream.
+  *rndmPtr = rndmSave;
+  return isOK;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Decay all particles with pending lazy decays that are selected.
+
+bool HadronLevel::decayPendingIf( function<bool(const Particle&)> select,
+  Event& event) {
+
+  // Only particles from the hadron level can have pending decays.
+  bool isOK = true;
+  for (int i = 0; i < int(seedLazy.size()); ++i)
+    if (isDecayPending( i, event) && select( event[i])
+      && !decayPending( i, event)) isOK = false;
+  return isOK;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Prepare to be able to pick a low-energy hadron-hadron scattering.
 
 bool HadronLevel::initLowEnergyProcesses() {
@@ -49,6 +49,37 @@ HelicityMatrixElement* HelicityMatrixElement::initChannel(
 
 //--------------------------------------------------------------------------
 
+// Tabulate the matrix element for all helicity combinations, so that the
+// recursive sums over pairs of combinations below need not recalculate it.
+
+void HelicityMatrixElement::tabulateME(vector<HelicityParticle>& p) {
+
+  // Find the number of spin states of each particle.
+  int nComb = 1;
+  nSpin.resize(p.size());
+  for (int i = 0; i < int(p.size()); i++) {
+    nSpin[i] = p[i].spinStates();
+    nComb   *= nSpin[i];
+  }
+
+  // Reset the helicity vectors.
+  h1Now.assign(p.size(), 0);
+  h2Now.assign(p.size(), 0);
+
+  // Loop over combinations, with the last helicity running fastest.
+  meTable.resize(nComb);
+  for (int k = 0; k < nComb; k++) {
+    meTable[k] = calculateME(h1Now);
+    for (int i = int(p.size()) - 1; i >= 0; i--) {
+      if (++h1Now[i] < nSpin[i]) break;
+      h1Now[i] = 0;
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Calculate a particle's decay matrix.
 
 void HelicityMatrixElement::calculateD(vector<HelicityParticle>& p) {
@@ -60,15 +91,12 @@ void HelicityMatrixElement::calculateD(vector<HelicityParticle>& p) {
     }
   }
 
-  // Initialize the wave functions.
+  // Initialize the wave functions and tabulate the matrix element.
   initWaves(p);
-
-  // Create the helicity vectors.
-  vector<int> h1(p.size(),0);
-  vector<int> h2(p.size(),0);
+  tabulateME(p);
 
   // Call the recursive sub-method.
-  calculateD(p, h1, h2, 0);
+  calculateD(p, h1Now, h2Now, 0, 0, 0);
 
   // Normalize the decay matrix.
   p[0].normalize(p[0].D);
@@ -77,20 +105,22 @@ void HelicityMatrixElement::calculateD(vector<HelicityParticle>& p) {
 
 //--------------------------------------------------------------------------
 
-// Recursive sub-method for calculating a particle's decay matrix.
+// Recursive sub-method for calculating a particle's decay matrix. The
+// helicity combinations are also tracked as indices in the table.
 
 void HelicityMatrixElement::calculateD(vector<HelicityParticle>& p,
-  vector<int>& h1, vector<int>& h2, unsigned int i) {
+  vector<int>& h1, vector<int>& h2, unsigned int i, int k1, int k2) {
 
   if (i < p.size()) {
-    for (h1[i] = 0; h1[i] < p[i].spinStates(); h1[i]++) {
-        for (h2[i] = 0; h2[i] < p[i].spinStates(); h2[i]++) {
-          calculateD(p, h1, h2, i+1);
+    for (h1[i] = 0; h1[i] < nSpin[i]; h1[i]++) {
+        for (h2[i] = 0; h2[i] < nSpin[i]; h2[i]++) {
+          calculateD(p, h1, h2, i+1, k1 * nSpin[i] + h1[i],
+            k2 * nSpin[i] + h2[i]);
         }
     }
   }
   else {
-    p[0].D[h1[0]][h2[0]] += calculateME(h1) * conj(calculateME(h2)) *
+    p[0].D[h1[0]][h2[0]] += meTable[k1] * conj(meTable[k2]) *
         calculateProductD(p, h1, h2);
   }
 
@@ -110,15 +140,12 @@ void HelicityMatrixElement::calculateRho(unsigned int idx,
     }
   }
 
-  // Initialize the wave functions.
+  // Initialize the wave functions and tabulate the matrix element.
   initWaves(p);
-
-  // Create the helicity vectors.
-  vector<int> h1(p.size(),0);
-  vector<int> h2(p.size(),0);
+  tabulateME(p);
 
   // Call the recursive sub-method.
-  calculateRho(idx, p, h1, h2, 0);
+  calculateRho(idx, p, h1Now, h2Now, 0, 0, 0);
 
   // Normalize the density matrix.
   p[idx].normalize(p[idx].rho);
@@ -131,12 +158,13 @@ void HelicityMatrixElement::calculateRho(unsigned int idx,
 
 void HelicityMatrixElement::calculateRho(unsigned int idx,
   vector<HelicityParticle>& p, vector<int>& h1, vector<int>& h2,
-  unsigned int i) {
+  unsigned int i, int k1, int k2) {
 
   if (i < p.size()) {
-    for (h1[i] = 0; h1[i] < p[i].spinStates(); h1[i]++) {
-        for (h2[i] = 0; h2[i] < p[i].spinStates(); h2[i]++) {
-          calculateRho(idx, p, h1, h2, i+1);
+    for (h1[i] = 0; h1[i] < nSpin[i]; h1[i]++) {
+        for (h2[i] = 0; h2[i] < nSpin[i]; h2[i]++) {
+          calculateRho(idx, p, h1, h2, i+1, k1 * nSpin[i] + h1[i],
+            k2 * nSpin[i] + h2[i]);
         }
     }
   }
@@ -144,12 +172,12 @@ void HelicityMatrixElement::calculateRho(unsigned int idx,
     // Calculate rho from a hard process.
     if (p[1].direction < 0)
         p[idx].rho[h1[idx]][h2[idx]] += p[0].rho[h1[0]][h2[0]] *
-          p[1].rho[h1[1]][h2[1]] * calculateME(h1)*conj(calculateME(h2)) *
+          p[1].rho[h1[1]][h2[1]] * meTable[k1]*conj(meTable[k2]) *
           calculateProductD(idx, 2, p, h1, h2);
     // Calculate rho from a decay.
     else
         p[idx].rho[h1[idx]][h2[idx]] += p[0].rho[h1[0]][h2[0]] *
-          calculateME(h1)*conj(calculateME(h2)) *
+          meTable[k1]*conj(meTable[k2]) *
           calculateProductD(idx, 1, p, h1, h2);
     return;
   }
@@ -164,15 +192,12 @@ double HelicityMatrixElement::decayWeight(vector<HelicityParticle>& p) {
 
   complex weight = complex(0,0);
 
-  // Initialize the wave functions.
+  // Initialize the wave functions and tabulate the matrix element.
   initWaves(p);
-
-  // Create the helicity vectors.
-  vector<int> h1(p.size(),0);
-  vector<int> h2(p.size(),0);
+  tabulateME(p);
 
   // Call the recursive sub-method.
-  decayWeight(p, h1, h2, weight, 0);
+  decayWeight(p, h1Now, h2Now, weight, 0, 0, 0);
 
   return real(weight);
 
@@ -183,18 +208,20 @@ double HelicityMatrixElement::decayWeight(vector<HelicityParticle>& p) {
 // Recursive sub-method for calculating a decay's weight.
 
 void HelicityMatrixElement::decayWeight(vector<HelicityParticle>& p,
-  vector<int>& h1, vector<int>& h2, complex& weight, unsigned int i) {
+  vector<int>& h1, vector<int>& h2, complex& weight, unsigned int i,
+  int k1, int k2) {
 
   if (i < p.size()) {
-    for (h1[i] = 0; h1[i] < p[i].spinStates(); h1[i]++) {
-        for (h2[i] = 0; h2[i] < p[i].spinStates(); h2[i]++) {
-          decayWeight(p, h1, h2, weight, i+1);
+    for (h1[i] = 0; h1[i] < nSpin[i]; h1[i]++) {
+        for (h2[i] = 0; h2[i] < nSpin[i]; h2[i]++) {
+          decayWeight(p, h1, h2, weight, i+1, k1 * nSpin[i] + h1[i],
+            k2 * nSpin[i] + h2[i]);
         }
     }
   }
   else {
-    weight += p[0].rho[h1[0]][h2[0]] * calculateME(h1) *
-        conj(calculateME(h2)) * calculateProductD(p, h1, h2);
+    weight += p[0].rho[h1[0]][h2[0]] * meTable[k1] *
+        conj(meTable[k2]) * calculateProductD(p, h1, h2);
   }
 
 }
@@ -525,15 +552,22 @@ complex HMETwoFermions2GammaZ2TwoFermions::calculateZME(
   complex answer(0,0);
   // Return zero if correct helicity conditions.
   if (h[0] == h[1] && zaxis) return answer;
+
+  // The two fermion currents, which do not depend on the other index.
+  complex cur0[4], cur2[4];
+  for (int mu = 0; mu <= 3; mu++) {
+    cur0[mu] = u[1][h[pMap[1]]] * gamma[mu] * (p0CV - p0CA * gamma[5]) *
+      u[0][h[pMap[0]]];
+    cur2[mu] = u[3][h[pMap[3]]] * gamma[mu] * (p2CV - p2CA * gamma[5]) *
+      u[2][h[pMap[2]]];
+  }
+
+  // Contract the currents with the propagator numerator.
   for (int mu = 0; mu <= 3; mu++) {
     for (int nu = 0; nu <= 3; nu++) {
-        answer +=
-          (u[1][h[pMap[1]]] * gamma[mu] * (p0CV - p0CA * gamma[5]) *
-           u[0][h[pMap[0]]]) *
+        answer += cur0[mu] *
           (gamma[4](mu,nu) - gamma[4](mu,mu)*u[4][0](mu) *
-           gamma[4](nu,nu) * u[4][0](nu) / (zM*zM)) *
-          (u[3][h[pMap[3]]] * gamma[nu] * (p2CV - p2CA * gamma[5]) *
-           u[2][h[pMap[2]]]);
+           gamma[4](nu,nu) * u[4][0](nu) / (zM*zM)) * cur2[nu];
     }
   }
   return answer / (16 * pow2(sin2W * cos2W) * (s - m*m + complex(0, s*g/m)));
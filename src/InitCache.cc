@@ -0,0 +1,300 @@
+// InitCache.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Function definitions (not found in the header) for the InitCache class.
+
+#include "Pythia8/InitCache.h"
+
+// Allow string and character manipulation.
+#include <cctype>
+
+// Access file renaming.
+#include <cstdio>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The InitCache class.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// First line of a cache file, to be changed if the format changes.
+const string InitCache::HEADER = "PYTHIA initialization cache, format 2";
+
+// Settings that only steer printout, random numbers and the main program
+// do not enter the key. The tables are calculated with random numbers of
+// their own, so that e.g. jobs with different seeds share them.
+const int    InitCache::NIGNORE = 8;
+const string InitCache::IGNOREPREFIX[8] = { "init:", "next:", "stat:",
+  "main:", "random:", "print:", "parallelism:", "check:" };
+
+// Only one cache file at a time is written by the program.
+mutex InitCache::fileMutex;
+
+//--------------------------------------------------------------------------
+
+// Prepare for a new initialization.
+
+bool InitCache::init(Info* infoPtrIn, bool canUse) {
+
+  // Reset status and tables.
+  infoPtr     = infoPtrIn;
+  rndmPtr     = infoPtr->rndmPtr;
+  isActive    = false;
+  hasNew      = false;
+  isOnStream  = false;
+  nLoadedSave = 0;
+  nStoredSave = 0;
+  tables.clear();
+  newTags.clear();
+  nTags.clear();
+
+  // The random numbers must be switched to the stream of each table.
+  fileName    = infoPtr->settingsPtr->word("Init:cacheFile");
+  if (fileName == "" || toLower(fileName) == "void" || !canUse
+    || rndmPtr->useExternal()) return false;
+
+  // Find the key and read matching tables from the file.
+  nKeysMax    = infoPtr->settingsPtr->mode("Init:cacheKeys");
+  isActive    = true;
+  keyNow      = findKey();
+  readFile();
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Unique tag of the next table of a given kind. Tables are calculated in
+// a fixed order during initialization, so the count identifies them.
+
+string InitCache::tag(string kind) {
+
+  for (int i = 0; i < int(kind.size()); ++i)
+    if (isspace(kind[i])) kind[i] = '_';
+  return kind + "#" + to_string(nTags[kind]++);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Retrieve a table.
+
+bool InitCache::get(string tagIn, vector<double>& values) {
+
+  // Only tables read from file are used.
+  if (!isActive) return false;
+  map<string, vector<double> >::iterator tableItr = tables.find(tagIn);
+  if (tableItr == tables.end() || tableItr->second.size() == 0
+    || std::find( newTags.begin(), newTags.end(), tagIn) != newTags.end())
+    return false;
+  values = tableItr->second;
+  ++nLoadedSave;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Keep the normal random numbers, and start the stream of the tag, with
+// a seed from a 64-bit FNV-1a hash of the tag. Each table is thus found
+// with the same random numbers, whether earlier tables were calculated
+// or read, and whatever the seed of the run.
+
+void InitCache::startTable(string tagIn) {
+
+  if (!isActive) return;
+  unsigned long long hash = 14695981039346656037ULL;
+  for (int i = 0; i < int(tagIn.size()); ++i) {
+    hash ^= (unsigned char)tagIn[i];
+    hash *= 1099511628211ULL;
+  }
+  endTable();
+  rndmSave   = *rndmPtr;
+  rndmPtr->init( 1 + int(hash % Rndm::SEEDMAX), 1);
+  isOnStream = true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store a table, to be written to file at the end of initialization.
+
+void InitCache::set(string tagIn, const vector<double>& values) {
+
+  if (!isActive) return;
+  endTable();
+  tables[tagIn] = values;
+  if (std::find( newTags.begin(), newTags.end(), tagIn) == newTags.end())
+    newTags.push_back(tagIn);
+  hasNew = true;
+  ++nStoredSave;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Switch back to the normal random numbers, as they were before the
+// calculation of the table.
+
+void InitCache::endTable() {
+
+  if (!isOnStream) return;
+  *rndmPtr   = rndmSave;
+  isOnStream = false;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Write new tables to file. Tables of other keys are kept, and the file
+// is read anew just before, to merge with those of other programs. Keys
+// are ordered by when they were last written, and only the latest
+// nKeysMax of them, including the current one, are kept.
+
+bool InitCache::write() {
+
+  // Nothing to do.
+  if (!isActive || !hasNew) return true;
+  lock_guard<mutex> fileLock(fileMutex);
+
+  // Keep all old lines, except for tables that are replaced. Find the
+  // last line of each key.
+  vector<string> lines, keys;
+  map<string, int> lastLine;
+  ifstream is( fileName.c_str() );
+  string line;
+  if (getline( is, line) && line == HEADER) while (getline( is, line)) {
+    istringstream isLine(line);
+    string keyIn, tagIn;
+    isLine >> keyIn >> tagIn;
+    if (keyIn != keyNow || std::find( newTags.begin(), newTags.end(), tagIn)
+      == newTags.end()) {
+      lastLine[keyIn] = lines.size();
+      lines.push_back(line);
+      keys.push_back(keyIn);
+    }
+  }
+  is.close();
+
+  // Remove the tables of all but the latest keys. The current one is
+  // written last, so is the latest.
+  vector<int> lastOfKey;
+  for (map<string, int>::iterator keyItr = lastLine.begin();
+    keyItr != lastLine.end(); ++keyItr)
+    if (keyItr->first != keyNow) lastOfKey.push_back(keyItr->second);
+  sort( lastOfKey.begin(), lastOfKey.end() );
+  int nRemove = int(lastOfKey.size()) - (nKeysMax - 1);
+  if (nRemove > 0) {
+    int lastRemoved = lastOfKey[nRemove - 1];
+    int nKept = 0;
+    for (int i = 0; i < int(lines.size()); ++i)
+      if (keys[i] == keyNow || lastLine[keys[i]] > lastRemoved)
+        lines[nKept++] = lines[i];
+    lines.resize(nKept);
+  }
+
+  // Write to temporary file, then rename it, so that the cache file is
+  // never seen incomplete by other programs.
+  ostringstream tmpName;
+  tmpName << fileName << ".tmp" << this;
+  ofstream os( tmpName.str().c_str() );
+  if (!os.good()) {
+    infoPtr->errorMsg("Warning in InitCache::write: cannot write file",
+      fileName);
+    return false;
+  }
+  os << HEADER << "\n";
+  for (int i = 0; i < int(lines.size()); ++i) os << lines[i] << "\n";
+  os << scientific << setprecision(17);
+  for (int i = 0; i < int(newTags.size()); ++i) {
+    const vector<double>& table = tables[newTags[i]];
+    os << keyNow << " " << newTags[i] << " " << table.size();
+    for (int j = 0; j < int(table.size()); ++j) os << " " << table[j];
+    os << "\n";
+  }
+  os.close();
+  if (std::rename( tmpName.str().c_str(), fileName.c_str()) != 0) {
+    std::remove( tmpName.str().c_str() );
+    infoPtr->errorMsg("Warning in InitCache::write: cannot write file",
+      fileName);
+    return false;
+  }
+
+  // Done.
+  newTags.clear();
+  hasNew = false;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find the key: a 64-bit FNV-1a hash of all relevant settings and the
+// complete particle data table, including any changes made to it.
+
+string InitCache::findKey() {
+
+  // Collect the configuration as text. Skip irrelevant settings.
+  ostringstream os;
+  ostringstream osSettings;
+  infoPtr->settingsPtr->writeFile( osSettings, true);
+  istringstream isSettings( osSettings.str() );
+  string line;
+  while (getline( isSettings, line)) {
+    string lineLow = toLower(line);
+    bool skip = false;
+    for (int i = 0; i < NIGNORE; ++i)
+      if (lineLow.find(IGNOREPREFIX[i]) == 0) skip = true;
+    if (!skip) os << line << "\n";
+  }
+  ParticleData& particleData = *infoPtr->particleDataPtr;
+  particleData.listXML(os);
+  vector<string> history = particleData.getReadHistory();
+  for (int i = 0; i < int(history.size()); ++i) os << history[i] << "\n";
+
+  // Hash the text.
+  string text = os.str();
+  unsigned long long hash = 14695981039346656037ULL;
+  for (int i = 0; i < int(text.size()); ++i) {
+    hash ^= (unsigned char)text[i];
+    hash *= 1099511628211ULL;
+  }
+  ostringstream osKey;
+  osKey << std::hex << std::setfill('0') << setw(16) << hash;
+  return osKey.str();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read all tables of the current key from the cache file, if it exists.
+
+void InitCache::readFile() {
+
+  ifstream is( fileName.c_str() );
+  string line;
+  if (!getline( is, line) || line != HEADER) return;
+  while (getline( is, line)) {
+    istringstream isLine(line);
+    string keyIn, tagIn;
+    int nValues = 0;
+    isLine >> keyIn >> tagIn >> nValues;
+    if (keyIn != keyNow || nValues <= 0) continue;
+    vector<double> values(nValues);
+    for (int i = 0; i < nValues; ++i) isLine >> values[i];
+    if (isLine.fail()) continue;
+    tables[tagIn] = values;
+  }
+
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
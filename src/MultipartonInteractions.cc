@@ -671,9 +671,25 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
     if (pT0paramMode == 0) pT0 = pT0Ref * pow(eCM / ecmRef, ecmPow);
     else                   pT0 = pT0Ref + ecmPow * log (eCM / ecmRef);
 
-    // The pT0 value may need to be decreased, if sigmaInt < sigmaND.
+    // Results of the pT0 search below may be found in the cache.
     double pT4dSigmaMaxBeg = 0.;
-    for ( ; ; ) {
+    InitCache* initCachePtr = infoPtr->initCachePtr;
+    bool   useCache = (initCachePtr != 0 && initCachePtr->isOn());
+    bool   isCached = false;
+    string cacheTag;
+    if (useCache) {
+      ostringstream osTag;
+      osTag << "MPI:" << beamAPtr->id() << ":" << beamBPtr->id() << ":"
+            << iDiffSys << ":" << eCM;
+      cacheTag = initCachePtr->tag( osTag.str() );
+      vector<double> table;
+      isCached = initCachePtr->get( cacheTag, table)
+        && useCacheTable( table, pT4dSigmaMaxBeg);
+      if (!isCached) initCachePtr->startTable( cacheTag);
+    }
+
+    // The pT0 value may need to be decreased, if sigmaInt < sigmaND.
+    if (!isCached) for ( ; ; ) {
 
       // Derived pT kinematics combinations.
       pT20         = pT0*pT0;
@@ -722,10 +738,15 @@ bool MultipartonInteractions::init( bool doMPIinit, int iDiffSysIn,
         infoPtr->errorMsg("Error in MultipartonInteractions::init:"
           " failed to find acceptable pT0 and pTmin");
         infoPtr->setTooLowPTmin(true);
+        if (useCache) initCachePtr->endTable();
         return false;
       }
     }
 
+    // Store results of the pT0 search in the cache.
+    if (useCache && !isCached) initCachePtr->set( cacheTag,
+      cacheTable( pT4dSigmaMaxBeg));
+
     // Output for accepted pT0.
     if (showMPI) cout << fixed << setprecision(2) << " |    pT0 = "
       << setw(5) << pT0 << " gives sigmaInteraction = "<< setw(8)
@@ -1613,6 +1634,68 @@ void MultipartonInteractions::jetCrossSection() {
 
 //--------------------------------------------------------------------------
 
+// Collect the results of the pT0 search at the current energy,
+// for storage in the cache of initialization tables.
+
+vector<double> MultipartonInteractions::cacheTable(double pT4dSigmaMaxBeg) {
+
+  vector<double> table;
+  table.push_back( pT0);
+  table.push_back( pTmin);
+  table.push_back( pT4dSigmaMaxBeg);
+  table.push_back( pT4dSigmaMax);
+  table.push_back( pT4dProbMax);
+  table.push_back( sigmaInt);
+  table.push_back( bstepNow);
+  for (int j = 0; j <= 100; ++j) table.push_back( sudExpPT[j]);
+  if (bProfile == 4) table.insert( table.end(), sigmaIntWgt.begin(),
+    sigmaIntWgt.end());
+  return table;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Restore the results of the pT0 search from a cached table, and set up
+// the derived pT kinematics combinations. Fail if the table does not fit.
+
+bool MultipartonInteractions::useCacheTable(const vector<double>& table,
+  double& pT4dSigmaMaxBeg) {
+
+  // Check size of table.
+  int nWgt = (bProfile == 4) ? XDEP_BBIN : 0;
+  if (int(table.size()) != 108 + nWgt) return false;
+
+  // Read out values.
+  pT0             = table[0];
+  pTmin           = table[1];
+  pT4dSigmaMaxBeg = table[2];
+  pT4dSigmaMax    = table[3];
+  pT4dProbMax     = table[4];
+  sigmaInt        = table[5];
+  bstepNow        = table[6];
+  for (int j = 0; j <= 100; ++j) sudExpPT[j] = table[7 + j];
+  if (bProfile == 4) {
+    sigmaIntWgt.assign( table.begin() + 108, table.end());
+    sigmaSumWgt.resize(XDEP_BBIN);
+  }
+
+  // Derived pT kinematics combinations.
+  pT20         = pT0*pT0;
+  pT2min       = pTmin*pTmin;
+  pTmax        = 0.5*eCM;
+  pT2max       = pTmax*pTmax;
+  pT20R        = RPT20 * pT20;
+  pT20minR     = pT2min + pT20R;
+  pT20maxR     = pT2max + pT20R;
+  pT20min0maxR = pT20minR * pT20maxR;
+  pT2maxmin    = pT2max - pT2min;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Evaluate "Sudakov form factor" for not having a harder interaction
 // at the selected b value, given the pT scale of the event.
 
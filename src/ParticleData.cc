@@ -24,6 +24,11 @@ namespace Pythia8 {
 
 //--------------------------------------------------------------------------
 
+// Counter of changes of branching ratios or on/off switches.
+atomic<long> DecayChannel::nChangesSave(0);
+
+//--------------------------------------------------------------------------
+
 // Check whether id1 occurs anywhere in product list.
 
 bool DecayChannel::contains(int id1) const {
@@ -114,6 +119,10 @@ const double ParticleDataEntry::NARROWMASS       = 1e-6;
 const double ParticleDataEntry::CONSTITUENTMASSTABLE[10]
   = {0., 0.325, 0.325, 0.50, 1.60, 5.00, 0., 0., 0., 0.7};
 
+// Relative rounding error per term allowed for running sums of branching
+// ratios; closer to a sum the linear search is used in picking a channel.
+const double ParticleDataEntry::MAXROUNDING = 1e-15;
+
 //--------------------------------------------------------------------------
 
 // Destructor: delete any ResonanceWidths object.
@@ -379,17 +388,20 @@ void ParticleDataEntry::initBWmass() {
 
 // Function to give mass of a particle, either at the nominal value
 // or picked according to a (linear or quadratic) Breit-Wigner.
+// Optionally with another random-number generator than the normal one.
 
-double ParticleDataEntry::mSel() const {
+double ParticleDataEntry::mSel(Rndm* rndmPtrIn) const {
 
   // Nominal value. (Width check should not be needed, but just in case.)
   if (modeBWnow == 0 || mWidthSave < NARROWMASS) return m0Save;
   double mNow, m2Now;
+  Rndm* rndmNowPtr = (rndmPtrIn != nullptr) ? rndmPtrIn
+                   : particleDataPtr->rndmPtr;
 
   // Mass according to a Breit-Wigner linear in m.
   if (modeBWnow == 1) {
      mNow = m0Save + 0.5 * mWidthSave
-       * tan( atanLow + atanDif * particleDataPtr->rndmPtr->flat() );
+       * tan( atanLow + atanDif * rndmNowPtr->flat() );
 
   // Ditto, but make Gamma proportional to sqrt(m^2 - m_threshold^2).
   } else if (modeBWnow == 2) {
@@ -397,17 +409,17 @@ double ParticleDataEntry::mSel() const {
     double m0ThrS = m0Save*m0Save - mThr*mThr;
     do {
       mNow = m0Save + 0.5 * mWidthSave
-        * tan( atanLow + atanDif * particleDataPtr->rndmPtr->flat() );
+        * tan( atanLow + atanDif * rndmNowPtr->flat() );
       mWidthNow = mWidthSave * sqrtpos( (mNow*mNow - mThr*mThr) / m0ThrS );
       fixBW = mWidthSave / (pow2(mNow - m0Save) + pow2(0.5 * mWidthSave));
       runBW = mWidthNow / (pow2(mNow - m0Save) + pow2(0.5 * mWidthNow));
-    } while (runBW < particleDataPtr->rndmPtr->flat()
+    } while (runBW < rndmNowPtr->flat()
       * particleDataPtr->maxEnhanceBW * fixBW);
 
   // Mass according to a Breit-Wigner quadratic in m.
   } else if (modeBWnow == 3) {
     m2Now = m0Save*m0Save + m0Save * mWidthSave
-      * tan( atanLow + atanDif * particleDataPtr->rndmPtr->flat() );
+      * tan( atanLow + atanDif * rndmNowPtr->flat() );
     mNow = sqrtpos( m2Now);
 
   // Ditto, but m_0 Gamma_0 -> m Gamma(m) with threshold factor as above.
@@ -418,13 +430,13 @@ double ParticleDataEntry::mSel() const {
     double m2Thr = mThr * mThr;
     do {
       m2Now = m2Ref + mwRef * tan( atanLow + atanDif
-        * particleDataPtr->rndmPtr->flat() );
+        * rndmNowPtr->flat() );
       mNow = sqrtpos( m2Now);
       mwNow = mNow * mWidthSave
         * sqrtpos( (m2Now - m2Thr) / (m2Ref - m2Thr) );
       fixBW = mwRef / (pow2(m2Now - m2Ref) + pow2(mwRef));
       runBW = mwNow / (pow2(m2Now - m2Ref) + pow2(mwNow));
-    } while (runBW < particleDataPtr->rndmPtr->flat()
+    } while (runBW < rndmNowPtr->flat()
       * particleDataPtr->maxEnhanceBW * fixBW);
   }
 
@@ -477,6 +489,7 @@ bool ParticleDataEntry::preparePick(int idSgn, double mHat, int idInFlav) {
 
   // Reset sum of allowed widths/branching ratios.
   currentBRSum = 0.;
+  iPickNow     = -1;
 
   // For resonances the widths are calculated dynamically.
   if (isResonanceSave && resonancePtr != 0) {
@@ -484,10 +497,20 @@ bool ParticleDataEntry::preparePick(int idSgn, double mHat, int idInFlav) {
     for (int i = 0; i < int(channels.size()); ++i)
       currentBRSum += channels[i].currentBR();
 
-  // Else use normal fixed branching ratios.
+  // Else use normal fixed branching ratios. Stored tables can be used
+  // if no decay channel has been changed since they were filled.
   } else {
+    int  iTab        = (idSgn > 0) ? 0 : 1;
+    long nChangesNow = DecayChannel::nChanges();
+    if (idSgn != 0 && pickChanges[iTab] == nChangesNow
+      && pickBR[iTab].size() == channels.size()) {
+      iPickNow     = iTab;
+      currentBRSum = (channels.size() > 0) ? pickSum[iTab].back() : 0.;
+      return (currentBRSum > 0.);
+    }
     int onMode;
     double currentBRNow;
+    bool isMonotone = true;
     for (int i = 0; i < int(channels.size()); ++i) {
       onMode = channels[i].onMode();
       currentBRNow = 0.;
@@ -497,6 +520,22 @@ bool ParticleDataEntry::preparePick(int idSgn, double mHat, int idInFlav) {
         currentBRNow = channels[i].bRatio();
       channels[i].currentBR(currentBRNow);
       currentBRSum += currentBRNow;
+      if (currentBRNow < 0.) isMonotone = false;
+    }
+
+    // Fill the tables, with running sums as above, unless some branching
+    // ratio is negative, so that the sums would not be ordered.
+    if (idSgn != 0 && isMonotone) {
+      pickBR[iTab].resize( channels.size());
+      pickSum[iTab].resize( channels.size());
+      double sumNow = 0.;
+      for (int i = 0; i < int(channels.size()); ++i) {
+        pickBR[iTab][i]  = channels[i].currentBR();
+        sumNow          += pickBR[iTab][i];
+        pickSum[iTab][i] = sumNow;
+      }
+      pickChanges[iTab] = nChangesNow;
+      iPickNow          = iTab;
     }
   }
 
@@ -511,12 +550,28 @@ bool ParticleDataEntry::preparePick(int idSgn, double mHat, int idInFlav) {
 
 DecayChannel& ParticleDataEntry::pickChannel() {
 
-  // Find channel in table.
+  // Random number in range of summed branching ratios.
   int size = channels.size();
   double rndmBR = currentBRSum * particleDataPtr->rndmPtr->flat();
-  int i = -1;
-  do rndmBR -= channels[++i].currentBR();
-  while (rndmBR > 0. && i < size);
+
+  // With tables, find the first running sum not below the random number.
+  // This is the channel found by the linear search below, except when the
+  // number is so close to a sum that rounding errors could matter.
+  if (iPickNow >= 0) {
+    const vector<double>& sums = pickSum[iPickNow];
+    int i = lower_bound( sums.begin(), sums.end(), rndmBR) - sums.begin();
+    double tolerance = 2. * size * MAXROUNDING * currentBRSum;
+    if ( i < size && sums[i] - rndmBR > tolerance
+      && (i == 0 || rndmBR - sums[i - 1] > tolerance) ) return channels[i];
+  }
+
+  // Find channel in table by subtracting one branching ratio at a time.
+  int i = 0;
+  for ( ; i < size; ++i) {
+    rndmBR -= (iPickNow >= 0) ? pickBR[iPickNow][i]
+            : channels[i].currentBR();
+    if (rndmBR <= 0.) break;
+  }
 
   // Emergency if no channel found. Done.
   if (i == size) i = 0;
@@ -604,6 +659,21 @@ void ParticleDataEntry::setConstituentMass() {
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Particle codes below this value are looked up directly in an array.
+const int ParticleData::IDDENSE = 10000;
+
+//--------------------------------------------------------------------------
+
+// Databases already read from file, shared between ParticleData objects.
+
+map<string, shared_ptr<const ParticleData> > ParticleData::xmlCache;
+mutex ParticleData::xmlCacheMutex;
+
+//--------------------------------------------------------------------------
+
 // Get data to be distributed among particles during setup.
 // Note: this routine is called twice. Firstly from init(...), but
 // the data should not be used at that point, so is likely overkill.
@@ -864,16 +934,39 @@ void ParticleData::initWidths( vector<ResonanceWidths*> resonancePtrs) {
 //--------------------------------------------------------------------------
 
 // Read in database from specific XML file (which may refer to others).
+// A complete reset from a file already read in is served from the cache.
 
 bool ParticleData::readXML(string inFile, bool reset) {
 
+  // Only cache full databases, not files appended to an existing one.
+  if (!reset) return loadXML(inFile, reset) && processXML(reset);
+  lock_guard<mutex> cacheLock(xmlCacheMutex);
+
+  // Copy particle entries from the cache and redirect their pointers.
+  map<string, shared_ptr<const ParticleData> >::iterator cacheItr
+    = xmlCache.find(inFile);
+  if (cacheItr != xmlCache.end()) {
+    const ParticleData& cachePD = *cacheItr->second;
+    pdt = cachePD.pdt;
+    for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+      pdtEntry != pdt.end(); ++pdtEntry) pdtEntry->second.initPtr(this);
+    indexParticles();
+    xmlFileSav = cachePD.xmlFileSav;
+    readStringHistory.resize(0);
+    readStringSubrun.clear();
+    particlePtr = 0;
+    isInit = true;
+    return true;
+  }
+
   // Load XML file into memory
   if (!loadXML(inFile,reset)) return false;
 
   // Process XML file (now stored in memory)
   if (!processXML(reset)) return false;
 
-  // Done.
+  // Store a copy of the freshly read database. Done.
+  xmlCache[inFile] = make_shared<const ParticleData>(*this);
   return true;
 }
 
@@ -901,11 +994,11 @@ bool ParticleData::copyXML(const ParticleData &particleDataIn) {
 
   // First Reset everything.
   pdt.clear();
-  xmlFileSav.clear();
+  indexParticles();
   readStringHistory.resize(0);
   readStringSubrun.clear();
   isInit = false;
-  xmlFileSav=particleDataIn.xmlFileSav;
+  xmlFileSav = particleDataIn.xmlFileSav;
 
   // Process XML file (now stored in memory)
   if (!processXML(true)) return false;
@@ -919,10 +1012,13 @@ bool ParticleData::copyXML(const ParticleData &particleDataIn) {
 
 bool ParticleData::loadXML(istream& is, bool reset) {
 
-  // Normally reset whole database before beginning.
+  // Normally reset whole database before beginning. Else append to a
+  // copy of the current lines, since these may be shared.
+  vector<string> xmlLines;
+  if (!reset && xmlFileSav) xmlLines = *xmlFileSav;
   if (reset) {
     pdt.clear();
-    xmlFileSav.clear();
+    indexParticles();
     readStringHistory.resize(0);
     readStringSubrun.clear();
     isInit = false;
@@ -952,11 +1048,12 @@ bool ParticleData::loadXML(istream& is, bool reset) {
 
     // Else save line to memory.
     else {
-      xmlFileSav.push_back(line);
+      xmlLines.push_back(line);
     }
   }
 
-  //Done.
+  // Done.
+  xmlFileSav = make_shared<const vector<string> >(xmlLines);
   return true;
 
 }
@@ -981,7 +1078,9 @@ bool ParticleData::loadXML(string inFile, bool reset) {
 bool ParticleData::processXML(bool reset) {
 
   // Number of lines saved.
-  int nLines = xmlFileSav.size();
+  if (!xmlFileSav) return false;
+  const vector<string>& xmlLines = *xmlFileSav;
+  int nLines = xmlLines.size();
 
   // Process each line sequentially.
   particlePtr = 0;
@@ -989,7 +1088,7 @@ bool ParticleData::processXML(bool reset) {
   while (++i < nLines) {
 
     // Retrieve line.
-    string line = xmlFileSav[i];
+    string line = xmlLines[i];
 
     // Get first word of a line.
     istringstream getfirst(line);
@@ -1000,7 +1099,7 @@ bool ParticleData::processXML(bool reset) {
     if (word1 == "<particle") {
       while (line.find(">") == string::npos) {
         if (++i >= nLines) break;
-        string addLine = xmlFileSav[i];
+        string addLine = xmlLines[i];
         line += addLine;
       }
 
@@ -1020,7 +1119,7 @@ bool ParticleData::processXML(bool reset) {
       bool varWidthTmp   = boolAttributeValue( line, "varWidth");
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) eraseParticle(idTmp);
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1032,7 +1131,7 @@ bool ParticleData::processXML(bool reset) {
     } else if (word1 == "<channel") {
       while (line.find(">") == string::npos) {
         if (++i >= nLines) break;
-        string addLine = xmlFileSav[i];
+        string addLine = xmlLines[i];
         line += addLine;
       }
 
@@ -1089,6 +1188,15 @@ void ParticleData::listXML(string outFile) {
   // Convert file name to ofstream.
   const char* cstring = outFile.c_str();
   ofstream os(cstring);
+  listXML(os);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Print out complete database in numerical order to an XML stream.
+
+void ParticleData::listXML(ostream& os) {
 
   // Iterate through the particle data table.
   for (map<int, ParticleDataEntry>::iterator pdtEntry
@@ -1156,6 +1264,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
   // Normally reset whole database before beginning.
   if (reset) {
     pdt.clear();
+    indexParticles();
     readStringHistory.resize(0);
     readStringSubrun.clear();
     isInit = false;
@@ -1206,7 +1315,7 @@ bool ParticleData::readFF(istream& is, bool reset) {
       }
 
       // Erase if particle already exists.
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) eraseParticle(idTmp);
 
       // Store new particle. Save pointer, to be used for decay channels.
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
@@ -1510,7 +1619,7 @@ void ParticleData::listFF(string outFile) {
 
     // Else start over completely from scratch.
     } else {
-      if (isParticle(idTmp)) pdt.erase(idTmp);
+      if (isParticle(idTmp)) eraseParticle(idTmp);
       addParticle( idTmp, nameTmp, antiNameTmp, spinTypeTmp, chargeTypeTmp,
         colTypeTmp, m0Tmp, mWidthTmp, mMinTmp, mMaxTmp, tau0Tmp, varWidthTmp);
     }
@@ -2239,6 +2348,62 @@ int ParticleData::nextId(int idIn) const {
 
 //--------------------------------------------------------------------------
 
+// Update the fast lookup for one particle code, after it has been added
+// to or removed from the map.
+
+void ParticleData::indexParticle(int idAbs) {
+
+  // Negative codes are never stored.
+  if (idAbs < 0) return;
+  map<int, ParticleDataEntry>::iterator pdtEntry = pdt.find(idAbs);
+  ParticleDataEntry* ptr = (pdtEntry == pdt.end()) ? nullptr
+    : &pdtEntry->second;
+
+  // Common codes: direct index.
+  if (int(pdtDense.size()) < IDDENSE) pdtDense.resize(IDDENSE, nullptr);
+  if (idAbs < IDDENSE) {
+    pdtDense[idAbs] = ptr;
+    return;
+  }
+
+  // Rare codes: keep vectors sorted.
+  int iSparse = lower_bound( idSparse.begin(), idSparse.end(), idAbs)
+    - idSparse.begin();
+  bool found = (iSparse < int(idSparse.size()) && idSparse[iSparse] == idAbs);
+  if (ptr && found) pdtSparse[iSparse] = ptr;
+  else if (ptr) {
+    idSparse.insert( idSparse.begin() + iSparse, idAbs);
+    pdtSparse.insert( pdtSparse.begin() + iSparse, ptr);
+  } else if (found) {
+    idSparse.erase( idSparse.begin() + iSparse);
+    pdtSparse.erase( pdtSparse.begin() + iSparse);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Rebuild the fast lookup for the whole map.
+
+void ParticleData::indexParticles() {
+
+  pdtDense.assign(IDDENSE, nullptr);
+  idSparse.clear();
+  pdtSparse.clear();
+  for (map<int, ParticleDataEntry>::iterator pdtEntry = pdt.begin();
+    pdtEntry != pdt.end(); ++pdtEntry) {
+    if (pdtEntry->first < IDDENSE)
+      pdtDense[pdtEntry->first] = &pdtEntry->second;
+    else {
+      idSparse.push_back( pdtEntry->first);
+      pdtSparse.push_back( &pdtEntry->second);
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
 // Fractional width associated with open channels of one or two resonances.
 
 double ParticleData::resOpenFrac(int id1In, int id2In, int id3In) {
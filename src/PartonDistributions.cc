@@ -11,6 +11,15 @@
 
 #include "Pythia8/PartonDistributions.h"
 
+// Access memcpy, for the bit patterns of cache keys and binary grids.
+#include <cstring>
+
+// Access mmap and related POSIX calls, for binary grid files.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace Pythia8 {
 
 //==========================================================================
@@ -64,8 +73,7 @@ double PDF::xf(int id, double x, double Q2) {
   // Need to update if flavour, x or Q2 changed.
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
-  if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+  xfUpdateIfNew(id, x, Q2);
 
   // Baryon beams: only p and pbar for now.
   if (idBeamAbs == 2212) {
@@ -189,8 +197,7 @@ double PDF::xfVal(int id, double x, double Q2) {
   // Need to update if flavour, x or Q2 changed.
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
-  if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+  xfUpdateIfNew(id, x, Q2);
 
   // Baryon and nondiagonal meson beams: only p, pbar, n, nbar, pi+, pi-.
   if (idBeamAbs == 2212) {
@@ -242,8 +249,7 @@ double PDF::xfSea(int id, double x, double Q2) {
   // Need to update if flavour, x or Q2 changed.
   // Use idSav = 9 to indicate that ALL flavours are up-to-date.
   // Assume that flavour and antiflavour always updated simultaneously.
-  if ( (abs(idSav) != abs(id) && idSav != 9) || x != xSav || Q2 != Q2Sav)
-    {idSav = id; xfUpdate(id, x, Q2); xSav = x; Q2Sav = Q2;}
+  xfUpdateIfNew(id, x, Q2);
 
   // Hadron beams.
   if (idBeamAbs > 100) {
@@ -301,6 +307,78 @@ double PDF::xfSea(int id, double x, double Q2) {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Switch on the cache of PDF values at recent (x, Q2) points. It is
+// direct-mapped, with a number of entries rounded up to a power of 2.
+// With vanishing tolerance only identical x and Q2 values match, so
+// results are unchanged. Else ln(x) and ln(Q2) are rounded to multiples
+// of the tolerance, and the values of the first point in such a bin are
+// reused. Only for PDFs where all values depend only on x and Q2.
+
+void PDF::initCache(int nCacheIn, double tolCacheIn, Info* infoPtrIn) {
+
+  // Switch off, or find size and tolerance.
+  cache.clear();
+  if (nCacheIn <= 0) return;
+  int nCache = 1;
+  while (nCache < nCacheIn) nCache *= 2;
+  cache.resize(nCache);
+  tolCacheInv  = (tolCacheIn > 0.) ? 1. / tolCacheIn : 0.;
+  cacheInfoPtr = infoPtrIn;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Update parton densities, taken from the cache if there.
+
+void PDF::xfUpdateCached(int id, double x, double Q2) {
+
+  // Keys of x and Q2: exact bit patterns, or quantized logarithms.
+  unsigned long long keyX, keyQ2;
+  if (tolCacheInv == 0.) {
+    memcpy( &keyX, &x, sizeof(double));
+    memcpy( &keyQ2, &Q2, sizeof(double));
+  } else {
+    keyX  = (unsigned long long)(llround( log(x) * tolCacheInv));
+    keyQ2 = (unsigned long long)(llround( log(Q2) * tolCacheInv));
+  }
+
+  // Find the entry from a mix of the keys.
+  unsigned long long hash = keyX * 0x9E3779B97F4A7C15ULL
+    ^ keyQ2 * 0xC2B2AE3D27D4EB4FULL;
+  CacheEntry& entry = cache[ (hash ^ (hash >> 31)) & (cache.size() - 1) ];
+
+  // Pointers to the PDF values, in the order they are stored.
+  double* valPtr[NCACHEVAL] = { &xu, &xd, &xs, &xubar, &xdbar, &xsbar,
+    &xc, &xb, &xg, &xlepton, &xgamma, &xuVal, &xuSea, &xdVal, &xdSea,
+    &xsVal, &xcVal, &xbVal, &xsSea, &xcSea, &xbSea };
+
+  // Use the stored values if same point and the flavour is there.
+  if (entry.isUsed && entry.keyX == keyX && entry.keyQ2 == keyQ2
+    && (entry.idSav == 9 || abs(entry.idSav) == abs(id)) ) {
+    idSav = entry.idSav;
+    for (int i = 0; i < NCACHEVAL; ++i) *valPtr[i] = entry.val[i];
+    if (cacheInfoPtr) cacheInfoPtr->addPDFCacheCount(0);
+    return;
+  }
+
+  // Else calculate, and store in place of any older entry.
+  idSav = id;
+  xfUpdate(id, x, Q2);
+  if (cacheInfoPtr) {
+    cacheInfoPtr->addPDFCacheCount(1);
+    if (entry.isUsed) cacheInfoPtr->addPDFCacheCount(2);
+  }
+  entry.keyX   = keyX;
+  entry.keyQ2  = keyQ2;
+  entry.idSav  = idSav;
+  entry.isUsed = true;
+  for (int i = 0; i < NCACHEVAL; ++i) entry.val[i] = *valPtr[i];
+
+}
+
 //==========================================================================
 
 // LHAPDF plugin interface.
@@ -368,6 +446,30 @@ LHAPDF::~LHAPDF() {
 
 //--------------------------------------------------------------------------
 
+// Grids already read in, shared between LHAGrid1 objects.
+
+map<string, weak_ptr<const LHAGrid1Data> > LHAGrid1::gridCache;
+mutex LHAGrid1::gridCacheMutex;
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Number of bins in ln(x) or ln(q) per knot, for the knot search tables.
+const int LHAGrid1::NBINPERKNOT = 16;
+
+// Number of words in the header of a binary grid file, the number that
+// starts such a file, and the version of the format.
+const int LHAGrid1::NBINHEAD = 7;
+const unsigned long long LHAGrid1::BINMAGIC   = 0x3147414C48385950ULL;
+const unsigned long long LHAGrid1::BINVERSION = 1;
+
+// Lower limit of PDF values in the denominator of ratios of PDFs.
+const double LHAGrid1::PDFMINVALUE = 1e-10;
+
+//--------------------------------------------------------------------------
+
 // Initialize PDF: select data file and open stream.
 
 void LHAGrid1::init(string pdfWord, string pdfdataPath, Info* infoPtr) {
@@ -418,6 +520,36 @@ void LHAGrid1::init(string pdfWord, string pdfdataPath, Info* infoPtr) {
   else if (pdfSet == 115) dataFile = pdfdataPath
     + "GKG18_DPDF_FitB_NLO_0000.dat";
 
+  // Read in the file, and remember it for the other members of the set.
+  dataFileSav = dataFile;
+  initFile( dataFile, infoPtr);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Initialize PDF: read in a grid file, or reuse it if already read in.
+
+void LHAGrid1::initFile(string dataFile, Info* infoPtr) {
+
+  // Reuse the grid if the same file has already been read in. The lock
+  // also ensures that a file is only read once by parallel instances.
+  lock_guard<mutex> cacheLock(gridCacheMutex);
+  map<string, weak_ptr<const LHAGrid1Data> >::iterator cacheItr
+    = gridCache.find(dataFile);
+  if (cacheItr != gridCache.end()) {
+    gridPtr = cacheItr->second.lock();
+    if (gridPtr) return;
+  }
+
+  // Binary files, recognized by the .bin ending, are mapped into memory.
+  if (dataFile.length() > 4
+    && dataFile.substr( dataFile.length() - 4) == ".bin") {
+    initBinary( dataFile, infoPtr);
+    if (isSet && gridPtr) gridCache[dataFile] = gridPtr;
+    return;
+  }
+
   // Open files from which grids should be read in.
   ifstream is( dataFile.c_str() );
   if (!is.good()) {
@@ -426,9 +558,10 @@ void LHAGrid1::init(string pdfWord, string pdfdataPath, Info* infoPtr) {
     return;
   }
 
-  // Initialization with a stream.
+  // Initialization with a stream. Store successfully read grid.
   init( is, infoPtr);
   is.close();
+  if (isSet && gridPtr) gridCache[dataFile] = gridPtr;
 
 }
 
@@ -445,11 +578,16 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
     return;
   }
 
-  // Some local variables.
+  // Some local variables. The grid is first built in a local object.
   string line;
   vector<string> idlines, pdflines;
   int nqNow, idNow, idNowMap;
   double xNow, qNow, pdfNow;
+  shared_ptr<LHAGrid1Data> dataPtr = make_shared<LHAGrid1Data>();
+  LHAGrid1Data& grid = *dataPtr;
+  int& nx = grid.nx;
+  int& nq = grid.nq;
+  int& nqSub = grid.nqSub;
 
   // Skip lines of header, until ---. Probe for next subgrid in Q space.
   nqSub = 0;
@@ -467,16 +605,16 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
     istringstream isx(line);
     if (nqSub == 1) {
       while (isx >> xNow) {
-        xGrid.push_back( xNow);
-        lnxGrid.push_back( log(xNow));
+        grid.xGrid.push_back( xNow);
+        grid.lnxGrid.push_back( log(xNow));
       }
-      nx   = xGrid.size();
-      xMin = xGrid.front();
-      xMax = xGrid.back();
+      nx        = grid.xGrid.size();
+      grid.xMin = grid.xGrid.front();
+      grid.xMax = grid.xGrid.back();
     } else {
       int ixc = -1;
       while (isx >> xNow)
-      if ( abs(log(xNow) - lnxGrid[++ixc]) > 1e-5) {
+      if ( abs(log(xNow) - grid.lnxGrid[++ixc]) > 1e-5) {
         printErr("Error in LHAGrid1::init: mismatched subgrid x spacing",
           infoPtr);
         isSet = false;
@@ -490,24 +628,24 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
     nqNow = 0;
     while (isq >> qNow) {
       ++nqNow;
-      qGrid.push_back( qNow);
-      lnqGrid.push_back( log(qNow));
+      grid.qGrid.push_back( qNow);
+      grid.lnqGrid.push_back( log(qNow));
     }
     if (nqSub > 1) {
-      if (abs(qGrid[nq] / qGrid[nq-1] - 1.) > 1e-5) {
+      if (abs(grid.qGrid[nq] / grid.qGrid[nq-1] - 1.) > 1e-5) {
         printErr("Error in LHAGrid1::init: mismatched subgrid Q borders",
           infoPtr);
         isSet = false;
         return;
       }
-      qGrid[nq-1] = 0.5 * (qGrid[nq-1] + qGrid[nq]);
-      qGrid[nq]   = qGrid[nq-1];
+      grid.qGrid[nq-1] = 0.5 * (grid.qGrid[nq-1] + grid.qGrid[nq]);
+      grid.qGrid[nq]   = grid.qGrid[nq-1];
     }
-    nq   = qGrid.size();
-    qMin = qGrid.front();
-    qMax = qGrid.back();
-    nqSum.push_back(nq);
-    qDiv.push_back(qMax);
+    nq        = grid.qGrid.size();
+    grid.qMin = grid.qGrid.front();
+    grid.qMax = grid.qGrid.back();
+    grid.nqSum.push_back(nq);
+    grid.qDiv.push_back(grid.qMax);
 
     // Read in and store flavour mapping and pdf data. Separator line.
     getline( is, line);
@@ -520,13 +658,8 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
   }
 
   // Create array big enough to hold (flavour, x, Q) grid.
-  for (int iid = 0; iid < 12; ++iid) {
-    pdfGrid[iid] = new double*[nq];
-    for (int iq = 0; iq < nq; ++iq) {
-      pdfGrid[iid][iq] = new double[nx];
-      for (int ix = 0; ix < nx; ++ix) pdfGrid[iid][iq][ix] = 0.;
-    }
-  }
+  grid.pdfGrid.assign( 12 * nq * nx, 0.);
+  grid.pdfData = grid.pdfGrid.data();
 
   // Second pass through the Q subranges.
   int iln = -1;
@@ -546,28 +679,300 @@ void LHAGrid1::init(istream& is, Info* infoPtr) {
     int nid = idGridMap.size();
 
     // Read in data grid, line by line.
-    int iq0 = (iqSub == 0) ? 0 : nqSum[iqSub - 1];
+    int iq0 = (iqSub == 0) ? 0 : grid.nqSum[iqSub - 1];
     for (int ix = 0; ix < nx; ++ix)
-    for (int iq = iq0; iq < nqSum[iqSub]; ++iq) {
+    for (int iq = iq0; iq < grid.nqSum[iqSub]; ++iq) {
       istringstream ispdf( pdflines[++iln] );
       for (int iid = 0; iid < nid; ++iid) {
         ispdf >> pdfNow;
-        if (idGridMap[iid] >= 0) pdfGrid[idGridMap[iid]][iq][ix] = pdfNow;
+        if (idGridMap[iid] >= 0)
+          grid.pdfGrid[(iq * nx + ix) * 12 + idGridMap[iid]] = pdfNow;
       }
     }
   }
 
-  // For extrapolation to small x: create array for b values of x^b shape.
-  pdfSlope = new double*[12];
-  for (int iid = 0; iid < 12; ++iid) {
-    pdfSlope[iid] = new double[nq];
-    for (int iq = 0; iq < nq; ++iq) { pdfSlope[iid][iq] =
-      ( min( pdfGrid[iid][iq][0], pdfGrid[iid][iq][1]) > 1e-5
-      && abs(lnxGrid[1] - lnxGrid[0]) > 1e-5)
-      ? ( log(pdfGrid[iid][iq][1]) - log(pdfGrid[iid][iq][0]) )
-      / (lnxGrid[1] - lnxGrid[0]) : 0.;
+  // Set up derived quantities. Done. The grid is not changed from now on.
+  initDerived( grid);
+  gridPtr = dataPtr;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read in the other members of the set, for PDF uncertainties, in files
+// named as in LHAPDF6, where the member number replaces the 0000 of the
+// central member, and where the error type is given in the .info file
+// of the set. The members are in .bin files if the central one is.
+// The number of members found is returned.
+
+int LHAGrid1::initMembers(int nMembersIn, Info* infoPtr) {
+
+  // Start from the central member only.
+  memberPtrs.clear();
+  errorType = 0;
+  if (!isSet || !gridPtr) return 0;
+  memberPtrs.push_back( gridPtr);
+  size_t iPos = dataFileSav.rfind("_0000.");
+  string suffix = (iPos == string::npos) ? "" : dataFileSav.substr( iPos + 5);
+  if (suffix != ".dat" && suffix != ".bin") {
+    printErr("Error in LHAGrid1::initMembers: file name does not end in"
+      " _0000.dat or _0000.bin", infoPtr);
+    return nMembers();
+  }
+
+  // Read the members, as long as found. They must have the same knots,
+  // so that the search and the interpolation weights can be shared.
+  shared_ptr<const LHAGrid1Data> centralPtr = gridPtr;
+  for (int iMem = 1; iMem < nMembersIn; ++iMem) {
+    string memberNum = to_string(iMem);
+    memberNum = string( max( 0, 4 - int(memberNum.length())), '0')
+      + memberNum;
+    string memberFile = dataFileSav.substr( 0, iPos + 1) + memberNum
+      + suffix;
+    if (!ifstream( memberFile.c_str()).good()) break;
+    initFile( memberFile, infoPtr);
+    bool isSame = isSet && gridPtr && gridPtr->xGrid == centralPtr->xGrid
+      && gridPtr->qGrid == centralPtr->qGrid
+      && gridPtr->lnqGrid == centralPtr->lnqGrid
+      && gridPtr->nqSum == centralPtr->nqSum;
+    if (isSame) memberPtrs.push_back( gridPtr);
+    gridPtr = centralPtr;
+    isSet   = true;
+    if (!isSame) {
+      printErr("Error in LHAGrid1::initMembers: other knots in "
+        + memberFile, infoPtr);
+      break;
     }
   }
+  if (nMembers() < nMembersIn) printErr("Warning in LHAGrid1::initMembers:"
+    " fewer members found than asked for", infoPtr);
+
+  // Error type of the set, by default replicas.
+  ifstream isInfo( (dataFileSav.substr( 0, iPos) + ".info").c_str() );
+  string line;
+  while (getline( isInfo, line)) if (line.find("ErrorType:") == 0) {
+    if      (line.find("symmhessian") != string::npos) errorType = 1;
+    else if (line.find("hessian") != string::npos)     errorType = 2;
+  }
+  return nMembers();
+
+}
+
+//--------------------------------------------------------------------------
+
+// Initialize PDF: map a binary grid file into memory and check it. The
+// x and q knots are copied, while the grid values are used in place, so
+// that the memory pages holding them can be shared between processes.
+
+void LHAGrid1::initBinary(string binFile, Info* infoPtr) {
+
+  // Map the file into memory, read-only.
+  isSet = false;
+  int fd = ::open( binFile.c_str(), O_RDONLY);
+  if (fd < 0) {
+    printErr("Error in LHAGrid1::initBinary: did not find data file",
+      infoPtr);
+    return;
+  }
+  struct stat fileStat;
+  size_t nBytes = (fstat( fd, &fileStat) == 0) ? fileStat.st_size : 0;
+  void* mapNow = (nBytes > 0) ? mmap( 0, nBytes, PROT_READ, MAP_SHARED,
+    fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if (mapNow == MAP_FAILED) {
+    printErr("Error in LHAGrid1::initBinary: could not map data file",
+      infoPtr);
+    return;
+  }
+  shared_ptr<const char> mapPtr( static_cast<const char*>(mapNow),
+    [nBytes](const char* ptr) {munmap( const_cast<char*>(ptr), nBytes);} );
+
+  // Check the header: format, sizes consistent with the file size.
+  const unsigned long long* words
+    = reinterpret_cast<const unsigned long long*>(mapPtr.get());
+  size_t nWords = nBytes / sizeof(unsigned long long);
+  bool isOK = nBytes % sizeof(unsigned long long) == 0
+    && nWords >= size_t(NBINHEAD) && words[0] == BINMAGIC
+    && words[1] == BINVERSION && words[5] == nWords - NBINHEAD;
+  int nx    = isOK ? int(words[2]) : 0;
+  int nq    = isOK ? int(words[3]) : 0;
+  int nqSub = isOK ? int(words[4]) : 0;
+  isOK = isOK && nx >= 2 && nq >= 1 && nqSub >= 1 && words[5]
+    == 2 * size_t(nqSub + nx + nq) + 12 * size_t(nx) * nq;
+
+  // Check the subgrid sizes, and the checksum of all after the header.
+  const unsigned long long* wordNow = words + NBINHEAD;
+  for (int iqSub = 0; isOK && iqSub < nqSub; ++iqSub)
+    isOK = wordNow[iqSub] > (iqSub == 0 ? 0 : wordNow[iqSub - 1])
+      && wordNow[iqSub] <= (unsigned long long)(nq);
+  isOK = isOK && wordNow[nqSub - 1] == (unsigned long long)(nq)
+    && binChecksum( wordNow, nWords - NBINHEAD) == words[6];
+  if (!isOK) {
+    printErr("Error in LHAGrid1::initBinary: data file is corrupt or"
+      " of wrong format", infoPtr);
+    return;
+  }
+
+  // Read the subgrids and knots.
+  shared_ptr<LHAGrid1Data> dataPtr = make_shared<LHAGrid1Data>();
+  LHAGrid1Data& grid = *dataPtr;
+  grid.nx    = nx;
+  grid.nq    = nq;
+  grid.nqSub = nqSub;
+  for (int iqSub = 0; iqSub < nqSub; ++iqSub)
+    grid.nqSum.push_back( int(*wordNow++));
+  auto readDoubles = [&wordNow](vector<double>& val, int nVal) {
+    val.resize(nVal);
+    memcpy( val.data(), wordNow, nVal * sizeof(double));
+    wordNow += nVal; };
+  readDoubles( grid.qDiv, nqSub);
+  readDoubles( grid.xGrid, nx);
+  readDoubles( grid.lnxGrid, nx);
+  readDoubles( grid.qGrid, nq);
+  readDoubles( grid.lnqGrid, nq);
+  grid.xMin = grid.xGrid.front();
+  grid.xMax = grid.xGrid.back();
+  grid.qMin = grid.qGrid.front();
+  grid.qMax = grid.qGrid.back();
+
+  // The grid values are used where they are in the file.
+  grid.pdfData = reinterpret_cast<const double*>(wordNow);
+  grid.mapPtr  = mapPtr;
+
+  // Set up derived quantities. Done. The grid is not changed from now on.
+  initDerived( grid);
+  gridPtr = dataPtr;
+  isSet   = true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up the quantities derived from the grid values and knots.
+
+void LHAGrid1::initDerived(LHAGrid1Data& grid) {
+
+  // Local copies of the grid size.
+  int nx = grid.nx;
+  int nq = grid.nq;
+
+  // For extrapolation to small x: create array for b values of x^b shape.
+  grid.pdfSlope.assign( 12 * nq, 0.);
+  for (int iid = 0; iid < 12; ++iid)
+  for (int iq = 0; iq < nq; ++iq) {
+    double pdf0 = grid.grid( iid, iq, 0);
+    double pdf1 = grid.grid( iid, iq, 1);
+    grid.pdfSlope[iq * 12 + iid] = ( min( pdf0, pdf1) > 1e-5
+      && abs(grid.lnxGrid[1] - grid.lnxGrid[0]) > 1e-5)
+      ? ( log(pdf1) - log(pdf0) ) / (grid.lnxGrid[1] - grid.lnxGrid[0]) : 0.;
+  }
+
+  // Denominators of the cubic interpolation weights, for each set of four
+  // consecutive knots in ln(x) and in ln(q).
+  grid.lnxDen.assign( 16 * nx, 0.);
+  for (int m3 = 0; m3 + 3 < nx; ++m3)
+  for (int i3 = 0; i3 < 4; ++i3)
+  for (int j = 0; j < 4; ++j) grid.lnxDen[(m3 * 4 + i3) * 4 + j]
+    = grid.lnxGrid[m3 + i3] - grid.lnxGrid[m3 + j];
+  grid.lnqDen.assign( 16 * nq, 0.);
+  for (int m3 = 0; m3 + 3 < nq; ++m3)
+  for (int i3 = 0; i3 < 4; ++i3)
+  for (int j = 0; j < 4; ++j) grid.lnqDen[(m3 * 4 + i3) * 4 + j]
+    = grid.lnqGrid[m3 + i3] - grid.lnqGrid[m3 + j];
+
+  // Knots to start the search from, for bins in ln(x) and ln(q) finer
+  // than the average knot spacing.
+  int nxBin = NBINPERKNOT * nx;
+  double lnxRange = grid.lnxGrid[nx - 1] - grid.lnxGrid[0];
+  grid.lnxBinInv = (lnxRange > 0.) ? nxBin / lnxRange : 0.;
+  grid.ixBin.resize( nxBin);
+  for (int ib = 0, ix = 0; ib < nxBin; ++ib) {
+    double lnxEdge = grid.lnxGrid[0] + ib * lnxRange / nxBin;
+    while (ix < nx - 2 && grid.lnxGrid[ix + 1] <= lnxEdge) ++ix;
+    grid.ixBin[ib] = ix;
+  }
+  int nqBin = NBINPERKNOT * nq;
+  double lnqRange = grid.lnqGrid[nq - 1] - grid.lnqGrid[0];
+  grid.lnqBinInv = (lnqRange > 0.) ? nqBin / lnqRange : 0.;
+  grid.iqBin.resize( nqBin);
+  for (int ib = 0, iq = 0; ib < nqBin; ++ib) {
+    double lnqEdge = grid.lnqGrid[0] + ib * lnqRange / nqBin;
+    while (iq < nq - 2 && grid.lnqGrid[iq + 1] <= lnqEdge) ++iq;
+    grid.iqBin[ib] = iq;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Convert a grid file to the binary format. This is a header of NBINHEAD
+// 64-bit words, with the format, the grid size, the number of words after
+// the header and their checksum, followed by the end of each Q subgrid,
+// the subgrid borders, the x knots and their logarithms, the q knots
+// and their logarithms, and the grid values, all in the native byte
+// order. The file thus has to be made on the same kind of machine.
+
+bool LHAGrid1::convertToBinary(string asciiFile, string binFile,
+  Info* infoPtr) {
+
+  // Read the grid file in the normal way.
+  ifstream is( asciiFile.c_str() );
+  LHAGrid1 pdf( 2212, is, infoPtr);
+  is.close();
+  if (!pdf.isSet || !pdf.gridPtr) return false;
+  const LHAGrid1Data& grid = *pdf.gridPtr;
+
+  // Collect the words after the header.
+  vector<unsigned long long> words( NBINHEAD, 0);
+  for (int iqSub = 0; iqSub < grid.nqSub; ++iqSub)
+    words.push_back( grid.nqSum[iqSub]);
+  auto addDoubles = [&words](const double* val, int nVal) {
+    size_t nOld = words.size();
+    words.resize( nOld + nVal);
+    memcpy( &words[nOld], val, nVal * sizeof(double)); };
+  addDoubles( grid.qDiv.data(), grid.nqSub);
+  addDoubles( grid.xGrid.data(), grid.nx);
+  addDoubles( grid.lnxGrid.data(), grid.nx);
+  addDoubles( grid.qGrid.data(), grid.nq);
+  addDoubles( grid.lnqGrid.data(), grid.nq);
+  addDoubles( grid.pdfData, 12 * grid.nx * grid.nq);
+
+  // Header.
+  words[0] = BINMAGIC;
+  words[1] = BINVERSION;
+  words[2] = grid.nx;
+  words[3] = grid.nq;
+  words[4] = grid.nqSub;
+  words[5] = words.size() - NBINHEAD;
+  words[6] = binChecksum( &words[NBINHEAD], words.size() - NBINHEAD);
+
+  // Write the file.
+  ofstream os( binFile.c_str(), ios::binary);
+  os.write( reinterpret_cast<const char*>(words.data()),
+    words.size() * sizeof(unsigned long long));
+  os.close();
+  if (!os) {
+    pdf.printErr("Error in LHAGrid1::convertToBinary: could not write"
+      " binary file", infoPtr);
+    return false;
+  }
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Checksum of words: the 64-bit FNV-1a hash, taking a word at a time.
+
+unsigned long long LHAGrid1::binChecksum(const unsigned long long* words,
+  size_t nWords) {
+
+  unsigned long long sum = 0xCBF29CE484222325ULL;
+  for (size_t i = 0; i < nWords; ++i) {
+    sum ^= words[i];
+    sum *= 0x100000001B3ULL;
+  }
+  return sum;
 
 }
 
@@ -610,102 +1015,363 @@ void LHAGrid1::xfUpdate(int , double x, double Q2) {
 
 //--------------------------------------------------------------------------
 
+// Interpolate all flavours at a single point, stored in pdfVal.
+
 void LHAGrid1::xfxevolve(double x, double Q2) {
 
-  // Find if (x, Q) inside our outside grid.
-  double q = sqrt(Q2);
-  int inx  = (x <= xMin) ? -1 : ((x >= xMax) ? 1 : 0);
-  int inq  = (q <= qMin) ? -1 : ((q >= qMax) ? 1 : 0);
+  // Find the interpolation weights, and interpolate all flavours.
+  int    inx, m3x, m3q, n3q;
+  double wx[4], wq[4];
+  xWeights( x, inx, m3x, wx);
+  qWeights( Q2, m3q, n3q, wq);
+  interpolate( x, inx, m3x, wx, m3q, n3q, wq, pdfVal);
 
-  // Set up default for x interpolation.
-  int    minx  = 0;
-  int    maxx  = nx - 1;
-  int    m3x   = 0;
-  double wx[4] = {1., 1., 1., 1.};
+}
 
-  // Find grid value on either side of x.
-  if (inx == 0) {
-    int midx;
-    while (maxx - minx > 1) {
-      midx = (minx + maxx) / 2;
-      if (x < xGrid[midx]) maxx = midx;
-      else                 minx = midx;
-    }
+//--------------------------------------------------------------------------
 
-    // Weights for cubic interpolation in ln(x).
-    double lnx = log(x);
-    if      (minx == 0)      m3x = 0;
-    else if (maxx == nx - 1) m3x = nx - 4;
-    else                     m3x = minx - 1;
-    for (int i3 = 0; i3 < 4; ++i3)
-    for (int j = 0; j < 4; ++j) if (j != i3)
-      wx[i3] *= (lnx - lnxGrid[m3x+j]) / (lnxGrid[m3x+i3] - lnxGrid[m3x+j]);
+// Evaluate all flavours at many points. The interpolation weights are
+// only recalculated when x or Q2 change from one point to the next, so
+// points sharing the same Q2, or x, are best given in sequence.
+
+void LHAGrid1::xfxBatch(const double* x, const double* Q2, size_t n,
+  double* out) const {
+
+  // No PDF values if not properly set up.
+  if (!isSet || !gridPtr) {
+    for (size_t i = 0; i < 12 * n; ++i) out[i] = 0.;
+    return;
+  }
+
+  // Loop over points, with weights only updated when needed.
+  int    inx = 0, m3x = 0, m3q = 0, n3q = 1;
+  double wx[4], wq[4];
+  for (size_t i = 0; i < n; ++i) {
+    if (i == 0 || x[i] != x[i - 1]) xWeights( x[i], inx, m3x, wx);
+    if (i == 0 || Q2[i] != Q2[i - 1]) qWeights( Q2[i], m3q, n3q, wq);
+    interpolate( x[i], inx, m3x, wx, m3q, n3q, wq, out + 12 * i);
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Evaluate flavour id for all members at (x, Q2). Like for xfxBatch the
+// beam is not taken into account.
+
+void LHAGrid1::xfxMembers(int id, double x, double Q2, double* xfOut)
+  const {
+
+  memberValues( id, x, Q2, 0, xfOut);
+
+}
+
+//--------------------------------------------------------------------------
+
+// PDF uncertainties of flavour idNow at (xNow, Q2Now), from the spread of
+// the member values. Like for LHAPDF6, valSea = 1 (2) gives the valence
+// (sea) part of u and d quarks.
+
+void LHAGrid1::calcPDFEnvelope(int idNow, double xNow, double Q2Now,
+  int valSea) {
+
+  // Values of all members, with flavours conjugated for antiparticles.
+  xfMemSav.resize( nMembers());
+  memberValues( (idBeam < 0) ? -idNow : idNow, xNow, Q2Now, valSea,
+    xfMemSav.data());
+  calcEnvelope( xfMemSav);
+
+}
+
+//--------------------------------------------------------------------------
+
+// PDF uncertainties of the ratio of flavour idNows.first at xNows.first
+// to flavour idNows.second at xNows.second, both at Q2Now. The ratios of
+// the members are also stored, for variations to single members.
+
+void LHAGrid1::calcPDFEnvelope(pair<int,int> idNows,
+  pair<double,double> xNows, double Q2Now, int valSea) {
+
+  // Values of all members, with flavours conjugated for antiparticles.
+  int nMem = nMembers();
+  int sign = (idBeam < 0) ? -1 : 1;
+  xfMemSav.resize( nMem);
+  xfMemSav2.resize( nMem);
+  memberValues( sign * idNows.first, xNows.first, Q2Now, valSea,
+    xfMemSav.data());
+  memberValues( sign * idNows.second, xNows.second, Q2Now, valSea,
+    xfMemSav2.data());
+
+  // Ratios, and the uncertainties of them.
+  pdfEnvelope.pdfMemberVars.resize( nMem);
+  for (int iMem = 0; iMem < nMem; ++iMem) {
+    xfMemSav[iMem] = max( 0., xfMemSav[iMem])
+      / max( PDFMINVALUE, xfMemSav2[iMem]);
+    pdfEnvelope.pdfMemberVars[iMem] = xfMemSav[iMem];
+  }
+  calcEnvelope( xfMemSav);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Values of flavour id for all members at (x, Q2), or of the valence
+// (valSea = 1) or sea (valSea = 2) part for u and d quarks. The search
+// in the grid and the interpolation weights are found once, and only
+// the flavours needed are interpolated for each member.
+
+void LHAGrid1::memberValues(int id, double x, double Q2, int valSea,
+  double* val) const {
+
+  // Grid index of a flavour, -1 if not in the grid.
+  auto gridIndex = [](int idIn) {
+    if (idIn == 21 || idIn == 0) return 0;
+    if (idIn > 0 && idIn < 6)    return idIn;
+    if (idIn < 0 && idIn > -6)   return 5 - idIn;
+    return (idIn == 22) ? 11 : -1; };
+
+  // Flavours to add and to subtract. No values if not properly set up.
+  int  nMem    = max( 1, int(memberPtrs.size()));
+  bool isValQ  = (id == 1 || id == 2);
+  int  iidAdd  = gridIndex( (valSea == 2 && isValQ) ? -id : id);
+  int  iidSub  = (valSea == 1 && isValQ) ? gridIndex( -id) : -1;
+  if (!isSet || !gridPtr || iidAdd < 0) {
+    for (int iMem = 0; iMem < nMem; ++iMem) val[iMem] = 0.;
+    return;
+  }
+
+  // Search and interpolation weights, shared by all members.
+  int    inx, m3x, m3q, n3q;
+  double wx[4], wq[4];
+  xWeights( x, inx, m3x, wx);
+  qWeights( Q2, m3q, n3q, wq);
+  const int nx = gridPtr->nx;
+
+  // Interpolation of one flavour, in the same way as in interpolate.
+  auto interpolateOne = [&](const LHAGrid1Data& grid, int iid) {
+    double sum = 0.;
+    if (inx == 0) for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* pdf = &grid.pdfData[((m3q + i3q) * nx + m3x) * 12 + iid];
+      sum += wq[i3q] * (wx[0] * pdf[0] + wx[1] * pdf[12]
+        + wx[2] * pdf[24] + wx[3] * pdf[36] );
+    } else if (inx == -1) for (int i3q = 0; i3q < n3q; ++i3q)
+      sum += wq[i3q] * grid.grid( iid, m3q + i3q, 0)
+        * (doExtraPol ? pow( x / grid.xMin,
+          grid.pdfSlope[(m3q + i3q) * 12 + iid]) : 1.);
+    return sum; };
+
+  // Loop over the members.
+  for (int iMem = 0; iMem < nMem; ++iMem) {
+    const LHAGrid1Data& grid = memberPtrs.empty() ? *gridPtr
+      : *memberPtrs[iMem];
+    val[iMem] = interpolateOne( grid, iidAdd);
+    if (iidSub >= 0) val[iMem] -= interpolateOne( grid, iidSub);
   }
 
+}
+
+//--------------------------------------------------------------------------
+
+// PDF uncertainties from the member values, with the same formulae as
+// in LHAPDF6, but without any rescaling to another confidence level.
+
+void LHAGrid1::calcEnvelope(const vector<double>& xfCalc) {
+
+  // Central value and uncertainties, for a single member.
+  int    nMem     = xfCalc.size();
+  int    nErr     = nMem - 1;
+  double central  = xfCalc[0];
+  double errPlus  = 0.;
+  double errMinus = 0.;
+  double errSymm  = 0.;
+
+  // Replicas: average and standard deviation of the replicas.
+  if (errorType == 0 && nErr > 0) {
+    double average = 0.;
+    double spread  = 0.;
+    for (int iMem = 1; iMem < nMem; ++iMem) {
+      average += xfCalc[iMem];
+      spread  += pow2(xfCalc[iMem]);
+    }
+    average /= nErr;
+    spread   = (nErr > 1) ? nErr / (nErr - 1.) * (spread / nErr
+      - pow2(average)) : 0.;
+    central  = average;
+    errPlus  = errMinus = errSymm = (spread > 0.) ? sqrt(spread) : 0.;
+
+  // Symmetric Hessian: sum in quadrature of deviations from central.
+  } else if (errorType == 1) {
+    for (int iMem = 1; iMem < nMem; ++iMem)
+      errSymm += pow2(xfCalc[iMem] - xfCalc[0]);
+    errPlus = errMinus = errSymm = sqrt(errSymm);
+
+  // Asymmetric Hessian: pairs of members for each eigenvector.
+  } else if (errorType == 2) {
+    for (int iEig = 1; 2 * iEig < nMem; ++iEig) {
+      double up = xfCalc[2 * iEig - 1] - xfCalc[0];
+      double dn = xfCalc[2 * iEig] - xfCalc[0];
+      errPlus  += pow2( max( max( up, dn), 0.));
+      errMinus += pow2( max( max( -up, -dn), 0.));
+      errSymm  += pow2( up - dn);
+    }
+    errPlus  = sqrt(errPlus);
+    errMinus = sqrt(errMinus);
+    errSymm  = 0.5 * sqrt(errSymm);
+  }
+
+  // Store results.
+  pdfEnvelope.centralPDF  = central;
+  pdfEnvelope.errplusPDF  = errPlus;
+  pdfEnvelope.errminusPDF = errMinus;
+  pdfEnvelope.errsymmPDF  = errSymm;
+  pdfEnvelope.scalePDF    = 1.;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find where x is in the grid, and the weights for cubic interpolation
+// in ln(x). inx = -1 (+1) if x is below (above) the grid range. A NaN x
+// is treated as below the range, so that no bin is found from it.
+
+void LHAGrid1::xWeights(double x, int& inx, int& m3x, double wx[4]) const {
+
+  // Local references to the shared grid.
+  const LHAGrid1Data& grid = *gridPtr;
+  const int nx = grid.nx;
+
+  // Set up default for x interpolation.
+  inx   = !(x > grid.xMin) ? -1 : ((x >= grid.xMax) ? 1 : 0);
+  m3x   = 0;
+  wx[0] = wx[1] = wx[2] = wx[3] = 1.;
+  if (inx != 0) return;
+
+  // Find grid value on either side of x, by stepping from the knot
+  // tabulated for the ln(x) bin. Same result as a binary search.
+  double lnx = log(x);
+  int ib   = max( 0, min( int(grid.ixBin.size()) - 1,
+    int( (lnx - grid.lnxGrid[0]) * grid.lnxBinInv) ) );
+  int minx = grid.ixBin[ib];
+  while (minx > 0 && x < grid.xGrid[minx]) --minx;
+  while (minx < nx - 2 && x >= grid.xGrid[minx + 1]) ++minx;
+  int maxx = minx + 1;
+
+  // Weights for cubic interpolation in ln(x).
+  if      (minx == 0)      m3x = 0;
+  else if (maxx == nx - 1) m3x = nx - 4;
+  else                     m3x = minx - 1;
+  const double* lnxKnot = &grid.lnxGrid[m3x];
+  const double* lnxDen  = &grid.lnxDen[16 * m3x];
+  for (int i3 = 0; i3 < 4; ++i3)
+  for (int j = 0; j < 4; ++j) if (j != i3)
+    wx[i3] *= (lnx - lnxKnot[j]) / lnxDen[i3 * 4 + j];
+
+}
+
+//--------------------------------------------------------------------------
+
+// Find where Q2 is in the grid, and the weights for cubic interpolation
+// in ln(q), or linear if the Q subgrid has fewer than four knots. The
+// n3q weights apply from q knot m3q onwards.
+
+void LHAGrid1::qWeights(double Q2, int& m3q, int& n3q, double wq[4]) const {
+
+  // Local references to the shared grid.
+  const LHAGrid1Data& grid = *gridPtr;
+  const vector<double>& lnqGrid = grid.lnqGrid;
+  const vector<int>& nqSum = grid.nqSum;
+
+  // Find if q inside our outside grid. A NaN q counts as below it.
+  double q = sqrt(Q2);
+  int inq  = !(q > grid.qMin) ? -1 : ((q >= grid.qMax) ? 1 : 0);
+
   // Find q subgrid and set up default for q interpolation.
   int    iqDiv = 0;
-  for (int iqSub = 1; iqSub < nqSub; ++iqSub)
-    if (q > qDiv[iqSub - 1]) iqDiv = iqSub;
+  for (int iqSub = 1; iqSub < grid.nqSub; ++iqSub)
+    if (q > grid.qDiv[iqSub - 1]) iqDiv = iqSub;
   int    minS  = (iqDiv == 0) ? 0 : nqSum[iqDiv - 1];
   int    maxS  = nqSum[iqDiv] - 1;
   int    minq  = minS;
   int    maxq  = maxS;
-  int    n3q   = 4;
-  int    m3q   = 0.;
-  double wq[4] = {1., 1., 1., 1.};
-
-  // Find grid value on either side of q.
-  if (inq == 0) {
-    int midq;
-    while (maxq - minq > 1) {
-      midq = (minq + maxq) / 2;
-      if (q < qGrid[midq]) maxq = midq;
-      else                 minq = midq;
-    }
-
-    // Weights for linear or cubic interpolation in ln(q).
-    double lnq = log(q);
-    if (maxS - minS < 3) {
-      n3q = 2;
-      m3q = minq;
-      wq[1] = (lnq - lnqGrid[minq]) / (lnqGrid[maxq] - lnqGrid[minq]);
-      wq[0] = 1. - wq[1];
-    } else {
-      if      (minq == minS) m3q = minS;
-      else if (maxq == maxS) m3q = maxS - 3;
-      else                   m3q = minq - 1;
-      for (int i3 = 0; i3 < 4; ++i3)
-      for (int j = 0; j < 4; ++j) if (j != i3)
-        wq[i3] *= (lnq - lnqGrid[m3q+j]) / (lnqGrid[m3q+i3] - lnqGrid[m3q+j]);
-    }
+  n3q   = 4;
+  m3q   = 0;
+  wq[0] = wq[1] = wq[2] = wq[3] = 1.;
 
   // Freeze at border of q range.
-  } else {
+  if (inq != 0) {
     n3q = 1;
-    if (inq == 1) m3q = nq - 1;
+    if (inq == 1) m3q = grid.nq - 1;
+    return;
   }
 
+  // Find grid value on either side of q inside the subgrid, by stepping
+  // from the knot tabulated for the ln(q) bin, like for x.
+  double lnq = log(q);
+  if (maxS > minS) {
+    int ib = max( 0, min( int(grid.iqBin.size()) - 1,
+      int( (lnq - lnqGrid[0]) * grid.lnqBinInv) ) );
+    minq   = max( minS, min( maxS - 1, grid.iqBin[ib]) );
+    while (minq > minS && q < grid.qGrid[minq]) --minq;
+    while (minq < maxS - 1 && q >= grid.qGrid[minq + 1]) ++minq;
+    maxq   = minq + 1;
+  }
+
+  // Weights for linear or cubic interpolation in ln(q).
+  if (maxS - minS < 3) {
+    n3q = 2;
+    m3q = minq;
+    wq[1] = (lnq - lnqGrid[minq]) / (lnqGrid[maxq] - lnqGrid[minq]);
+    wq[0] = 1. - wq[1];
+  } else {
+    if      (minq == minS) m3q = minS;
+    else if (maxq == maxS) m3q = maxS - 3;
+    else                   m3q = minq - 1;
+    const double* lnqKnot = &lnqGrid[m3q];
+    const double* lnqDen  = &grid.lnqDen[16 * m3q];
+    for (int i3 = 0; i3 < 4; ++i3)
+    for (int j = 0; j < 4; ++j) if (j != i3)
+      wq[i3] *= (lnq - lnqKnot[j]) / lnqDen[i3 * 4 + j];
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Interpolate all twelve flavours with the given weights, and store
+// the results in val.
+
+void LHAGrid1::interpolate(double x, int inx, int m3x, const double wx[4],
+  int m3q, int n3q, const double wq[4], double* val) const {
+
+  // Local references to the shared grid.
+  const LHAGrid1Data& grid = *gridPtr;
+  const int nx = grid.nx;
+
   // Interpolate between grid elements, normally bicubic, or simpler in ln(q).
+  // The flavours are innermost, in the grid and in the loops.
   if (inx == 0) {
-    for (int iid = 0; iid < 12; ++iid) {
-      double **ppdf = pdfGrid[iid] + m3q;
-      double sum0 = 0.;
-      for (int i3q = 0; i3q < n3q; ++i3q) {
-        double *pdf = ppdf[i3q] + m3x;
-        sum0 +=  wq[i3q] * (wx[0] * pdf[0] + wx[1] * pdf[1] + wx[2] * pdf[2]
-              + wx[3] * pdf[3] );
-      }
-      pdfVal[iid] = sum0;
+    double sum[12] = {};
+    for (int i3q = 0; i3q < n3q; ++i3q) {
+      const double* pdf = &grid.pdfData[((m3q + i3q) * nx + m3x) * 12];
+      for (int iid = 0; iid < 12; ++iid)
+        sum[iid] += wq[i3q] * (wx[0] * pdf[iid] + wx[1] * pdf[iid + 12]
+          + wx[2] * pdf[iid + 24] + wx[3] * pdf[iid + 36] );
     }
+    for (int iid = 0; iid < 12; ++iid) val[iid] = sum[iid];
 
-  // Special: extrapolate to small x. (Let vanish at large x, so no such code.)
+  // Special: extrapolate to small x.
   } else if (inx == -1) {
     for (int iid = 0; iid < 12; ++iid) {
-      pdfVal[iid] = 0.;
+      val[iid] = 0.;
       for (int i3q = 0; i3q < n3q; ++i3q)
-        pdfVal[iid] += wq[i3q] * pdfGrid[iid][m3q+i3q][0]
-          * (doExtraPol ? pow( x / xMin, pdfSlope[iid][m3q+i3q]) : 1.);
+        val[iid] += wq[i3q] * grid.grid( iid, m3q + i3q, 0)
+          * (doExtraPol ? pow( x / grid.xMin,
+            grid.pdfSlope[(m3q + i3q) * 12 + iid]) : 1.);
     }
+
+  // Let vanish at large x.
+  } else {
+    for (int iid = 0; iid < 12; ++iid) val[iid] = 0.;
   }
 
 }
@@ -592,6 +592,32 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
   yCoef[2]   = 0.5;
   zCoef[0]   = 1.;
 
+  // The coefficients and maximum may be found in the cache, unless
+  // user hooks could modify the cross section.
+  InitCache* initCachePtr = infoPtr->initCachePtr;
+  bool   useCache = (initCachePtr != 0 && initCachePtr->isOn()
+    && !canModifySigma && !canBiasSelection);
+  string cacheTag;
+  if (useCache) {
+    cacheTag = initCachePtr->tag( "PhaseSpace:"
+      + to_string(sigmaProcessPtr->code()) );
+    vector<double> table;
+    if (initCachePtr->get( cacheTag, table) && table.size() == 25) {
+      for (int i = 0; i < 8; ++i) {
+        tauCoef[i] = table[i];
+        yCoef[i]   = table[8 + i];
+        zCoef[i]   = table[16 + i];
+      }
+      sigmaMx  = table[24];
+      sigmaPos = sigmaMx;
+      setupCoefSum();
+      if (showSearch) cout << " Final maximum = "  << setw(11) << sigmaMx
+        << ", taken from cache" << endl;
+      return true;
+    }
+    initCachePtr->startTable( cacheTag);
+  }
+
   // Step through grid in tau. Set limits on y and z generation.
   for (int iTau = 0; iTau < nTau; ++iTau) {
     double posTau = 0.5;
@@ -718,6 +744,7 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
   // Fail if no non-vanishing cross sections.
   if (sigmaMx <= 0.) {
     sigmaMx = 0.;
+    if (useCache) initCachePtr->endTable();
     return false;
   }
 
@@ -730,19 +757,7 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
   if (showSearch) cout << "\n";
 
   // Provide cumulative sum of coefficients.
-  tauCoefSum[0] = tauCoef[0];
-    yCoefSum[0] =   yCoef[0];
-    zCoefSum[0] =   zCoef[0];
-  for (int i = 1; i < 8; ++ i) {
-    tauCoefSum[i] = tauCoefSum[i - 1] + tauCoef[i];
-      yCoefSum[i] =   yCoefSum[i - 1] +   yCoef[i];
-      zCoefSum[i] =   zCoefSum[i - 1] +   zCoef[i];
-  }
-  // The last element should be > 1 to be on safe side in selection below.
-  tauCoefSum[nTau - 1] = 2.;
-    yCoefSum[nY   - 1] = 2.;
-    zCoefSum[nZ   - 1] = 2.;
-
+  setupCoefSum();
 
   // Begin find two most promising maxima among same points as before.
   int iMaxTau[NMAXTRY + 2], iMaxY[NMAXTRY + 2], iMaxZ[NMAXTRY + 2];
@@ -978,12 +993,43 @@ bool PhaseSpace::setupSampling123(bool is2, bool is3) {
   if (showSearch) cout << "\n Final maximum = "  << setw(11) << sigmaMx
     << endl;
 
+  // Store coefficients and maximum in the cache.
+  if (useCache) {
+    vector<double> table( tauCoef, tauCoef + 8);
+    table.insert( table.end(), yCoef, yCoef + 8);
+    table.insert( table.end(), zCoef, zCoef + 8);
+    table.push_back( sigmaMx);
+    initCachePtr->set( cacheTag, table);
+  }
+
   // Done.
   return true;
 }
 
 //--------------------------------------------------------------------------
 
+// Provide cumulative sum of phase-space coefficients.
+
+void PhaseSpace::setupCoefSum() {
+
+  tauCoefSum[0] = tauCoef[0];
+    yCoefSum[0] =   yCoef[0];
+    zCoefSum[0] =   zCoef[0];
+  for (int i = 1; i < 8; ++ i) {
+    tauCoefSum[i] = tauCoefSum[i - 1] + tauCoef[i];
+      yCoefSum[i] =   yCoefSum[i - 1] +   yCoef[i];
+      zCoefSum[i] =   zCoefSum[i - 1] +   zCoef[i];
+  }
+
+  // The last element should be > 1 to be on safe side in selection.
+  tauCoefSum[nTau - 1] = 2.;
+    yCoefSum[nY   - 1] = 2.;
+    zCoefSum[nZ   - 1] = 2.;
+
+}
+
+//--------------------------------------------------------------------------
+
 // Select a trial kinematics phase space point.
 // Note: by In is meant the integral over the quantity multiplying
 // coefficient cn. The sum of cn is normalized to unity.
@@ -512,14 +512,31 @@ bool Pythia::init() {
     return false;
   }
 
-  // Initialize the random number generator.
-  if ( settings.flag("Random:setSeed") )
-    rndm.init( settings.mode("Random:seed") );
+  // Initialize the random number generator. A change of algorithm
+  // requires a new initialization, with the default seed if none is set.
+  // With the xoshiro256** algorithm the requested stream is selected.
+  bool setSeed  = settings.flag("Random:setSeed");
+  int algorithm = settings.mode("Random:algorithm");
+  if (setSeed || algorithm != rndm.algorithm()) {
+    rndm.init( setSeed ? settings.mode("Random:seed") : -1, algorithm);
+    if (algorithm == 1) rndm.jump( settings.mode("Random:stream") );
+  }
+
+  // Reset counts of the PDF cache use, from any previous run.
+  infoPrivate.resetPDFCacheCounts();
 
   // Find which frame type to use.
   infoPrivate.addCounter(1);
   frameType = mode("Beams:frameType");
 
+  // Set up the cache of initialization tables, if requested. Not used
+  // with external PDFs, processes, widths or Les Houches input, which
+  // could differ between runs with the same settings.
+  bool canUseCache = !pdfAPtr && !pdfBPtr && sigmaPtrs.empty()
+    && resonancePtrs.empty() && frameType < 4;
+  initCache.init( &infoPrivate, canUseCache);
+  infoPrivate.initCachePtr = &initCache;
+
   // Already get the Les Houches File name here, to have it for later
   // new merging initialization (e.g. by new showers).
   string lhef = word("Beams:LHEF");
@@ -1108,6 +1125,9 @@ bool Pythia::init() {
   if ( doReconnect ) colourReconnectionPtr =
     stringInteractionsPtr->getColourReconnections();
 
+  // Store new initialization tables.
+  initCache.write();
+
   // Succeeded.
   isInit = true;
   infoPrivate.addCounter(2);
@@ -2981,6 +3001,9 @@ PDFPtr Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
   bool proton2gamma = (abs(idIn) == 2212) && ( ( beamA2gamma && (beam == "A") )
                     || ( beamB2gamma && (beam == "B") ) );
 
+  // Hadron PDFs that only depend on x and Q2 may use a cache.
+  bool allowCache = false;
+
   // Proton beam, normal or hard choice. Also used for neutron.
   if ( (abs(idIn) == 2212 || abs(idIn) == 2112) && !proton2gamma ) {
     string pWord = settings.word("PDF:p"
@@ -2993,13 +3016,20 @@ PDFPtr Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     int pSet = 0;
     pStream >> pSet;
 
-    // Use internal LHAgrid1 implementation for LHAPDF6 files.
-    if (pSet == 0 && pWord.length() > 9
+    // Use internal LHAgrid1 implementation for LHAPDF6 files, also for
+    // the internal sets 13 - 22. Optionally with all members of the set.
+    if ( (pSet == 0 && pWord.length() > 9
       && toLower(pWord).substr(0,9) == "lhagrid1:")
-      tempPDFPtr = make_shared<LHAGrid1>
+      || (pSet >= 13 && pSet <= 22) ) {
+      shared_ptr<LHAGrid1> gridPDFPtr = make_shared<LHAGrid1>
         (idIn, pWord, pdfdataPath, &infoPrivate);
+      if (settings.mode("PDF:nMembers") > 1) gridPDFPtr->initMembers(
+        settings.mode("PDF:nMembers"), &infoPrivate);
+      tempPDFPtr = gridPDFPtr;
+      allowCache = true;
+    }
 
-    // Use sets from LHAPDF.
+    // Use sets from LHAPDF. Not cached.
     else if (pSet == 0)
       tempPDFPtr = make_shared<LHAPDF>(idIn, pWord, &infoPrivate);
 
@@ -3012,10 +3042,8 @@ PDFPtr Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
     else if (pSet <= 12)
       tempPDFPtr = make_shared<CTEQ6pdf>(idIn, pSet - 6, 1.,
         pdfdataPath, &infoPrivate);
-    else if (pSet <= 22)
-      tempPDFPtr = make_shared<LHAGrid1>
-        (idIn, pWord, pdfdataPath, &infoPrivate);
     else tempPDFPtr = 0;
+    if (pSet > 0) allowCache = true;
   }
 
   // Quasi-real photons inside a (anti-)proton beam.
@@ -3102,16 +3130,21 @@ PDFPtr Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
 
     // Use internal LHAgrid1 implementation for LHAPDF6 files.
     if (piSet == 0 && piWord.length() > 9
-      && toLower(piWord).substr(0,9) == "lhagrid1:")
+      && toLower(piWord).substr(0,9) == "lhagrid1:") {
       tempPDFPtr = make_shared<LHAGrid1>
         (idIn, piWord, pdfdataPath, &infoPrivate);
+      allowCache = true;
+    }
 
-    // Use sets from LHAPDF.
+    // Use sets from LHAPDF. Not cached.
     else if (piSet == 0)
       tempPDFPtr = make_shared<LHAPDF>(idIn, piWord, &infoPrivate);
 
     // Use internal set.
-    else if (piSet == 1) tempPDFPtr = make_shared<GRVpiL>(idIn, rescale);
+    else if (piSet == 1) {
+      tempPDFPtr = make_shared<GRVpiL>(idIn, rescale);
+      allowCache = true;
+    }
     else tempPDFPtr = nullptr;
   }
 
@@ -3333,6 +3366,11 @@ PDFPtr Pythia::getPDFPtr(int idIn, int sequence, string beam, bool resolved) {
   if (tempPDFPtr)
     tempPDFPtr->setExtrapolate( settings.flag("PDF:extrapolate") );
 
+  // Optionally use a cache of PDF values at recent (x, Q2) points.
+  if (tempPDFPtr && allowCache)
+    tempPDFPtr->initCache( settings.mode("PDF:cacheSize"),
+      settings.parm("PDF:cacheTolerance"), &infoPrivate);
+
   // Done.
   return tempPDFPtr;
 }
@@ -0,0 +1,307 @@
+// PythiaParallel.cc is a part of the PYTHIA event generator.
+// Copyright (C) 2020 Torbjorn Sjostrand.
+// PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
+// Please respect the MCnet Guidelines, see GUIDELINES for details.
+
+// Function definitions (not found in the header) for the PythiaParallel
+// class.
+
+#include "Pythia8/PythiaParallel.h"
+
+// Access time information.
+#include <ctime>
+
+namespace Pythia8 {
+
+//==========================================================================
+
+// The PythiaParallel class.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Default seed of the random number generator, as in Rndm.
+const int PythiaParallel::DEFAULTSEED = 19780503;
+
+// Largest allowed seed, as in the Random:seed setting.
+const int PythiaParallel::MAXSEED     = 900000000;
+
+//--------------------------------------------------------------------------
+
+// Constructor. The helper instance reads the XML files once; the worker
+// instances are later copied from it.
+
+PythiaParallel::PythiaParallel(string xmlDir, bool printBanner)
+  : pythiaHelper(xmlDir, printBanner), settings(pythiaHelper.settings),
+  particleData(pythiaHelper.particleData), pythiaObjects(), isInit(false),
+  processAsync(false), nTimesAllowErrors(0), nTrySum(0), nSelSum(0),
+  nAccSum(0), nFailedSum(0), sigGenSum(0.), sigErrSum(0.), wtSum(0.),
+  infoSum() {}
+
+//--------------------------------------------------------------------------
+
+// Create and initialize the worker instances, in parallel.
+
+bool PythiaParallel::init(function<bool(Pythia&)> customInit) {
+
+  // Read in settings.
+  int nThreads      = settings.mode("Parallelism:numThreads");
+  processAsync      = settings.flag("Parallelism:processAsync");
+  nTimesAllowErrors = settings.mode("Main:timesAllowErrors");
+  if (nThreads == 0) nThreads = max( 1, int(thread::hardware_concurrency()));
+
+  // Base seed for the worker instances. A time-dependent seed is only
+  // picked once, so that all instances still get different seeds.
+  int seedBase = DEFAULTSEED;
+  if (settings.flag("Random:setSeed")) {
+    int seedIn = settings.mode("Random:seed");
+    if (seedIn > 0) seedBase = seedIn;
+    else if (seedIn == 0) seedBase = 1 + int(time(0) % MAXSEED);
+  }
+
+  // With the xoshiro256** algorithm all instances share the seed, and
+  // instead use separate streams, which are guaranteed not to overlap.
+  bool useStreams = (settings.mode("Random:algorithm") == 1);
+  int streamBase  = settings.mode("Random:stream");
+
+  // Create the worker instances as copies of the helper one. Each
+  // gets its own index and a unique seed or stream.
+  pythiaObjects.clear();
+  for (int iThread = 0; iThread < nThreads; ++iThread) {
+    pythiaObjects.push_back( unique_ptr<Pythia>(
+      new Pythia( settings, particleData, false) ) );
+    Pythia& pythiaNow = *pythiaObjects.back();
+    int seedNow = (useStreams) ? seedBase
+                : 1 + (seedBase - 1 + iThread) % MAXSEED;
+    pythiaNow.settings.flag("Random:setSeed", true);
+    pythiaNow.settings.mode("Random:seed", seedNow);
+    if (useStreams)
+      pythiaNow.settings.mode("Random:stream", streamBase + iThread);
+    pythiaNow.settings.mode("Parallelism:index", iThread);
+
+    // Only the first instance lists initialization and event information.
+    if (iThread > 0) {
+      pythiaNow.settings.flag("Init:showProcesses", false);
+      pythiaNow.settings.flag("Init:showMultipartonInteractions", false);
+      pythiaNow.settings.flag("Init:showChangedSettings", false);
+      pythiaNow.settings.flag("Init:showChangedParticleData", false);
+      pythiaNow.settings.mode("Next:numberCount", 0);
+      pythiaNow.settings.mode("Next:numberShowInfo", 0);
+      pythiaNow.settings.mode("Next:numberShowProcess", 0);
+      pythiaNow.settings.mode("Next:numberShowEvent", 0);
+    }
+    if (customInit && !customInit(pythiaNow)) {
+      cout << " PYTHIA Abort from PythiaParallel::init: custom "
+           << "initialization failed for instance " << iThread << endl;
+      pythiaObjects.clear();
+      return false;
+    }
+  }
+
+  // Initialize the instances in parallel.
+  atomic<int> nInitFailed(0);
+  vector<thread> initThreads;
+  for (unique_ptr<Pythia>& pythiaPtr : pythiaObjects) {
+    Pythia* pythiaNowPtr = pythiaPtr.get();
+    initThreads.push_back( thread( [pythiaNowPtr, &nInitFailed]() {
+      if (!pythiaNowPtr->init()) ++nInitFailed;
+    }) );
+  }
+  for (thread& initThread : initThreads) initThread.join();
+
+  // Done.
+  if (nInitFailed > 0) {
+    cout << " PYTHIA Abort from PythiaParallel::init: " << nInitFailed
+         << " of " << nThreads << " instances failed to initialize" << endl;
+    return false;
+  }
+  isInit = true;
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Generate events on all worker instances. Each thread claims one event
+// slot at a time from a shared counter, so faster threads take on more
+// of the work. A failed event is retried on the same instance.
+
+long PythiaParallel::run(long nEvents, function<void(Pythia&)> callback) {
+
+  // Check that initialization worked.
+  if (!isInit) {
+    cout << " PYTHIA Abort from PythiaParallel::run: not properly "
+         << "initialized so cannot generate events" << endl;
+    return 0;
+  }
+
+  // Shared counters and flags.
+  atomic<long> nClaimed(0), nGenerated(0), nFailedNow(0);
+  atomic<bool> doAbort(false);
+  mutex callbackMutex;
+
+  // Event loop to be run by each thread.
+  auto eventLoop = [&](Pythia& pythiaNow) {
+    while (!doAbort && nClaimed++ < nEvents) {
+      bool isOK = false;
+      while (!isOK && !doAbort) {
+        isOK = pythiaNow.next();
+        if (isOK) break;
+        if (pythiaNow.info.atEndOfFile()
+          || ++nFailedNow > nTimesAllowErrors) doAbort = true;
+      }
+      if (!isOK) break;
+      if (callback) {
+        if (processAsync) callback(pythiaNow);
+        else {
+          lock_guard<mutex> callbackLock(callbackMutex);
+          callback(pythiaNow);
+        }
+      }
+      ++nGenerated;
+    }
+  };
+
+  // Start the threads and wait for them to finish.
+  vector<thread> runThreads;
+  for (unique_ptr<Pythia>& pythiaPtr : pythiaObjects) {
+    Pythia* pythiaNowPtr = pythiaPtr.get();
+    runThreads.push_back( thread( [&eventLoop, pythiaNowPtr]() {
+      eventLoop(*pythiaNowPtr); }) );
+  }
+  for (thread& runThread : runThreads) runThread.join();
+
+  // Report abort and update combined statistics.
+  if (doAbort) cout << " PYTHIA Error in PythiaParallel::run: generation "
+    << "aborted prematurely after " << nGenerated << " events" << endl;
+  nFailedSum += nFailedNow;
+  collectStat();
+  return nGenerated;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Perform an action on each worker instance, one at a time.
+
+void PythiaParallel::foreach(function<void(Pythia&)> action) {
+
+  for (unique_ptr<Pythia>& pythiaPtr : pythiaObjects) action(*pythiaPtr);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Combine cross sections, weights and errors of all worker instances.
+// Cross sections are averaged with the number of tried events as weight.
+
+void PythiaParallel::collectStat() {
+
+  nTrySum = nSelSum = nAccSum = 0;
+  sigGenSum = sigErrSum = wtSum = 0.;
+  infoSum.errorReset();
+  for (unique_ptr<Pythia>& pythiaPtr : pythiaObjects) {
+    const Info& infoNow = pythiaPtr->info;
+    nTrySum   += infoNow.nTried();
+    nSelSum   += infoNow.nSelected();
+    nAccSum   += infoNow.nAccepted();
+    sigGenSum += infoNow.nTried() * infoNow.sigmaGen();
+    sigErrSum += pow2(infoNow.nTried() * infoNow.sigmaErr());
+    wtSum     += infoNow.weightSum();
+    infoSum.errorCombine(infoNow);
+  }
+  if (nTrySum > 0) {
+    sigGenSum /= nTrySum;
+    sigErrSum  = sqrt(sigErrSum) / nTrySum;
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Print combined statistics on cross sections and errors.
+
+void PythiaParallel::stat() {
+
+  // Read out settings for what to include.
+  bool showPrL = settings.flag("Stat:showProcessLevel");
+  bool showErr = settings.flag("Stat:showErrors");
+
+  // Combine process-by-process information.
+  if (showPrL) {
+    map<int, string> nameM;
+    map<int, long> nTryM, nSelM, nAccM;
+    map<int, double> sigmaM, delta2M;
+    for (unique_ptr<Pythia>& pythiaPtr : pythiaObjects) {
+      const Info& infoNow = pythiaPtr->info;
+      for (int code : infoNow.codesHard()) {
+        long nTryNow  = infoNow.nTried(code);
+        nameM[code]   = infoNow.nameProc(code);
+        nTryM[code]  += nTryNow;
+        nSelM[code]  += infoNow.nSelected(code);
+        nAccM[code]  += infoNow.nAccepted(code);
+        sigmaM[code] += nTryNow * infoNow.sigmaGen(code);
+        delta2M[code]+= pow2(nTryNow * infoNow.sigmaErr(code));
+      }
+    }
+
+    // Header. The stream format is restored after the table.
+    ios::fmtflags flagsSave = cout.flags();
+    int precisionSave       = cout.precision();
+    cout << "\n *-------  PYTHIA Parallel Event and Cross Section Statistics  "
+         << "----------------------------------------------------*\n"
+         << " |                                                            "
+         << "                                                     |\n"
+         << " | Subprocess                                    Code |       "
+         << "     Number of events       |      sigma +- delta    |\n"
+         << " |                                                    |       "
+         << "Tried   Selected   Accepted |     (estimated) (mb)   |\n"
+         << " |                                                    |       "
+         << "                            |                        |\n"
+         << " |------------------------------------------------------------"
+         << "-----------------------------------------------------|\n"
+         << " |                                                    |       "
+         << "                            |                        |\n";
+
+    // Print process info.
+    for (pair<const int, string>& nameNow : nameM) {
+      int code    = nameNow.first;
+      double nTry = max( 1., double(nTryM[code]));
+      cout << " | " << left << setw(45) << nameNow.second
+           << right << setw(5) << code << " | "
+           << setw(11) << nTryM[code] << " " << setw(10) << nSelM[code] << " "
+           << setw(10) << nAccM[code] << " | " << scientific
+           << setprecision(3) << setw(11) << sigmaM[code] / nTry
+           << setw(11) << sqrtpos(delta2M[code]) / nTry << " |\n";
+    }
+
+    // Print summed process info, and number of instances.
+    cout << " |                                                    |       "
+         << "                            |                        |\n"
+         << " | " << left << setw(50) << "sum" << right << " | " << setw(11)
+         << nTrySum << " " << setw(10) << nSelSum << " " << setw(10)
+         << nAccSum << " | " << scientific << setprecision(3) << setw(11)
+         << sigGenSum << setw(11) << sigErrSum << " |\n"
+         << " |                                                            "
+         << "                                                     |\n"
+         << " | Combined from " << setw(4) << nInstances()
+         << " instances, with sum of weights " << setw(11) << weightSum()
+         << "                                                   |\n"
+         << " |                                                            "
+         << "                                                     |\n"
+         << " *-------  End PYTHIA Parallel Event and Cross Section Statistics"
+         << " -------------------------------------------------*" << endl;
+    cout.flags( flagsSave);
+    cout.precision( precisionSave);
+  }
+
+  // Summary of which and how many warnings/errors encountered.
+  if (showErr) infoSum.errorStatistics();
+
+}
+
+//==========================================================================
+
+} // end namespace Pythia8
@@ -4,8 +4,8 @@
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
 // Function definitions (not found in the header) for the
-// RopeRandState, RopeDipoleEnd, OverlappingRopeDipole, RopeDipole, Ropewalk,
-// RopeFragPars and FlavourRope classes.
+// RopeRandState, RopeDipoleEnd, RopeIntervalTree, OverlappingRopeDipole,
+// RopeDipole, Ropewalk, RopeFragPars and FlavourRope classes.
 
 #include "Pythia8/Ropewalk.h"
 
@@ -13,6 +13,103 @@ namespace Pythia8 {
 
 //==========================================================================
 
+// RopeIntervalTree class.
+// This class finds the rapidity ranges that overlap a given range.
+
+//--------------------------------------------------------------------------
+
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Number of ranges in a node below which they are searched linearly.
+const int RopeIntervalTree::NRANGELEAF = 8;
+
+//--------------------------------------------------------------------------
+
+// Add a range. Ranges without a well-defined extent can never overlap.
+
+void RopeIntervalTree::add(double yMinIn, double yMaxIn, int indexIn) {
+
+  if (yMinIn <= yMaxIn) ranges.push_back( Range( yMinIn, yMaxIn, indexIn) );
+
+}
+
+//--------------------------------------------------------------------------
+
+// Sort the ranges in their lower end, with the index as tie-breaker,
+// and find the largest upper end below each node of the tree.
+
+void RopeIntervalTree::build() {
+
+  sort( ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+    return (a.yMin < b.yMin || (a.yMin == b.yMin && a.index < b.index)); } );
+  yMaxNode.assign( 4 * ranges.size() / NRANGELEAF + 4, 0.);
+  if (ranges.size() > 0) buildNode( 0, 0, ranges.size());
+
+}
+
+//--------------------------------------------------------------------------
+
+// Set up a node of the tree, and return the largest upper end below it.
+
+double RopeIntervalTree::buildNode(int iNode, int iBeg, int iEnd) {
+
+  // Below a certain size the ranges are scanned directly.
+  double yMaxNow = ranges[iBeg].yMax;
+  if (iEnd - iBeg <= NRANGELEAF) {
+    for (int i = iBeg + 1; i < iEnd; ++i)
+      yMaxNow = max( yMaxNow, ranges[i].yMax);
+
+  // Else split in two halves.
+  } else {
+    int iMid = (iBeg + iEnd) / 2;
+    yMaxNow = max( buildNode( 2 * iNode + 1, iBeg, iMid),
+      buildNode( 2 * iNode + 2, iMid, iEnd) );
+  }
+  yMaxNode[iNode] = yMaxNow;
+  return yMaxNow;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Append the indices of all ranges overlapping [yMinIn, yMaxIn].
+
+void RopeIntervalTree::overlapping(double yMinIn, double yMaxIn,
+  vector<int>& indices) const {
+
+  if (ranges.size() > 0) search( 0, 0, ranges.size(), yMinIn, yMaxIn,
+    indices);
+
+}
+
+//--------------------------------------------------------------------------
+
+// Search a node of the tree. Since ranges are sorted in the lower end,
+// the search is over as soon as one starts above the searched range.
+
+void RopeIntervalTree::search(int iNode, int iBeg, int iEnd, double yMinIn,
+  double yMaxIn, vector<int>& indices) const {
+
+  // Nothing to be found below this node.
+  if (ranges[iBeg].yMin > yMaxIn || yMaxNode[iNode] < yMinIn) return;
+
+  // Scan the ranges directly, or else search the two halves.
+  if (iEnd - iBeg <= NRANGELEAF) {
+    for (int i = iBeg; i < iEnd; ++i) {
+      if (ranges[i].yMin > yMaxIn) break;
+      if (ranges[i].yMax >= yMinIn) indices.push_back( ranges[i].index);
+    }
+  } else {
+    int iMid = (iBeg + iEnd) / 2;
+    search( 2 * iNode + 1, iBeg, iMid, yMinIn, yMaxIn, indices);
+    search( 2 * iNode + 2, iMid, iEnd, yMinIn, yMaxIn, indices);
+  }
+
+}
+
+//==========================================================================
+
 // OverlappingRopeDipole class.
 // This class describes dipoles overlapping with a given dipole.
 
@@ -70,7 +167,8 @@ bool OverlappingRopeDipole::hadronized() {
 RopeDipole::RopeDipole(RopeDipoleEnd d1In, RopeDipoleEnd d2In, int iSubIn,
   Info* infoPtrIn)
   : d1(d1In), d2(d2In), iSub(iSubIn), hasRotFrom(false), hasRotTo(false),
-  isHadronized(false), infoPtr(infoPtrIn) {
+  hasOverlapTree(false), hasBFrac(false), isHadronized(false),
+  infoPtr(infoPtrIn) {
 
   // Test if d1 is colored end and d2 anti-colored.
   if (d1In.getParticlePtr()->col() == d2In.getParticlePtr()->acol()
@@ -406,9 +504,25 @@ pair<int, int> RopeDipole::getOverlaps(double yfrac, double m0, double r0) {
   double yL = d1.rap(m0,rotTo);
   double yS = d2.rap(m0,rotTo);
   double yH = yS + (yL - yS) * yfrac;
+  Vec4 bHere = bInterpolateDip(yH,m0);
+
+  // Rapidity ranges of the overlapping dipoles, set up when first needed.
+  if (!hasOverlapTree) {
+    overlapTree.clear();
+    for (int i = 0; i < int(overlaps.size()); ++i)
+      overlapTree.add( min(overlaps[i].y1, overlaps[i].y2),
+        max(overlaps[i].y1, overlaps[i].y2), i);
+    overlapTree.build();
+    hasOverlapTree = true;
+  }
+
+  // Only dipoles that span the rapidity need to be checked further.
+  iOverlapsHere.resize(0);
+  overlapTree.overlapping( yfrac, yfrac, iOverlapsHere);
   int m = 0, n = 0;
-  for (size_t i = 0; i < overlaps.size(); ++i) {
-    if (overlaps[i].overlap( yfrac, bInterpolateDip(yH,m0), r0)
+  for (int j = 0; j < int(iOverlapsHere.size()); ++j) {
+    int i = iOverlapsHere[j];
+    if (overlaps[i].overlap( yfrac, bHere, r0)
       && !overlaps[i].hadronized()) {
         if (overlaps[i].dir > 0) ++m;
         else                     ++n;
@@ -418,6 +532,50 @@ pair<int, int> RopeDipole::getOverlaps(double yfrac, double m0, double r0) {
 
 }
 
+//--------------------------------------------------------------------------
+
+// Check if an overlapping dipole can pass the impact-parameter test of
+// getOverlaps for any rapidity, i.e. come within 2 r0 of this dipole.
+// Both impact parameters are linear in the rapidity fraction, so the
+// minimal distance is found analytically. A small tolerance for rounding
+// errors makes sure that no dipole is rejected that could pass.
+
+bool RopeDipole::canOverlap(OverlappingRopeDipole& d, double m0, double r0) {
+
+  // Impact parameter of this dipole, as used in getOverlaps.
+  if (!hasBFrac) {
+    if (!hasRotTo) getDipoleRestFrame();
+    double yL = d1.rap(m0,rotTo);
+    double yS = d2.rap(m0,rotTo);
+    Vec4 bb1 = d1.getParticlePtr()->vProd() * MM2FM;
+    bb1.rotbst(rotTo);
+    Vec4 bb2 = d2.getParticlePtr()->vProd() * MM2FM;
+    bb2.rotbst(rotTo);
+    Vec4 bSlope = (bb2 - bb1) / (yS - yL);
+    bFrac0 = bb1 + yS * bSlope;
+    bFrac1 = (yL - yS) * bSlope;
+    hasBFrac = true;
+  }
+
+  // Impact parameter of the other dipole, as used in overlap.
+  Vec4 bOther1 = (d.b2 - d.b1) / (d.y2 - d.y1);
+  Vec4 bOther0 = d.b1 - d.y1 * bOther1;
+
+  // Minimal transverse distance in the range of rapidity fractions.
+  double tMin = min(d.y1, d.y2);
+  double tMax = max(d.y1, d.y2);
+  Vec4 dist0 = bFrac0 - bOther0;
+  Vec4 dist1 = bFrac1 - bOther1;
+  double tNow = tMin;
+  if (dist1.pT2() > 0.) tNow = max( tMin, min( tMax,
+    -(dist0.px() * dist1.px() + dist0.py() * dist1.py()) / dist1.pT2() ) );
+  double distMin = (dist0 + tNow * dist1).pT();
+  double tol = 1e-8 * (r0 + bFrac0.pT() + bOther0.pT()
+    + (bFrac1.pT() + bOther1.pT()) * max( abs(tMin), abs(tMax)) );
+  return !(distMin > 2. * r0 + tol);
+
+}
+
 //==========================================================================
 
 // Exc class.
@@ -498,6 +656,14 @@ RopeDipole* dip2;
 
 //--------------------------------------------------------------------------
 
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Maximal number of grid cells in each impact-parameter direction.
+const double Ropewalk::NCELLMAX = 100.;
+
+//--------------------------------------------------------------------------
+
 // The Ropewalk init function sets parameters and pointers.
 
 bool Ropewalk::init() {
@@ -522,6 +688,9 @@ bool Ropewalk::init() {
   tInit                = parm("Ropewalk:tInit");
   showerCut            = parm("TimeShower:pTmin");
   alwaysHighest        = flag("Ropewalk:alwaysHighest");
+  fastOverlaps         = flag("Ropewalk:fastOverlaps");
+  yMarginFast          = parm("Ropewalk:yMarginFast");
+  bMarginFast          = parm("Ropewalk:bMarginFast");
 
   // Creat the interface objects.
   if ( flag("Ropewalk:doShoving") ) {
@@ -622,14 +791,66 @@ double Ropewalk::getKappaHere(int e1, int e2, double yfrac) {
 //--------------------------------------------------------------------------
 
 // Calculate all overlaps of all dipoles and store as OverlappingRopeDipoles.
+// Only dipoles that can pass the impact-parameter test are stored. By
+// default all pairs of dipoles are checked. Optionally candidates are
+// preselected in the lab frame, from a grid in impact parameter where
+// each cell has an interval tree of dipole rapidity ranges.
 
 bool Ropewalk::calculateOverlaps() {
 
+  // All dipoles that are not miniscule.
+  vector<RopeDipole*> dipolePtrs;
+  for (DMap::iterator itr = dipoles.begin(); itr != dipoles.end(); ++itr)
+    if (itr->second.dipoleMomentum().m2Calc() >= pow2(m0))
+      dipolePtrs.push_back( &(itr->second) );
+  int nDip = dipolePtrs.size();
+
+  // Set up the lab-frame preselection: rapidity ranges and impact-parameter
+  // boxes of the dipoles, spread out on a grid in impact parameter.
+  vector<double> yMinLab, yMaxLab, bxMin, bxMax, byMin, byMax;
+  vector<RopeIntervalTree> cells;
+  vector<int> iCandidates, lastSeen;
+  int nx = 1;
+  int ny = 1;
+  double bCell = 2. * r0 + bMarginFast;
+  double bxGrid = 0.;
+  double byGrid = 0.;
+  if (fastOverlaps && nDip > 0) {
+    for (int i = 0; i < nDip; ++i) {
+      RopeDipole* dip = dipolePtrs[i];
+      yMinLab.push_back( dip->minRapidity(m0) );
+      yMaxLab.push_back( dip->maxRapidity(m0) );
+      Vec4 bEnd1 = dip->d1Ptr()->getParticlePtr()->vProd() * MM2FM;
+      Vec4 bEnd2 = dip->d2Ptr()->getParticlePtr()->vProd() * MM2FM;
+      bxMin.push_back( min( bEnd1.px(), bEnd2.px()) );
+      bxMax.push_back( max( bEnd1.px(), bEnd2.px()) );
+      byMin.push_back( min( bEnd1.py(), bEnd2.py()) );
+      byMax.push_back( max( bEnd1.py(), bEnd2.py()) );
+    }
+    bxGrid = *min_element( bxMin.begin(), bxMin.end());
+    byGrid = *min_element( byMin.begin(), byMin.end());
+    double xSpan = *max_element( bxMax.begin(), bxMax.end()) - bxGrid;
+    double ySpan = *max_element( byMax.begin(), byMax.end()) - byGrid;
+    bCell = max( bCell, max( xSpan, ySpan) / NCELLMAX);
+    nx = int(xSpan / bCell) + 1;
+    ny = int(ySpan / bCell) + 1;
+    cells.resize( nx * ny);
+    for (int i = 0; i < nDip; ++i) {
+      int ix1 = int((bxMin[i] - bxGrid) / bCell);
+      int ix2 = int((bxMax[i] - bxGrid) / bCell);
+      int iy1 = int((byMin[i] - byGrid) / bCell);
+      int iy2 = int((byMax[i] - byGrid) / bCell);
+      for (int ix = ix1; ix <= ix2; ++ix)
+      for (int iy = iy1; iy <= iy2; ++iy)
+        cells[ix * ny + iy].add( yMinLab[i], yMaxLab[i], i);
+    }
+    for (int iCell = 0; iCell < nx * ny; ++iCell) cells[iCell].build();
+    lastSeen.resize( nDip, -1);
+  }
+
   // Go through all dipoles.
-  for (multimap< pair<int,int>, RopeDipole>::iterator itr = dipoles.begin();
-    itr != dipoles.end(); ++itr ) {
-    RopeDipole* d1 = &(itr->second);
-    if (d1->dipoleMomentum().m2Calc() < pow2(m0)) continue;
+  for (int i1 = 0; i1 < nDip; ++i1) {
+    RopeDipole* d1 = dipolePtrs[i1];
 
     // RopeDipoles rapidities in dipole rest frame.
     RotBstMatrix dipoleRestFrame = d1->getDipoleRestFrame();
@@ -637,20 +858,45 @@ bool Ropewalk::calculateOverlaps() {
     double ya1 = d1->d2Ptr()->rap(m0, dipoleRestFrame);
     if (yc1 <= ya1) continue;
 
+    // Possible overlapping dipoles, in the lab-frame preselection those
+    // in nearby cells and rapidities, sorted to keep the original order.
+    iCandidates.resize(0);
+    if (fastOverlaps) {
+      double bRange = 2. * r0 + bMarginFast;
+      int ix1 = max( 0, int((bxMin[i1] - bRange - bxGrid) / bCell));
+      int ix2 = min( nx - 1, int((bxMax[i1] + bRange - bxGrid) / bCell));
+      int iy1 = max( 0, int((byMin[i1] - bRange - byGrid) / bCell));
+      int iy2 = min( ny - 1, int((byMax[i1] + bRange - byGrid) / bCell));
+      int nOld = 0;
+      for (int ix = ix1; ix <= ix2; ++ix)
+      for (int iy = iy1; iy <= iy2; ++iy) {
+        cells[ix * ny + iy].overlapping( yMinLab[i1] - yMarginFast,
+          yMaxLab[i1] + yMarginFast, iCandidates);
+        for (int j = nOld; j < int(iCandidates.size()); ++j) {
+          if (lastSeen[iCandidates[j]] == i1) continue;
+          lastSeen[iCandidates[j]] = i1;
+          iCandidates[nOld++] = iCandidates[j];
+        }
+        iCandidates.resize(nOld);
+      }
+      sort( iCandidates.begin(), iCandidates.end());
+    } else for (int i2 = 0; i2 < nDip; ++i2) iCandidates.push_back(i2);
+
     // Go through all possible overlapping dipoles.
-    for (multimap< pair<int,int>, RopeDipole>::iterator itr2 = dipoles.begin();
-      itr2 != dipoles.end(); ++itr2) {
-      RopeDipole* d2 = &(itr2->second);
+    for (int j = 0; j < int(iCandidates.size()); ++j) {
+      RopeDipole* d2 = dipolePtrs[iCandidates[j]];
 
-      // Skip self and overlaps with miniscule dipoles.
+      // Skip self.
       if (d1 == d2) continue;
-      if (d2->dipoleMomentum().m2Calc() < pow2(m0)) continue;
 
       // Ignore if not overlapping in rapidity.
       OverlappingRopeDipole od(d2, m0, dipoleRestFrame);
       if (min(od.y1, od.y2) > yc1 || max(od.y1, od.y2) < ya1 || od.y1 == od.y2)
         continue;
 
+      // Ignore if never close enough in impact parameter.
+      if (!d1->canOverlap( od, m0, r0)) continue;
+
       d1->addOverlappingDipole(od);
 
     }
@@ -658,6 +904,7 @@ bool Ropewalk::calculateOverlaps() {
   return true;
 
 }
+
 //--------------------------------------------------------------------------
 
 // Invoke the random walk of colour states.
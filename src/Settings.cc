@@ -19,12 +19,54 @@ namespace Pythia8 {
 
 //--------------------------------------------------------------------------
 
-// Read in database from specific file.
+// Constants: could be changed here if desired, but normally should not.
+// These are of technical nature, as described for each.
+
+// Value of a word for an invalid handle, as for an unknown key.
+const string Settings::WORDDEFAULT = " ";
+
+//--------------------------------------------------------------------------
+
+// Databases already read from file, shared between Settings objects.
+
+map<string, shared_ptr<const Settings> > Settings::xmlCache;
+mutex Settings::xmlCacheMutex;
+
+//--------------------------------------------------------------------------
+
+// Read in database from specific file. A new database from a file already
+// read in is copied from the cache rather than parsed anew.
 
 bool Settings::init(string startFile, bool append) {
 
   // Don't initialize if it has already been done and not in append mode.
   if (isInit && !append) return true;
+  if (append) return readXML( startFile, append);
+
+  // Copy an existing database, but keep own Info pointer.
+  lock_guard<mutex> cacheLock(xmlCacheMutex);
+  map<string, shared_ptr<const Settings> >::iterator cacheItr
+    = xmlCache.find(startFile);
+  if (cacheItr != xmlCache.end()) {
+    Info* infoPtrSave = infoPtr;
+    *this   = *cacheItr->second;
+    infoPtr = infoPtrSave;
+    return true;
+  }
+
+  // Else read from file and store a copy of the result.
+  if (!readXML( startFile, append)) return false;
+  xmlCache[startFile] = make_shared<const Settings>(*this);
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Read in database from specific file, without using the cache.
+
+bool Settings::readXML(string startFile, bool append) {
+
   int nError = 0;
 
   // Reset readString history.
@@ -625,14 +667,14 @@ bool Settings::writeFile(ostream& os, bool writeAll) {
      << " settings.\n";
 
   // Iterators for the flag, mode and parm tables.
-  map<string, Flag>::iterator flagEntry = flags.begin();
-  map<string, Mode>::iterator modeEntry = modes.begin();
-  map<string, Parm>::iterator parmEntry = parms.begin();
-  map<string, Word>::iterator wordEntry = words.begin();
-  map<string, FVec>::iterator fvecEntry = fvecs.begin();
-  map<string, MVec>::iterator mvecEntry = mvecs.begin();
-  map<string, PVec>::iterator pvecEntry = pvecs.begin();
-  map<string, WVec>::iterator wvecEntry = wvecs.begin();
+  SettingsStore<Flag>::iterator flagEntry = flags.begin();
+  SettingsStore<Mode>::iterator modeEntry = modes.begin();
+  SettingsStore<Parm>::iterator parmEntry = parms.begin();
+  SettingsStore<Word>::iterator wordEntry = words.begin();
+  SettingsStore<FVec>::iterator fvecEntry = fvecs.begin();
+  SettingsStore<MVec>::iterator mvecEntry = mvecs.begin();
+  SettingsStore<PVec>::iterator pvecEntry = pvecs.begin();
+  SettingsStore<WVec>::iterator wvecEntry = wvecs.begin();
 
   // Loop while there is something left to do.
   while (flagEntry != flags.end() || modeEntry != modes.end()
@@ -793,14 +835,14 @@ bool Settings::writeFile(ostream& os, bool writeAll) {
 bool Settings::writeFileXML(ostream& os) {
 
   // Iterators for the flag, mode and parm tables.
-  map<string, Flag>::iterator flagEntry = flags.begin();
-  map<string, Mode>::iterator modeEntry = modes.begin();
-  map<string, Parm>::iterator parmEntry = parms.begin();
-  map<string, Word>::iterator wordEntry = words.begin();
-  map<string, FVec>::iterator fvecEntry = fvecs.begin();
-  map<string, MVec>::iterator mvecEntry = mvecs.begin();
-  map<string, PVec>::iterator pvecEntry = pvecs.begin();
-  map<string, WVec>::iterator wvecEntry = wvecs.begin();
+  SettingsStore<Flag>::iterator flagEntry = flags.begin();
+  SettingsStore<Mode>::iterator modeEntry = modes.begin();
+  SettingsStore<Parm>::iterator parmEntry = parms.begin();
+  SettingsStore<Word>::iterator wordEntry = words.begin();
+  SettingsStore<FVec>::iterator fvecEntry = fvecs.begin();
+  SettingsStore<MVec>::iterator mvecEntry = mvecs.begin();
+  SettingsStore<PVec>::iterator pvecEntry = pvecs.begin();
+  SettingsStore<WVec>::iterator wvecEntry = wvecs.begin();
 
   // Loop while there is something left to do.
   while (flagEntry != flags.end() || modeEntry != modes.end()
@@ -1022,14 +1064,14 @@ void Settings::list(bool doListAll,  bool doListString, string match) {
   if (match == "") match = "             ";
 
   // Iterators for the flag, mode and parm tables.
-  map<string, Flag>::iterator flagEntry = flags.begin();
-  map<string, Mode>::iterator modeEntry = modes.begin();
-  map<string, Parm>::iterator parmEntry = parms.begin();
-  map<string, Word>::iterator wordEntry = words.begin();
-  map<string, FVec>::iterator fvecEntry = fvecs.begin();
-  map<string, MVec>::iterator mvecEntry = mvecs.begin();
-  map<string, PVec>::iterator pvecEntry = pvecs.begin();
-  map<string, WVec>::iterator wvecEntry = wvecs.begin();
+  SettingsStore<Flag>::iterator flagEntry = flags.begin();
+  SettingsStore<Mode>::iterator modeEntry = modes.begin();
+  SettingsStore<Parm>::iterator parmEntry = parms.begin();
+  SettingsStore<Word>::iterator wordEntry = words.begin();
+  SettingsStore<FVec>::iterator fvecEntry = fvecs.begin();
+  SettingsStore<MVec>::iterator mvecEntry = mvecs.begin();
+  SettingsStore<PVec>::iterator pvecEntry = pvecs.begin();
+  SettingsStore<WVec>::iterator wvecEntry = wvecs.begin();
 
   // Loop while there is something left to do.
   while (flagEntry != flags.end() || modeEntry != modes.end()
@@ -1360,56 +1402,56 @@ string Settings::output(string keyIn, bool fullLine) {
 void Settings::resetAll() {
 
   // Loop through the flags table, resetting all entries.
-  for (map<string, Flag>::iterator flagEntry = flags.begin();
+  for (SettingsStore<Flag>::iterator flagEntry = flags.begin();
     flagEntry != flags.end(); ++flagEntry) {
     string name = flagEntry->first;
     resetFlag(name);
   }
 
   // Loop through the modes table, resetting all entries.
-  for (map<string, Mode>::iterator modeEntry = modes.begin();
+  for (SettingsStore<Mode>::iterator modeEntry = modes.begin();
     modeEntry != modes.end(); ++modeEntry) {
     string name = modeEntry->first;
     resetMode(name);
   }
 
   // Loop through the parms table, resetting all entries.
-  for (map<string, Parm>::iterator parmEntry = parms.begin();
+  for (SettingsStore<Parm>::iterator parmEntry = parms.begin();
     parmEntry != parms.end(); ++parmEntry) {
     string name = parmEntry->first;
     resetParm(name);
   }
 
   // Loop through the words table, resetting all entries.
-  for (map<string, Word>::iterator wordEntry = words.begin();
+  for (SettingsStore<Word>::iterator wordEntry = words.begin();
     wordEntry != words.end(); ++wordEntry) {
     string name = wordEntry->first;
     resetWord(name);
   }
 
   // Loop through the fvecs table, resetting all entries.
-  for (map<string, FVec>::iterator fvecEntry = fvecs.begin();
+  for (SettingsStore<FVec>::iterator fvecEntry = fvecs.begin();
     fvecEntry != fvecs.end(); ++fvecEntry) {
     string name = fvecEntry->first;
     resetFVec(name);
   }
 
   // Loop through the mvecs table, resetting all entries.
-  for (map<string, MVec>::iterator mvecEntry = mvecs.begin();
+  for (SettingsStore<MVec>::iterator mvecEntry = mvecs.begin();
     mvecEntry != mvecs.end(); ++mvecEntry) {
     string name = mvecEntry->first;
     resetMVec(name);
   }
 
   // Loop through the pvecs table, resetting all entries.
-  for (map<string, PVec>::iterator pvecEntry = pvecs.begin();
+  for (SettingsStore<PVec>::iterator pvecEntry = pvecs.begin();
     pvecEntry != pvecs.end(); ++pvecEntry) {
     string name = pvecEntry->first;
     resetPVec(name);
   }
 
   // Loop through the wvecs table, resetting all entries.
-  for (map<string, WVec>::iterator wvecEntry = wvecs.begin();
+  for (SettingsStore<WVec>::iterator wvecEntry = wvecs.begin();
     wvecEntry != wvecs.end(); ++wvecEntry) {
     string name = wvecEntry->first;
     resetWVec(name);
@@ -1422,101 +1464,149 @@ void Settings::resetAll() {
 // Give back current value, with check that key exists.
 
 bool Settings::flag(string keyIn) {
-  if (isFlag(keyIn)) return flags[toLower(keyIn)].valNow;
+  int index = flags.index(toLower(keyIn));
+  if (index >= 0) return flags.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::flag: unknown key", keyIn);
   return false;
 }
 
 int Settings::mode(string keyIn) {
-  if (isMode(keyIn)) return modes[toLower(keyIn)].valNow;
+  int index = modes.index(toLower(keyIn));
+  if (index >= 0) return modes.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::mode: unknown key", keyIn);
   return 0;
 }
 
 double Settings::parm(string keyIn) {
-  if (isParm(keyIn)) return parms[toLower(keyIn)].valNow;
+  int index = parms.index(toLower(keyIn));
+  if (index >= 0) return parms.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::parm: unknown key", keyIn);
   return 0.;
 }
 
 string Settings::word(string keyIn) {
-  if (isWord(keyIn)) return words[toLower(keyIn)].valNow;
+  int index = words.index(toLower(keyIn));
+  if (index >= 0) return words.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::word: unknown key", keyIn);
   return " ";
 }
 
 vector<bool> Settings::fvec(string keyIn) {
-  if (isFVec(keyIn)) return fvecs[toLower(keyIn)].valNow;
+  int index = fvecs.index(toLower(keyIn));
+  if (index >= 0) return fvecs.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::fvec: unknown key", keyIn);
   return vector<bool>(1, false);
 }
 
 vector<int> Settings::mvec(string keyIn) {
-  if (isMVec(keyIn)) return mvecs[toLower(keyIn)].valNow;
+  int index = mvecs.index(toLower(keyIn));
+  if (index >= 0) return mvecs.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::mvec: unknown key", keyIn);
   return vector<int>(1, 0);
 }
 
 vector<double> Settings::pvec(string keyIn) {
-  if (isPVec(keyIn)) return pvecs[toLower(keyIn)].valNow;
+  int index = pvecs.index(toLower(keyIn));
+  if (index >= 0) return pvecs.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::pvec: unknown key", keyIn);
   return vector<double>(1, 0.);
 }
 
 vector<string> Settings::wvec(string keyIn) {
-  if (isWVec(keyIn)) return wvecs[toLower(keyIn)].valNow;
+  int index = wvecs.index(toLower(keyIn));
+  if (index >= 0) return wvecs.at(index).valNow;
   infoPtr->errorMsg("Error in Settings::wvec: unknown key", keyIn);
   return vector<string>(1, " ");
 }
 
 //--------------------------------------------------------------------------
 
+// Find handle to an entry, for fast repeated access to its value.
+
+FlagHandle Settings::flagHandle(string keyIn) {
+  int index = flags.index(toLower(keyIn));
+  if (index < 0) infoPtr->errorMsg("Error in Settings::flagHandle: "
+    "unknown key", keyIn);
+  return FlagHandle(index);
+}
+
+ModeHandle Settings::modeHandle(string keyIn) {
+  int index = modes.index(toLower(keyIn));
+  if (index < 0) infoPtr->errorMsg("Error in Settings::modeHandle: "
+    "unknown key", keyIn);
+  return ModeHandle(index);
+}
+
+ParmHandle Settings::parmHandle(string keyIn) {
+  int index = parms.index(toLower(keyIn));
+  if (index < 0) infoPtr->errorMsg("Error in Settings::parmHandle: "
+    "unknown key", keyIn);
+  return ParmHandle(index);
+}
+
+WordHandle Settings::wordHandle(string keyIn) {
+  int index = words.index(toLower(keyIn));
+  if (index < 0) infoPtr->errorMsg("Error in Settings::wordHandle: "
+    "unknown key", keyIn);
+  return WordHandle(index);
+}
+
+//--------------------------------------------------------------------------
+
 // Give back default value, with check that key exists.
 
 bool Settings::flagDefault(string keyIn) {
-  if (isFlag(keyIn)) return flags[toLower(keyIn)].valDefault;
+  int index = flags.index(toLower(keyIn));
+  if (index >= 0) return flags.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::flagDefault: unknown key", keyIn);
   return false;
 }
 
 int Settings::modeDefault(string keyIn) {
-  if (isMode(keyIn)) return modes[toLower(keyIn)].valDefault;
+  int index = modes.index(toLower(keyIn));
+  if (index >= 0) return modes.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::modeDefault: unknown key", keyIn);
   return 0;
 }
 
 double Settings::parmDefault(string keyIn) {
-  if (isParm(keyIn)) return parms[toLower(keyIn)].valDefault;
+  int index = parms.index(toLower(keyIn));
+  if (index >= 0) return parms.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::parmDefault: unknown key", keyIn);
   return 0.;
 }
 
 string Settings::wordDefault(string keyIn) {
-  if (isWord(keyIn)) return words[toLower(keyIn)].valDefault;
+  int index = words.index(toLower(keyIn));
+  if (index >= 0) return words.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::wordDefault: unknown key", keyIn);
   return " ";
 }
 
 vector<bool> Settings::fvecDefault(string keyIn) {
-  if (isFVec(keyIn)) return fvecs[toLower(keyIn)].valDefault;
+  int index = fvecs.index(toLower(keyIn));
+  if (index >= 0) return fvecs.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::fvecDefault: unknown key", keyIn);
   return vector<bool>(1, false);
 }
 
 vector<int> Settings::mvecDefault(string keyIn) {
-  if (isMVec(keyIn)) return mvecs[toLower(keyIn)].valDefault;
+  int index = mvecs.index(toLower(keyIn));
+  if (index >= 0) return mvecs.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::mvecDefault: unknown key", keyIn);
   return vector<int>(1, 0);
 }
 
 vector<double> Settings::pvecDefault(string keyIn) {
-  if (isPVec(keyIn)) return pvecs[toLower(keyIn)].valDefault;
+  int index = pvecs.index(toLower(keyIn));
+  if (index >= 0) return pvecs.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::pvecDefault: unknown key", keyIn);
   return vector<double>(1, 0.);
 }
 
 vector<string> Settings::wvecDefault(string keyIn) {
-  if (isWVec(keyIn)) return wvecs[toLower(keyIn)].valDefault;
+  int index = wvecs.index(toLower(keyIn));
+  if (index >= 0) return wvecs.at(index).valDefault;
   infoPtr->errorMsg("Error in Settings::wvecDefault: unknown key", keyIn);
   return vector<string>(1, " ");
 }
@@ -1530,7 +1620,7 @@ map<string, Flag> Settings::getFlagMap(string match) {
   toLowerRep(match);
   map<string, Flag> flagMap;
   // Loop over the flag map (using iterator).
-  for (map<string,Flag>::iterator flagEntry = flags.begin();
+  for (SettingsStore<Flag>::iterator flagEntry = flags.begin();
        flagEntry != flags.end(); ++flagEntry)
     if (flagEntry->first.find(match) != string::npos)
       flagMap[flagEntry->first] = flagEntry->second;
@@ -1542,7 +1632,7 @@ map<string, Mode> Settings::getModeMap(string match) {
   toLowerRep(match);
   map<string, Mode> modeMap;
   // Loop over the mode map (using iterator).
-  for (map<string,Mode>::iterator modeEntry = modes.begin();
+  for (SettingsStore<Mode>::iterator modeEntry = modes.begin();
        modeEntry != modes.end(); ++modeEntry)
     if (modeEntry->first.find(match) != string::npos)
       modeMap[modeEntry->first] = modeEntry->second;
@@ -1554,7 +1644,7 @@ map<string, Parm> Settings::getParmMap(string match) {
   toLowerRep(match);
   map<string, Parm> parmMap;
   // Loop over the parm map (using iterator).
-  for (map<string,Parm>::iterator parmEntry = parms.begin();
+  for (SettingsStore<Parm>::iterator parmEntry = parms.begin();
        parmEntry != parms.end(); ++parmEntry)
     if (parmEntry->first.find(match) != string::npos)
       parmMap[parmEntry->first] = parmEntry->second;
@@ -1566,7 +1656,7 @@ map<string, Word> Settings::getWordMap(string match) {
   toLowerRep(match);
   map<string, Word> wordMap;
   // Loop over the word map (using iterator).
-  for (map<string,Word>::iterator wordEntry = words.begin();
+  for (SettingsStore<Word>::iterator wordEntry = words.begin();
        wordEntry != words.end(); ++wordEntry)
     if (wordEntry->first.find(match) != string::npos)
       wordMap[wordEntry->first] = wordEntry->second;
@@ -1578,7 +1668,7 @@ map<string, FVec> Settings::getFVecMap(string match) {
   toLowerRep(match);
   map<string, FVec> fvecMap;
   // Loop over the fvec map (using iterator).
-  for (map<string,FVec>::iterator fvecEntry = fvecs.begin();
+  for (SettingsStore<FVec>::iterator fvecEntry = fvecs.begin();
        fvecEntry != fvecs.end(); ++fvecEntry)
     if (fvecEntry->first.find(match) != string::npos)
       fvecMap[fvecEntry->first] = fvecEntry->second;
@@ -1590,7 +1680,7 @@ map<string, MVec> Settings::getMVecMap(string match) {
   toLowerRep(match);
   map<string, MVec> mvecMap;
   // Loop over the mvec map (using iterator).
-  for (map<string,MVec>::iterator mvecEntry = mvecs.begin();
+  for (SettingsStore<MVec>::iterator mvecEntry = mvecs.begin();
        mvecEntry != mvecs.end(); ++mvecEntry)
     if (mvecEntry->first.find(match) != string::npos)
       mvecMap[mvecEntry->first] = mvecEntry->second;
@@ -1602,7 +1692,7 @@ map<string, PVec> Settings::getPVecMap(string match) {
   toLowerRep(match);
   map<string, PVec> pvecMap;
   // Loop over the pvec map (using iterator).
-  for (map<string,PVec>::iterator pvecEntry = pvecs.begin();
+  for (SettingsStore<PVec>::iterator pvecEntry = pvecs.begin();
        pvecEntry != pvecs.end(); ++pvecEntry)
     if (pvecEntry->first.find(match) != string::npos)
       pvecMap[pvecEntry->first] = pvecEntry->second;
@@ -1614,7 +1704,7 @@ map<string, WVec> Settings::getWVecMap(string match) {
   toLowerRep(match);
   map<string, WVec> wvecMap;
   // Loop over the wvec map (using iterator).
-  for (map<string,WVec>::iterator wvecEntry = wvecs.begin();
+  for (SettingsStore<WVec>::iterator wvecEntry = wvecs.begin();
        wvecEntry != wvecs.end(); ++wvecEntry)
     if (wvecEntry->first.find(match) != string::npos)
       wvecMap[wvecEntry->first] = wvecEntry->second;
@@ -1797,7 +1887,7 @@ bool Settings::hasHardProc() {
   int sizeExclude = 2;
 
   // Loop over the flag map (using iterator), and process names.
-  for (map<string,Flag>::iterator flagEntry = flags.begin();
+  for (SettingsStore<Flag>::iterator flagEntry = flags.begin();
     flagEntry != flags.end(); ++flagEntry) {
     string flagName = flagEntry->first;
     bool doExclude = false;
@@ -192,7 +192,8 @@ void SimpleTimeShower::init( BeamParticle* beamAPtrIn,
   // Number of splittings produced with global recoil.
   nMaxGlobalBranch   = mode("TimeShower:nMaxGlobalBranch");
   // Number of partons in Born-like events, to distinguish between S and H.
-  nFinalBorn         = mode("TimeShower:nPartonsInBorn");
+  nFinalBornHandle   = settingsPtr->modeHandle("TimeShower:nPartonsInBorn");
+  nFinalBorn         = mode(nFinalBornHandle);
   // Flag to allow to start from a scale smaller than scalup.
   globalRecoilMode   = mode("TimeShower:globalRecoilMode");
   // Flag to allow to start from a scale smaller than scalup.
@@ -601,7 +602,7 @@ void SimpleTimeShower::prepareGlobal( Event& event) {
   nHard      = 0;
   nProposed.clear();
   hardPartons.resize(0);
-  nFinalBorn = mode("TimeShower:nPartonsInBorn");
+  nFinalBorn = mode(nFinalBornHandle);
 
   // Global recoils: store positions of hard outgoing partons.
   // No global recoil for H events.
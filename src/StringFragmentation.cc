@@ -3,8 +3,8 @@
 // PYTHIA is licenced under the GNU GPL v2 or later, see COPYING for details.
 // Please respect the MCnet Guidelines, see GUIDELINES for details.
 
-// Function definitions (not found in the header) for the StringEnd and
-// StringFragmentation classes.
+// Function definitions (not found in the header) for the StringEnd,
+// StringFragmentation and ParallelStringFragmentation classes.
 
 #include "Pythia8/StringFragmentation.h"
 
@@ -101,7 +101,7 @@ void StringEnd::newHadron(double nNSP) {
     pyHad = pyOld + pyNew;
 
     // Pick its mass and thereby define its transverse mass.
-    mHad   = particleDataPtr->mSel(idHad);
+    mHad   = particleDataPtr->mSel(idHad, rndmPtr);
     mT2Had = pow2(mHad) + pow2(pxHad) + pow2(pyHad);
   }
 
@@ -306,8 +306,8 @@ Vec4 StringEnd::kinematicsHadron( StringSystem& system,
 // Generate momentum for some possible next hadron, based on mean values
 // to get an estimate for rapidity and pT.
 
-Vec4 StringEnd::kinematicsHadronTmp( StringSystem system, Vec4 pRem,
-  double phi, double mult) {
+Vec4 StringEnd::kinematicsHadronTmp( StringSystem& system, Vec4 pRem,
+  double phi, double mult) const {
 
   // Now estimate the energy the next hadron will take.
   double mRem     = pRem.mCalc();
@@ -366,7 +366,7 @@ Vec4 StringEnd::kinematicsHadronTmp( StringSystem system, Vec4 pRem,
   for (int iStep = 0; ; ++iStep) {
 
     // Referance to current string region.
-    StringRegion region = system.region( iPosNewTmp, iNegNewTmp);
+    StringRegion& region = system.region( iPosNewTmp, iNegNewTmp);
 
     // Now begin special section for rapid processing of low region.
     if (iStep == 0 && iPosOldTmp + iNegOldTmp == iMax) {
@@ -461,7 +461,7 @@ Vec4 StringEnd::kinematicsHadronTmp( StringSystem system, Vec4 pRem,
         double xDir = (iDir == iDirOld) ? xDirOld : 1.;
         int iPos = (fromPos) ? iDir : iInv;
         int iNeg = (fromPos) ? iInv : iDir;
-        StringRegion regionGam =  system.region( iPos, iNeg);
+        StringRegion& regionGam =  system.region( iPos, iNeg);
         if (!regionGam.isSetUp) regionGam.setUp(
           system.regionLowPos(iPos).pPos,
           system.regionLowNeg(iNeg).pNeg,
@@ -644,8 +644,10 @@ void StringFragmentation::init(StringFlav* flavSelPtrIn,
   hadrons.init( "(string fragmentation)", particleDataPtr);
 
   // Send on pointers to the two StringEnd instances.
-  posEnd.init( particleDataPtr, flavSelPtr, pTSelPtr, zSelPtr, *settingsPtr);
-  negEnd.init( particleDataPtr, flavSelPtr, pTSelPtr, zSelPtr, *settingsPtr);
+  posEnd.init( particleDataPtr, rndmPtr, flavSelPtr, pTSelPtr, zSelPtr,
+    *settingsPtr);
+  negEnd.init( particleDataPtr, rndmPtr, flavSelPtr, pTSelPtr, zSelPtr,
+    *settingsPtr);
 
   // Check for number of nearby string pieces (nNSP) or not.
   closePacking    = flag("StringPT:closePacking");
@@ -668,9 +670,6 @@ bool StringFragmentation::fragment( int iSub, ColConfig& colConfig,
   int idNeg          = event[iNeg].id();
   pSum               = colConfig[iSub].pSum;
 
-  // Rapidity pairs [yMin, yMax] of string piece ends.
-  vector< vector< pair<double,double> > > rapPairs = colConfig.rapPairs;
-
   // Reset the local event record and vertex arrays.
   hadrons.clear();
   stringVertices.clear();
@@ -741,7 +740,7 @@ bool StringFragmentation::fragment( int iSub, ColConfig& colConfig,
       StringEnd& nowEnd = (fromPos) ? posEnd : negEnd;
 
       // Check how many nearby string pieces there are for the next hadron.
-      double nNSP = (closePacking) ? nearStringPieces(nowEnd, rapPairs) : 0.;
+      double nNSP = (closePacking) ? nearStringPieces(nowEnd, colConfig) : 0.;
 
       // The FlavourRope treatment changes the fragmentation parameters.
       if (flavRopePtr) {
@@ -817,7 +816,7 @@ bool StringFragmentation::fragment( int iSub, ColConfig& colConfig,
 
     // Check how many nearby string pieces there are for the last hadron.
     double nNSP = (closePacking) ? nearStringPieces(
-      ((rndmPtr->flat() < 0.5) ? posEnd : negEnd), rapPairs) : 0.;
+      ((rndmPtr->flat() < 0.5) ? posEnd : negEnd), colConfig) : 0.;
 
     // When done, join in the middle. If this works, then really done.
     if ( finalTwo(fromPos, event, usedPosJun, usedNegJun, nNSP) )  break;
@@ -891,7 +890,7 @@ vector<int> StringFragmentation::findFirstRegion(int iSub,
 // Set flavours and momentum position for initial string endpoints.
 
 void StringFragmentation::setStartEnds(int idPosIn, int idNegIn,
-StringSystem systemNow, int legNow) {
+  StringSystem& systemNow, int legNow) {
 
   // Variables characterizing string endpoints: defaults for open string.
   int    idPos       = idPosIn;
@@ -1010,7 +1009,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
   vector<Vec4> longitudinal;
   int finalSpacePos  = 0;
   int finalVertexPos = 0;
-  vector<int> iPartonIn = (hasJunction) ? iPartonMax : iParton;
+  vector<int>& iPartonIn = (hasJunction) ? iPartonMax : iParton;
   int id1 = event[ iPartonIn.front() ].idAbs();
   int id2 = (hasJunction) ? idDiquark : event[ iPartonIn.back() ].idAbs();
   int iHadJunc = (hasJunction)
@@ -1031,7 +1030,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
 
     // The normal cases.
     } else {
-      StringRegion currentRegion = system.region( iPosIn, iNegIn);
+      StringRegion& currentRegion = system.region( iPosIn, iNegIn);
       Vec4 gluonOffset = currentRegion.gluonOffset( iPartonIn, event, iPosIn,
         iNegIn) / kappaVtx;
       Vec4 noOffset = (xPosIn * currentRegion.pPos +
@@ -1112,7 +1111,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
               infoPtr->errorMsg("Warning in StringFragmentation::set"
                 "Vertices: negative tau^2 for endpoint massive correction");
           } else {
-            StringRegion region2 = system.region( iPosIn2, iNegIn2);
+            StringRegion& region2 = system.region( iPosIn2, iNegIn2);
             Vec4 gluonOffset = currentRegion.gluonOffset( iPartonIn, event,
               iPosIn, iNegIn);
             v1 = (region2.pPos + gluonOffset) / kappaVtx;
@@ -1142,7 +1141,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
                 "Vertices: negative tau^2 for endpoint massive correction");
 
           } else {
-            StringRegion region2 = system.region( iPosIn2, iNegIn2);
+            StringRegion& region2 = system.region( iPosIn2, iNegIn2);
             Vec4 gluonOffset = currentRegion.gluonOffset( iPartonIn, event,
               iPosIn, iNegIn);
             v1 = (region2.pNeg + gluonOffset) / kappaVtx;
@@ -1194,7 +1193,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
         eX = eXFinalReg;
         eY = eYFinalReg;
       } else{
-        StringRegion currentRegion = system.region(iPosIn, iNegIn);
+        StringRegion& currentRegion = system.region(iPosIn, iNegIn);
         eX = currentRegion.eX;
         eY = currentRegion.eY;
       }
@@ -1231,10 +1230,10 @@ bool StringFragmentation::setHadronVertices( Event& event) {
     int hadSoFar = 0;
     // Loop over the two lowest-energy legs.
     for (int legLoop = 0; legLoop < 2; ++legLoop) {
-      vector<StringVertex> legVertices = (legLoop == 0) ? legMinVertices
+      vector<StringVertex>& legVertices = (legLoop == 0) ? legMinVertices
         : legMidVertices;
       StringSystem& systemNow =  (legLoop == 0) ? systemMin : systemMid;
-      vector<int> iPartonNow = (legLoop == 0) ? iPartonMinLeg : iPartonMidLeg;
+      vector<int>& iPartonNow = (legLoop == 0) ? iPartonMinLeg : iPartonMidLeg;
       vector<Vec4> longitudinalPos;
       if (int(legVertices.size()) < 2) continue;
 
@@ -1246,7 +1245,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
         int iNegIn = legVertices[i].iRegNeg;
         double xPosIn = legVertices[i].xRegPos;
         double xNegIn = legVertices[i].xRegNeg;
-        StringRegion currentRegion = systemNow.region( iPosIn, iNegIn);
+        StringRegion& currentRegion = systemNow.region( iPosIn, iNegIn);
         Vec4 gluonOffset = currentRegion.gluonOffsetJRF( iPartonNow, event,
           iPosIn, iNegIn, MtoJRF) / kappaVtx;
         Vec4 noOffset = (xPosIn * currentRegion.pPos
@@ -1307,7 +1306,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
                 infoPtr->errorMsg("Warning in StringFragmentation::set"
                   "Vertices: negative tau^2 for endpoint massive correction");
             } else {
-              StringRegion region2 = systemNow.region( iPosIn2, iNegIn2);
+              StringRegion& region2 = systemNow.region( iPosIn2, iNegIn2);
               Vec4 gluonOffset =  currentRegion.gluonOffsetJRF( iPartonNow,
               event, iPosIn2, iNegIn2, MtoJRF);
               v1 = (region2.pPos + gluonOffset) / kappaVtx;
@@ -1353,7 +1352,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
         if (smearOn && i > 0) {
           int iPosIn = legVertices[i].iRegPos;
           int iNegIn = legVertices[i].iRegNeg;
-          StringRegion currentRegion = systemNow.region( iPosIn, iNegIn);
+          StringRegion& currentRegion = systemNow.region( iPosIn, iNegIn);
           Vec4 eX = currentRegion.eX;
           Vec4 eY = currentRegion.eY;
 
@@ -1406,7 +1405,7 @@ bool StringFragmentation::setHadronVertices( Event& event) {
     for (int legLoop = 0; legLoop < 2; legLoop++) {
       vector<Vec4>& finalLocation = (legLoop == 0) ? legMinSpaceTime
         : legMidSpaceTime;
-      vector<int> iPartonNow = (legLoop == 0) ? iPartonMinLeg : iPartonMidLeg;
+      vector<int>& iPartonNow = (legLoop == 0) ? iPartonMinLeg : iPartonMidLeg;
       int id =  event[iPartonNow.front()].idAbs();
 
       // Calculate hadron production points from breakup vertices
@@ -2469,8 +2468,8 @@ int StringFragmentation::extraJoin(double facExtra, Event& event) {
 // number of nearby string pieces with respect to the string piece the hadron
 // will be produced on.
 
-double StringFragmentation::nearStringPieces(StringEnd end,
-  vector< vector< pair<double,double> > >& rapPairs) {
+double StringFragmentation::nearStringPieces(const StringEnd& end,
+  const ColConfig& colConfig) {
 
   // No modification for junctions.
   if (hasJunction) return 1;
@@ -2498,20 +2497,12 @@ double StringFragmentation::nearStringPieces(StringEnd end,
   // In case of failure, use remnant momentum.
   if (pHad.e() < 0.0) pHad = pRem;
 
-  // Now loop through the list of rapidity pairs and count strings
-  // sitting at the hadron rapidity.
+  // Now count strings sitting at the hadron rapidity, from the sorted
+  // rapidity pairs of the event, not counting the current one.
   Particle hadron = Particle();
   hadron.p(pHad); hadron.m(pHad.mCalc());
   double yHad = hadron.y();
-  int nString = -1;
-  for (int iSub = 0; iSub < int(rapPairs.size()); iSub++) {
-    vector< pair<double,double> > pairNow = rapPairs[iSub];
-    for (int iPair = 0; iPair < int(pairNow.size()); iPair++) {
-      double y1 = pairNow[iPair].first;
-      double y2 = pairNow[iPair].second;
-      if ( (y1 < yHad) && (yHad < y2) ) nString++;
-    }
-  }
+  int nString = colConfig.nRapPairs(yHad) - 1;
   // Effective number of strings takes pT into account.
   double pT2Had     = pHad.pT2();
   double nStringEff = double(nString) / (1.0 + pT2Had / pT20);
@@ -2521,4 +2512,234 @@ double StringFragmentation::nearStringPieces(StringEnd end,
 
 //==========================================================================
 
+// The ParallelStringFragmentation class.
+
+//--------------------------------------------------------------------------
+
+// Set up the fragmentation objects of each thread, and start the threads.
+// The first set of objects is used by the calling thread itself.
+
+void ParallelStringFragmentation::init(int nThreadsIn) {
+
+  // Stop threads from a previous initialization.
+  stopThreads();
+  int nThreadsNow = (nThreadsIn > 0) ? nThreadsIn
+                  : max( 1, int(thread::hardware_concurrency()));
+
+  // Each worker has its own Info copy, so as to use its own random numbers
+  // and to collect error messages separately.
+  for (int iWorker = 0; iWorker < nThreadsNow; ++iWorker) {
+    workers.push_back( unique_ptr<Worker>( new Worker() ) );
+    Worker& worker = *workers.back();
+    worker.info = *infoPtr;
+    worker.info.hasOwnEventAttributes = false;
+    worker.info.rndmPtr = &worker.rndm;
+    worker.info.errorReset();
+    worker.rndm.init( iWorker + 1, 1);
+
+    // Set up the fragmentation classes as in the HadronLevel.
+    worker.flavSel.initInfoPtr( worker.info);
+    worker.pTSel.initInfoPtr( worker.info);
+    worker.zSel.initInfoPtr( worker.info);
+    worker.stringFrag.initInfoPtr( worker.info);
+    worker.flavSel.init();
+    worker.pTSel.init();
+    worker.zSel.init();
+    worker.stringFrag.init( &worker.flavSel, &worker.pTSel, &worker.zSel);
+  }
+
+  // Start the pool threads, which wait for a new set of systems.
+  int generationNow = generation;
+  for (int iWorker = 1; iWorker < nThreadsNow; ++iWorker)
+    workers[iWorker]->workThread = thread( [this, iWorker, generationNow]() {
+      threadLoop( iWorker, generationNow); });
+
+}
+
+//--------------------------------------------------------------------------
+
+// Fragment the listed systems. Random-number seeds are picked from the
+// main generator in the order of the systems, before any work is done.
+
+void ParallelStringFragmentation::fragment(const vector<int>& iSubIn,
+  ColConfig& colConfig, const Event& event) {
+
+  // Store the systems and the information common to them all.
+  iSubTask     = iSubIn;
+  int nTask    = iSubTask.size();
+  colConfigPtr = &colConfig;
+  eventPtr     = &event;
+  nBase        = event.size();
+  taskOfSub.assign( colConfig.size(), -1);
+  seedTask.resize( nTask);
+  results.resize( nTask);
+  for (int iTask = 0; iTask < nTask; ++iTask) {
+    taskOfSub[iSubTask[iTask]] = iTask;
+    seedTask[iTask] = 1 + int(Rndm::SEEDMAX * rndmPtr->flat());
+  }
+  if (nTask == 0) return;
+
+  // Wake up the pool threads, and take part in the work meanwhile.
+  nClaimed = 0;
+  {
+    lock_guard<mutex> poolLock(poolMutex);
+    ++generation;
+    nBusy = nThreads() - 1;
+  }
+  wakeCond.notify_all();
+  work( *workers[0]);
+
+  // Wait for the pool threads to finish.
+  {
+    unique_lock<mutex> poolLock(poolMutex);
+    doneCond.wait( poolLock, [this]() { return nBusy == 0; });
+  }
+
+  // Add error messages of the workers to the main record.
+  for (unique_ptr<Worker>& workerPtr : workers) {
+    infoPtr->errorCombine( workerPtr->info);
+    workerPtr->info.errorReset();
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Store the hadrons of a system in the event record. Indices of entries
+// created during the fragmentation are shifted to their final position.
+
+bool ParallelStringFragmentation::store(int iSub, Event& event) {
+
+  // Find the outcome. Done if fragmentation failed.
+  int iTask = (iSub < int(taskOfSub.size())) ? taskOfSub[iSub] : -1;
+  if (iTask < 0) return false;
+  Result& result = results[iTask];
+  if (!result.isOK) return false;
+
+  // Append new entries, with shifted mother and daughter indices.
+  int iShift = event.size() - nBase;
+  auto shift = [&](int i) { return (i >= nBase) ? i + iShift : i; };
+  for (Particle& entry : result.entries) {
+    entry.mothers( shift(entry.mother1()), shift(entry.mother2()) );
+    entry.daughters( shift(entry.daughter1()), shift(entry.daughter2()) );
+    event.append( entry);
+  }
+
+  // Mark the original partons as hadronized.
+  for (int i = 0; i < int(result.iMarked.size()); ++i) {
+    Particle& parton = event[result.iMarked[i]];
+    parton.status( result.statusMarked[i]);
+    parton.daughters( shift(result.dau1Marked[i]),
+      shift(result.dau2Marked[i]) );
+  }
+
+  // Done.
+  return true;
+
+}
+
+//--------------------------------------------------------------------------
+
+// Loop run by each pool thread: wait for a new set of systems, then
+// work on them, and report back when there is nothing more to do.
+
+void ParallelStringFragmentation::threadLoop(int iWorker,
+  int generationSeen) {
+
+  while (true) {
+    {
+      unique_lock<mutex> poolLock(poolMutex);
+      wakeCond.wait( poolLock, [this, generationSeen]() {
+        return doStop || generation != generationSeen; });
+      if (doStop) return;
+      generationSeen = generation;
+    }
+    work( *workers[iWorker]);
+    {
+      lock_guard<mutex> poolLock(poolMutex);
+      if (--nBusy == 0) doneCond.notify_all();
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Fragment systems one by one, as long as some are not yet claimed.
+// The local event record is restored after each system, so that all
+// systems start out from the same record.
+
+void ParallelStringFragmentation::work(Worker& worker) {
+
+  bool hasCopy = false;
+  int iTask;
+  while ( (iTask = nClaimed++) < int(iSubTask.size()) ) {
+
+    // Update Info and event record before the first system.
+    if (!hasCopy) {
+      worker.info = *infoPtr;
+      worker.info.hasOwnEventAttributes = false;
+      worker.info.rndmPtr = &worker.rndm;
+      worker.info.errorReset();
+      worker.event = *eventPtr;
+      hasCopy = true;
+    }
+
+    // Fragment the system with its own random numbers.
+    int iSub = iSubTask[iTask];
+    Result& result = results[iTask];
+    worker.rndm.init( seedTask[iTask], 1);
+    worker.stringFrag.resetEnds();
+    result.isOK = worker.stringFrag.fragment( iSub, *colConfigPtr,
+      worker.event);
+
+    // Save new entries and the changes to the original partons.
+    result.entries.clear();
+    for (int i = nBase; i < worker.event.size(); ++i)
+      result.entries.push_back( worker.event[i]);
+    result.iMarked.clear();
+    result.statusMarked.clear();
+    result.dau1Marked.clear();
+    result.dau2Marked.clear();
+    for (int iParton : (*colConfigPtr)[iSub].iParton) {
+      if (iParton < 0) continue;
+      const Particle& parton = worker.event[iParton];
+      result.iMarked.push_back( iParton);
+      result.statusMarked.push_back( parton.status());
+      result.dau1Marked.push_back( parton.daughter1());
+      result.dau2Marked.push_back( parton.daughter2());
+    }
+
+    // Restore the local event record.
+    worker.event.popBack( worker.event.size() - nBase);
+    for (int iParton : result.iMarked) {
+      const Particle& parton = (*eventPtr)[iParton];
+      worker.event[iParton].status( parton.status());
+      worker.event[iParton].daughters( parton.daughter1(),
+        parton.daughter2());
+    }
+  }
+
+}
+
+//--------------------------------------------------------------------------
+
+// Stop and join the pool threads, and remove all workers.
+
+void ParallelStringFragmentation::stopThreads() {
+
+  {
+    lock_guard<mutex> poolLock(poolMutex);
+    doStop = true;
+  }
+  wakeCond.notify_all();
+  for (unique_ptr<Worker>& workerPtr : workers)
+    if (workerPtr->workThread.joinable()) workerPtr->workThread.join();
+  workers.clear();
+  doStop = false;
+
+}
+
+//==========================================================================
+
 } // end namespace Pythia8
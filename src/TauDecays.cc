@@ -97,29 +97,8 @@ bool TauDecays::decay(int idxOut1, Event& event) {
   // Set the outgoing particles of the hard process.
   out1                    = HelicityParticle(event[idxOut1]);
   int         idxOut1Top  = out1.iTopCopyId();
-  vector<int> sistersOut1 = event[idxOut1Top].sisterList();
-  int         idxOut2Top  = idxOut1Top;
-  if (sistersOut1.size() == 1) idxOut2Top = sistersOut1[0];
-  else {
-    // If more then one sister, select by preference tau, nu_tau, lep, nu_lep.
-    int tau(-1), tnu(-1), lep(-1), lnu(-1);
-    for (int i = 0; i < int(sistersOut1.size()); ++i) {
-      int sn = out1.id() == 15 ? -1 : 1;
-      int id = event[sistersOut1[i]].id();
-      if      (id == sn * 15 && tau == -1) tau = sistersOut1[i];
-      else if (id == sn * 16 && tnu == -1) tnu = sistersOut1[i];
-      else if ((id == sn * 11 || (id == sn * 13)) && lep == -1)
-        lep = sistersOut1[i];
-      else if ((id == sn * 12 || (id == sn * 14)) && lnu == -1)
-        lnu = sistersOut1[i];
-    }
-    if      (tau > 0) idxOut2Top = tau;
-    else if (tnu > 0) idxOut2Top = tnu;
-    else if (lep > 0) idxOut2Top = lep;
-    else if (lnu > 0) idxOut2Top = lnu;
-  }
-  int idxOut2 = event[idxOut2Top].iBotCopyId();
-  out2        = HelicityParticle(event[idxOut2]);
+  int         idxOut2     = partner(idxOut1, event);
+  out2                    = HelicityParticle(event[idxOut2]);
 
   // Set the mediator of the hard process.
   int idxMediator    = event[idxOut1Top].mother1();
@@ -282,6 +261,39 @@ bool TauDecays::decay(int idxOut1, Event& event) {
 
 //--------------------------------------------------------------------------
 
+// Find the partner of a tau, i.e. the bottom copy of the sister that it
+// is decayed together with if correlated. The tau itself if there is none.
+
+int TauDecays::partner(int idxOut1, const Event& event) const {
+
+  // If more then one sister, select by preference tau, nu_tau, lep, nu_lep.
+  int         idxOut1Top  = event[idxOut1].iTopCopyId();
+  vector<int> sistersOut1 = event[idxOut1Top].sisterList();
+  int         idxOut2Top  = idxOut1Top;
+  if (sistersOut1.size() == 1) idxOut2Top = sistersOut1[0];
+  else {
+    int tau(-1), tnu(-1), lep(-1), lnu(-1);
+    for (int i = 0; i < int(sistersOut1.size()); ++i) {
+      int sn = event[idxOut1].id() == 15 ? -1 : 1;
+      int id = event[sistersOut1[i]].id();
+      if      (id == sn * 15 && tau == -1) tau = sistersOut1[i];
+      else if (id == sn * 16 && tnu == -1) tnu = sistersOut1[i];
+      else if ((id == sn * 11 || (id == sn * 13)) && lep == -1)
+        lep = sistersOut1[i];
+      else if ((id == sn * 12 || (id == sn * 14)) && lnu == -1)
+        lnu = sistersOut1[i];
+    }
+    if      (tau > 0) idxOut2Top = tau;
+    else if (tnu > 0) idxOut2Top = tnu;
+    else if (lep > 0) idxOut2Top = lep;
+    else if (lnu > 0) idxOut2Top = lnu;
+  }
+  return event[idxOut2Top].iBotCopyId();
+
+}
+
+//--------------------------------------------------------------------------
+
 // Determine the tau polarization and tau decay correlation using the internal
 // helicity matrix elements.
 